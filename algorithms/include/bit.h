@@ -44,7 +44,39 @@ int bit_get(const unsigned char *buf, int pos);
 void bit_set(unsigned char *buf, int pos, int val);
 
 
-/* Perform bitwise AND, OR, and XOR of two buffers
+/* Obtain a field of bits at a certain position
+    @param buf    Buffer of bits
+    @param pos    Position of the field's left-most bit
+    @param width  Number of bits in the field
+
+    @return Value of the field, read with its left-most bit as the most significant
+
+    Notes:
+      - width must be between 1 and 32
+      - Only the bytes the field touches are read, so a field may end at the last bit of the buffer
+      - Ex: The 6-bit field at pos 5 of 11111000 00111110 is 000001 = 1
+      - Complexity: O(1)
+*/
+unsigned int bit_get_field(const unsigned char *buf, int pos, int width);
+
+
+/* Set a field of bits at a certain position
+    @param buf    Buffer of bits
+    @param pos    Position of the field's left-most bit
+    @param width  Number of bits in the field
+    @param val    Desired value of the field
+
+    @return None
+
+    Notes:
+      - width must be between 1 and 32, and only the low width bits of val are used
+      - Bits outside the field are left unchanged
+      - Complexity: O(1)
+*/
+void bit_set_field(unsigned char *buf, int pos, int width, unsigned int val);
+
+
+/* Perform bitwise AND, OR, XOR, and AND NOT of two buffers
     @param buf1      First buffer of bits
     @param buf2      Second buffer of bits
     @param bufo      Buffer to hold result 
@@ -54,11 +86,32 @@ void bit_set(unsigned char *buf, int pos, int val);
 
     Notes:
       - It is the responsibility of the caller to manage the storage required by bufo
+      - bit_andnot() computes buf1 AND (NOT buf2), i.e., the bits of buf1 that are not in buf2
+      - bufo may be the same buffer as buf1 or buf2 (but must not partially overlap either)
+      - Bits of bufo past num_bits (in its last byte) are left unchanged
+      - Works on whole 64-bit words, or 128/256-bit vectors when built with SSE2/AVX2
       - Complexity: O(b), where b is the number of bits in each buffer
 */
 void bit_and(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits);
 void bit_or(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits);
 void bit_xor(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits);
+void bit_andnot(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits);
+
+
+/* Perform bitwise NOT of a buffer
+    @param buf       Buffer of bits
+    @param bufo      Buffer to hold result
+    @param num_bits  Number of bits in the buffer
+
+    @return None
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage required by bufo
+      - bufo may be the same buffer as buf
+      - Bits of bufo past num_bits (in its last byte) are left unchanged
+      - Complexity: O(b), where b is the number of bits in the buffer
+*/
+void bit_not(const unsigned char *buf, unsigned char *bufo, int num_bits);
 
 
 /* Rotate bits leftward (with wrap-around)
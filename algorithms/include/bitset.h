@@ -0,0 +1,194 @@
+/* Header for Bitset-Backed Sets */
+#ifndef _BITSET_H
+#define _BITSET_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bit.h"
+
+/* Purpose:
+     - Set (see set.h) spends a whole linked-list element on every member
+     - When members are integers from a known range [0, universe), one bit per possible member is enough
+     - The bits are kept in a bit.h buffer (position 0 is the left-most bit), so bit_get() and friends work on it directly
+     - Set algebra and cardinality process 64 bits at a time
+*/
+
+/* Structure definition for bitset-backed sets */
+typedef struct BitSet_ {
+    int universe;           /* Number of possible members (i.e., members lie in [0, universe)) */
+    int size;               /* Number of members */
+    int words;              /* Number of 64-bit words in the buffer */
+
+    unsigned char *bits;    /* bit.h buffer with one bit per possible member, padded with zeros to a whole number of words */
+} BitSet;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a bitset
+    @param set       The allocated BitSet structure
+    @param universe  Number of possible members
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must be called before other bitset operations can be used
+      - The set starts out empty
+      - Complexity: O(u), where u is the size of the universe
+*/
+int bitset_init(BitSet *set, int universe);
+
+
+/* Destroy a bitset
+    @param set  The bitset to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void bitset_destroy(BitSet *set);
+
+
+/* Insert a member into the set
+    @param set   The BitSet structure
+    @param data  The member to be inserted
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Returns -1 if data is outside the universe or is already a member
+      - Complexity: O(1)
+*/
+int bitset_insert(BitSet *set, int data);
+
+
+/* Remove a member from the set
+    @param set   The BitSet structure
+    @param data  The member to be removed
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Returns -1 if data is not a member
+      - Complexity: O(1)
+*/
+int bitset_remove(BitSet *set, int data);
+
+
+/* Compute the union, intersection, or difference of two sets
+    @param setr  The set containing the result
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - These functions call bitset_init() for setr
+      - set1 and set2 must have the same universe
+      - bitset_difference() computes set1 - set2
+      - Complexity: O(u/64), where u is the size of the universe
+*/
+int bitset_union(BitSet *setr, const BitSet *set1, const BitSet *set2);
+int bitset_intersection(BitSet *setr, const BitSet *set1, const BitSet *set2);
+int bitset_difference(BitSet *setr, const BitSet *set1, const BitSet *set2);
+
+
+/* Determine whether a value is a member of the set
+    @param set   The BitSet structure
+    @param data  The value to look for
+
+    @return 1 if data is a member of the set, 0 otherwise
+
+    Notes:
+      - Complexity: O(1)
+*/
+int bitset_is_element(const BitSet *set, int data);
+
+
+/* Determine whether a set is a subset of another
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 1 if set1 is a subset of set2, 0 otherwise
+
+    Notes:
+      - Complexity: O(u/64), where u is the size of the universe
+*/
+int bitset_is_subset(const BitSet *set1, const BitSet *set2);
+
+
+/* Determine whether two sets are equal
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 1 if the two sets are equal, 0 otherwise
+
+    Notes:
+      - Complexity: O(u/64), where u is the size of the universe
+*/
+int bitset_is_equal(const BitSet *set1, const BitSet *set2);
+
+
+/* Count the members two sets have in common without building their intersection
+    @param set1  The first set
+    @param set2  The second set
+
+    @return Number of members in both sets, or -1 if the universes differ
+
+    Notes:
+      - Complexity: O(u/64), where u is the size of the universe
+*/
+int bitset_intersection_count(const BitSet *set1, const BitSet *set2);
+
+
+/* Count the members of the set by counting set bits
+    @param set  The BitSet structure
+
+    @return Number of members in the set
+
+    Notes:
+      - Recounts from the buffer (bitset_size() returns the cached count)
+      - Useful after modifying the buffer directly with bit_set()
+      - Complexity: O(u/64), where u is the size of the universe
+*/
+int bitset_count(BitSet *set);
+
+
+/* Find the next member of the set
+    @param set  The BitSet structure
+    @param pos  Position to start searching from
+
+    @return The smallest member >= pos, or -1 if there is none
+
+    Notes:
+      - To visit every member: for(int m = bitset_next(set, 0); m != -1; m = bitset_next(set, m + 1))
+      - Skips 64 absent members at a time
+      - Complexity: O(1) per member visited plus O(g/64) for a gap of g absent members
+*/
+int bitset_next(const BitSet *set, int pos);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get number of members in set */
+#define bitset_size(set) ((set)->size)
+
+/* Get number of possible members */
+#define bitset_universe(set) ((set)->universe)
+
+/* Get the underlying bit.h buffer */
+#define bitset_bits(set) ((set)->bits)
+
+#endif
@@ -0,0 +1,235 @@
+/* Header for Bloom Filters */
+#ifndef _BLOOM_H
+#define _BLOOM_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "bit.h"
+#include "chtbl.h"
+#include "ohtbl.h"
+
+/* Purpose:
+     - Answer "definitely not present" or "maybe present" for a key in a few bits per key, so lookups that would miss can
+       skip the structure that holds the keys
+     - Standard: k bits anywhere in a bit.h buffer of m bits (Bloom, 1970)
+     - Blocked: all k bits of a key fall in one 512-bit block, so a query touches a single cache line (Putze, Sanders and
+       Singler, "Cache-, Hash- and Space-Efficient Bloom Filters", 2007) -- Uneven block loads cost some accuracy, which
+       sizing makes up for with extra bits
+     - Sized from the number of keys expected and the false positive rate wanted
+     - A BloomGuard puts a filter in front of a CHTbl or OHTbl, so a lookup the filter rules out never walks a bucket
+       chain or probe sequence
+*/
+
+
+/*
+*****************************************************
+        Definitions for Bloom Filters
+*****************************************************
+*/
+
+#define BLOOM_STANDARD 0
+#define BLOOM_BLOCKED 1
+
+/* Bits in a block of a blocked filter -- One 64-byte cache line */
+#define BLOOM_BLOCK_BITS 512
+
+/* Structure definition for Bloom filters */
+typedef struct Bloom_ {
+    int kind;               /* BLOOM_STANDARD or BLOOM_BLOCKED */
+    int num_bits;           /* m -- Number of bits (a whole number of blocks when blocked) */
+    int hashes;             /* k -- Bits set per key */
+    int size;               /* Number of keys added */
+
+    unsigned char *bits;    /* bit.h buffer of m bits (cache-line aligned) */
+} Bloom;
+
+
+/* Structure definition for a filter guarding a hash table */
+typedef struct BloomGuard_ {
+    Bloom filter;
+    uint64_t (*hash)(const void *data);     /* 64-bit hash of an element's key, used only by the filter */
+
+    CHTbl *chtbl;           /* The guarded table -- Exactly one of the two is set */
+    OHTbl *ohtbl;
+} BloomGuard;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a Bloom filter
+    @param bloom     The allocated Bloom structure
+    @param kind      BLOOM_STANDARD or BLOOM_BLOCKED
+    @param expected  Number of keys the filter is sized for
+    @param fp_rate   False positive rate wanted once that many keys are in (e.g., 0.01)
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - A standard filter gets m = -n ln(p) / ln(2)^2 bits and k = ln(2) m / n hashes, about 9.6 bits per key at 1%
+      - A blocked filter gets as many more bits as its predicted rate needs to come down to fp_rate
+      - Adding more keys than expected works, but the false positive rate climbs
+      - Complexity: O(m)
+*/
+int bloom_init(Bloom *bloom, int kind, int expected, double fp_rate);
+
+
+/* Destroy a Bloom filter
+    @param bloom  The filter to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void bloom_destroy(Bloom *bloom);
+
+
+/* Add a key to the filter
+    @param bloom  The Bloom structure
+    @param hash   A 64-bit hash of the key
+
+    @return None
+
+    Notes:
+      - The hash is remixed, so any reasonable 64-bit hash works (but equal keys must hash equally)
+      - Complexity: O(k)
+*/
+void bloom_add(Bloom *bloom, uint64_t hash);
+
+
+/* Determine whether a key may have been added
+    @param bloom  The Bloom structure
+    @param hash   A 64-bit hash of the key
+
+    @return 1 if the key may have been added, 0 if it definitely was not
+
+    Notes:
+      - Complexity: O(k)
+*/
+int bloom_contains(const Bloom *bloom, uint64_t hash);
+
+
+/* Add or query an array of keys
+    @param bloom   The Bloom structure
+    @param hashes  64-bit hashes of the keys
+    @param n       Number of keys
+    @param found   For bloom_contains_n(), set to 1 for each key that may have been added and 0 otherwise (may be NULL)
+
+    @return bloom_contains_n() returns the number of keys that may have been added
+
+    Notes:
+      - Locates the bits of a batch of keys before touching any of them, so the cache misses of a large filter overlap
+      - Complexity: O(nk)
+*/
+void bloom_add_n(Bloom *bloom, const uint64_t *hashes, int n);
+int bloom_contains_n(const Bloom *bloom, const uint64_t *hashes, int n, unsigned char *found);
+
+
+/* Merge another filter into this one
+    @param bloom  The Bloom structure receiving the union
+    @param other  The filter to merge
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Both filters must have the same kind, size, and number of hashes (e.g., built with the same bloom_init() arguments)
+      - The result is the filter of every key added to either one
+      - Complexity: O(m)
+*/
+int bloom_union(Bloom *bloom, const Bloom *other);
+
+
+/* Put a filter in front of a chained or open-addressed hash table
+    @param guard     The allocated BloomGuard structure
+    @param htbl      The table to guard
+    @param hash      64-bit hash of an element's key (elements that match must hash equally)
+    @param kind      BLOOM_STANDARD or BLOOM_BLOCKED
+    @param expected  Number of elements the filter is sized for
+    @param fp_rate   False positive rate wanted
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Elements already in the table are added to the filter
+      - From then on the table must only be changed through the guard
+      - Complexity: O(m + positions) (the table's buckets or positions are scanned once)
+*/
+int bloom_guard_chtbl(BloomGuard *guard, CHTbl *htbl, uint64_t (*hash)(const void *data), int kind, int expected, double fp_rate);
+int bloom_guard_ohtbl(BloomGuard *guard, OHTbl *htbl, uint64_t (*hash)(const void *data), int kind, int expected, double fp_rate);
+
+
+/* Stop guarding a table
+    @param guard  The guard to be destroyed
+
+    Notes:
+      - The table itself is left as it is
+      - Complexity: O(1)
+*/
+void bloom_guard_destroy(BloomGuard *guard);
+
+
+/* Insert an element into a guarded table
+    @param guard  The BloomGuard structure
+    @param data   The element
+
+    @return As the table's insert: 0 if successful, 1 if the element already exists, -1 otherwise
+
+    Notes:
+      - Complexity: O(k) plus the table's insert
+*/
+int bloom_guard_insert(BloomGuard *guard, const void *data);
+
+
+/* Remove an element from a guarded table
+    @param guard  The BloomGuard structure
+    @param data   The element to remove; set to the removed element's data upon return
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - A Bloom filter cannot forget a key, so its bits stay set: removed keys become false positives, and the rate climbs
+        with churn until the guard is rebuilt
+      - Complexity: O(k) plus the table's remove
+*/
+int bloom_guard_remove(BloomGuard *guard, void **data);
+
+
+/* Look up an element in a guarded table
+    @param guard  The BloomGuard structure
+    @param data   The element to look for; set to the matching element's data upon return
+
+    @return 0 if the element is found, -1 otherwise
+
+    Notes:
+      - Returns -1 without touching the table when the filter rules the element out
+      - Complexity: O(k) plus, for elements that pass the filter, the table's lookup
+*/
+int bloom_guard_lookup(const BloomGuard *guard, void **data);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get number of keys added */
+#define bloom_size(bloom) ((bloom)->size)
+
+/* Get number of bits */
+#define bloom_num_bits(bloom) ((bloom)->num_bits)
+
+/* Get number of hashes per key */
+#define bloom_hashes(bloom) ((bloom)->hashes)
+
+/* Get the filter of a guard */
+#define bloom_guard_filter(guard) (&(guard)->filter)
+
+#endif
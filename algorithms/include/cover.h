@@ -0,0 +1,48 @@
+/* Header for Set Covering */
+#ifndef _COVER_H
+#define _COVER_H
+
+#include <stdlib.h>
+
+#include "bitset.h"
+#include "pqueue.h"
+
+/* Idea:
+     - Given the members to cover and a collection of subsets, pick subsets until every member is covered
+     - The greedy heuristic repeatedly picks the subset covering the most uncovered members (see data_structures/examples/cover.c)
+     - A subset can only cover fewer members as the rounds go on, so its last computed gain is an upper bound on its current gain
+     - Lazy greedy keeps the subsets in a priority queue by their last gain and only recomputes the gain of the subset at the top:
+         - If its gain is up to date, no other subset can beat it, so it is picked
+         - Otherwise, its gain is recomputed and it goes back into the queue
+*/
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Find a covering of a set of members with the greedy heuristic
+    @param members   The members to be covered
+    @param subsets   Array of candidate subsets
+    @param count     Number of subsets
+    @param covering  Array to hold the indices of the picked subsets (in the order they are picked)
+    @param size      Number of subsets in the covering
+
+    @return 0 if a covering was found, 1 if no covering is possible, -1 otherwise
+
+    Notes:
+      - members and every subset must have the same universe
+      - covering must have room for count indices
+      - Each round picks the subset covering the most uncovered members, with ties going to the subset with the smallest index
+        (i.e., the same covering the eager greedy algorithm finds)
+      - If no covering is possible, covering holds the subsets picked before the remaining members turned out to be uncoverable
+      - Complexity: O(r u/64 + s log s), where r is the number of gain computations (at most count per round, usually far fewer),
+        u is the size of the universe, and s is the number of queue operations
+*/
+int set_cover(const BitSet *members, const BitSet *subsets, int count, int *covering, int *size);
+
+#endif
@@ -0,0 +1,162 @@
+/* Header for HyperLogLog Cardinality Estimation */
+#ifndef _HLL_H
+#define _HLL_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "bit.h"
+
+/* Purpose:
+     - Counting distinct keys exactly (CHTbl, Set) costs memory in proportion to the keys; HyperLogLog costs
+       0.75 * 2^p bytes for any number of them, with a relative standard error of about 1.04 / sqrt(2^p)
+     - Follows HyperLogLog++ (Heule, Nunkesser and Hall, EDBT 2013): 64-bit hashes, so no large-range correction,
+       and a sparse representation while few keys have been seen
+     - Dense: 2^p registers of 6 bits packed into a bit.h buffer (register j is the field at pos 6j), each holding
+       the longest run of leading zeros (plus one) among the hashes that selected it
+     - Sparse: a sorted list of (25-bit index, rank) pairs, estimated by linear counting at precision 25, which is
+       nearly exact for small cardinalities -- Converted to dense once it would outgrow the dense registers
+     - Estimates with Ertl's improved estimator ("New cardinality estimation algorithms for HyperLogLog sketches",
+       2017), which is unbiased over the whole range without HyperLogLog++'s empirical bias tables
+*/
+
+
+/*
+*****************************************************
+        Definitions for HyperLogLog
+*****************************************************
+*/
+
+#define HLL_MIN_PRECISION 4
+#define HLL_MAX_PRECISION 18
+#define HLL_SPARSE_PRECISION 25
+
+/* Structure definition for HyperLogLog sketches */
+typedef struct Hll_ {
+    int precision;          /* p -- The sketch has 2^p registers */
+    int registers;          /* Number of registers (i.e., 2^p) */
+
+    unsigned char *dense;   /* bit.h buffer of 6-bit registers, NULL while the sketch is sparse */
+
+    uint32_t *sparse;       /* Sparse entries (25-bit index << 6 | rank), a sorted prefix then unsorted additions */
+    int sparse_sorted;      /* Number of entries in the sorted prefix */
+    int sparse_size;        /* Number of entries */
+    int sparse_capacity;    /* Most entries held before the sketch converts to dense */
+} Hll;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a HyperLogLog sketch
+    @param hll        The allocated Hll structure
+    @param precision  p, between HLL_MIN_PRECISION and HLL_MAX_PRECISION (14 gives 12 KB and about 0.8% error)
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - The sketch starts sparse
+      - Complexity: O(2^p)
+*/
+int hll_init(Hll *hll, int precision);
+
+
+/* Destroy a HyperLogLog sketch
+    @param hll  The sketch to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void hll_destroy(Hll *hll);
+
+
+/* Hash a key for the sketch
+    @param data  The key
+    @param size  Number of bytes in the key
+
+    @return A 64-bit hash of the key
+
+    Notes:
+      - The sketch relies on every bit of the hash being uniform, so keys must go through a good 64-bit hash first
+        (this one, or any other of similar quality)
+      - Complexity: O(size)
+*/
+uint64_t hll_hash(const void *data, int size);
+
+
+/* Add a hashed key to the sketch
+    @param hll   The Hll structure
+    @param hash  The key's 64-bit hash
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Fails only if converting to dense cannot allocate the registers
+      - Complexity: O(1) amortized
+*/
+int hll_add(Hll *hll, uint64_t hash);
+
+
+/* Add an array of hashed keys to the sketch
+    @param hll     The Hll structure
+    @param hashes  The keys' 64-bit hashes
+    @param n       Number of hashes
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Complexity: O(n) amortized
+*/
+int hll_add_n(Hll *hll, const uint64_t *hashes, int n);
+
+
+/* Estimate the number of distinct keys added
+    @param hll  The Hll structure
+
+    @return The estimated cardinality
+
+    Notes:
+      - Sorts any pending sparse entries first, hence not const
+      - Complexity: O(2^p) when dense, O(s log s) for s sparse entries
+*/
+double hll_count(Hll *hll);
+
+
+/* Merge another sketch into this one
+    @param hll    The Hll structure receiving the union
+    @param other  The sketch to merge (its pending sparse entries are sorted, otherwise unchanged)
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Both sketches must have the same precision
+      - Dense registers are merged eight at a time (the maximum of 6-bit fields packed in a word), and four such
+        groups per instruction with AVX2
+      - Complexity: O(2^p)
+*/
+int hll_merge(Hll *hll, Hll *other);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get the precision */
+#define hll_precision(hll) ((hll)->precision)
+
+/* Determine whether the sketch is still sparse */
+#define hll_is_sparse(hll) ((hll)->dense == NULL)
+
+/* Get a register of a dense sketch */
+#define hll_register(hll, j) (bit_get_field((hll)->dense, 6 * (j), 6))
+
+#endif
@@ -1,6 +1,23 @@
 /* Implementation of Bit Operations */
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "bit.h"
 
+/* Operators for bit_combine() */
+#define BIT_AND 0
+#define BIT_OR 1
+#define BIT_XOR 2
+#define BIT_ANDNOT 3
+#define BIT_NOT 4
+
+
 /* Get a bit at a certain position */
 int bit_get(const unsigned char *buf, int pos)
 {
@@ -73,42 +90,167 @@ void bit_set(unsigned char *buf, int pos, int state)
 }
 
 
-/* Perform bitwise AND */
-void bit_and(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits)
+/* Get a field of bits at a certain position */
+unsigned int bit_get_field(const unsigned char *buf, int pos, int width)
 {
-    for(int i = 0; i < num_bits; i++)
+    /* Gather the bytes the field touches (at most 5 for a 32-bit field) into one word, left-most byte highest
+         - Ex: The 6-bit field at pos 5 of   11111000 00111110
+             first byte = 0, last byte = 1 (pos 10 is in the 2nd byte)
+             word = 11111000 00111110
+             The field ends 5 bits from the right of the word, so shift right by 5 and keep 6 bits
+               ==> 000001
+    */
+    int first = pos / 8, last = (pos + width - 1) / 8;
+    uint64_t word = 0;
+    for(int i = first; i <= last; i++)
+        word = (word << 8) | buf[i];
+
+    int shift = (last + 1) * 8 - (pos + width);
+    return (unsigned int)((word >> shift) & ((1ULL << width) - 1));
+}
+
+
+/* Set a field of bits at a certain position */
+void bit_set_field(unsigned char *buf, int pos, int width, unsigned int val)
+{
+    /* Same word as bit_get_field(), with the field cleared and the new value put in its place */
+    int first = pos / 8, last = (pos + width - 1) / 8;
+    uint64_t word = 0;
+    for(int i = first; i <= last; i++)
+        word = (word << 8) | buf[i];
+
+    int shift = (last + 1) * 8 - (pos + width);
+    uint64_t mask = ((1ULL << width) - 1) << shift;
+    word = (word & ~mask) | (((uint64_t)val << shift) & mask);
+
+    /* Write the bytes back, right-most first */
+    for(int i = last; i >= first; i--)
     {
-        int bit1 = bit_get(buf1, i);
-        int bit2 = bit_get(buf2, i);
-        int bito = bit1 ? bit2 : 0;
-        bit_set(bufo, i, bito);
+        buf[i] = (unsigned char)word;
+        word >>= 8;
     }
 }
 
 
-/* Perform bitwise OR */
-void bit_or(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits)
+/* Combine two buffers with one of the bitwise operators, a word or vector at a time
+     - Bitwise operators do not care how bits are ordered within a byte or bytes within a word, so whole bytes of the
+       bit.h buffers can be loaded as 64-bit words (or 128/256-bit vectors) and combined directly
+     - Only the last, partial byte needs care: bits past num_bits in bufo must keep their old values, as they did when
+       the operators went one bit at a time
+*/
+static void bit_combine(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits, int op)
 {
-    for(int i = 0; i < num_bits; i++)
+    if(num_bits <= 0)
+        return;
+
+    size_t bytes = (size_t)num_bits / 8, i = 0;
+
+#if defined(__AVX2__)
+    const __m256i ones256 = _mm256_set1_epi8(-1);
+    for(; i + 32 <= bytes; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(buf1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(buf2 + i)), r;
+        switch(op)
+        {
+            case BIT_AND:    r = _mm256_and_si256(a, b); break;
+            case BIT_OR:     r = _mm256_or_si256(a, b); break;
+            case BIT_XOR:    r = _mm256_xor_si256(a, b); break;
+            case BIT_ANDNOT: r = _mm256_andnot_si256(b, a); break;
+            default:         r = _mm256_xor_si256(a, ones256); break;
+        }
+        _mm256_storeu_si256((__m256i *)(bufo + i), r);
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i ones128 = _mm_set1_epi8(-1);
+    for(; i + 16 <= bytes; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(buf1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(buf2 + i)), r;
+        switch(op)
+        {
+            case BIT_AND:    r = _mm_and_si128(a, b); break;
+            case BIT_OR:     r = _mm_or_si128(a, b); break;
+            case BIT_XOR:    r = _mm_xor_si128(a, b); break;
+            case BIT_ANDNOT: r = _mm_andnot_si128(b, a); break;
+            default:         r = _mm_xor_si128(a, ones128); break;
+        }
+        _mm_storeu_si128((__m128i *)(bufo + i), r);
+    }
+#endif
+
+    /* Whole 64-bit words (everything, without SIMD), then single bytes */
+    for(; i + 8 <= bytes; i += 8)
+    {
+        uint64_t a, b, r;
+        memcpy(&a, buf1 + i, 8);
+        memcpy(&b, buf2 + i, 8);
+        switch(op)
+        {
+            case BIT_AND:    r = a & b; break;
+            case BIT_OR:     r = a | b; break;
+            case BIT_XOR:    r = a ^ b; break;
+            case BIT_ANDNOT: r = a & ~b; break;
+            default:         r = ~a; break;
+        }
+        memcpy(bufo + i, &r, 8);
+    }
+
+    for(size_t last = bytes + (num_bits % 8 != 0); i < last; i++)
     {
-        int bit1 = bit_get(buf1, i);
-        int bit2 = bit_get(buf2, i);
-        int bito = bit1 ? 1 : bit2;
-        bit_set(bufo, i, bito);
+        unsigned char a = buf1[i], b = buf2[i], r;
+
+        /* The partial last byte, if any: only its first num_bits % 8 bits (the left-most ones) are combined
+             - Ex: num_bits = 20 leaves 4 bits in the 3rd byte ==> mask = 11110000
+        */
+        unsigned char mask = (i == bytes) ? (unsigned char)(0xFF << (8 - num_bits % 8)) : 0xFF;
+
+        switch(op)
+        {
+            case BIT_AND:    r = a & b; break;
+            case BIT_OR:     r = a | b; break;
+            case BIT_XOR:    r = a ^ b; break;
+            case BIT_ANDNOT: r = a & ~b; break;
+            default:         r = ~a; break;
+        }
+        bufo[i] = (unsigned char)((bufo[i] & ~mask) | (r & mask));
     }
 }
 
 
+/* Perform bitwise AND */
+void bit_and(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits)
+{
+    bit_combine(buf1, buf2, bufo, num_bits, BIT_AND);
+}
+
+
+/* Perform bitwise OR */
+void bit_or(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits)
+{
+    bit_combine(buf1, buf2, bufo, num_bits, BIT_OR);
+}
+
+
 /* Perform bitwise XOR */
 void bit_xor(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits)
 {
-    for(int i = 0; i < num_bits; i++)
-    {
-        int bit1 = bit_get(buf1, i);
-        int bit2 = bit_get(buf2, i);
-        int bito = (bit1==bit2) ? 0 : 1;
-        bit_set(bufo, i, bito);
-    }
+    bit_combine(buf1, buf2, bufo, num_bits, BIT_XOR);
+}
+
+
+/* Perform bitwise AND NOT */
+void bit_andnot(const unsigned char *buf1, const unsigned char *buf2, unsigned char *bufo, int num_bits)
+{
+    bit_combine(buf1, buf2, bufo, num_bits, BIT_ANDNOT);
+}
+
+
+/* Perform bitwise NOT */
+void bit_not(const unsigned char *buf, unsigned char *bufo, int num_bits)
+{
+    bit_combine(buf, buf, bufo, num_bits, BIT_NOT);
 }
 
 
@@ -0,0 +1,257 @@
+/* Implementation of Bitset-Backed Sets */
+#include <stdint.h>
+
+#include "bit.h"
+#include "bitset.h"
+
+/*
+*************************************
+        Private Helper Functions
+*************************************
+*/
+
+/* Load the 64-bit word at index i of a buffer */
+static inline uint64_t bitset_load(const unsigned char *bits, int i)
+{
+    uint64_t word;
+    memcpy(&word, bits + (size_t)i * sizeof(word), sizeof(word));
+    return word;
+}
+
+
+/* Store a 64-bit word at index i of a buffer */
+static inline void bitset_store(unsigned char *bits, int i, uint64_t word)
+{
+    memcpy(bits + (size_t)i * sizeof(word), &word, sizeof(word));
+}
+
+
+/* Load the word at index i so that bit.h position 0 of the word is the most significant bit
+     - bit.h numbers bits from the left-most bit of the first byte, which is the big-endian reading of the word
+*/
+static inline uint64_t bitset_load_ordered(const unsigned char *bits, int i)
+{
+    uint64_t word = bitset_load(bits, i);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+
+/* Check that two sets can be combined and initialize the result set */
+static int bitset_prepare(BitSet *setr, const BitSet *set1, const BitSet *set2)
+{
+    if(set1->universe != set2->universe)
+        return -1;
+
+    return bitset_init(setr, set1->universe);
+}
+
+
+
+
+/*
+************************************************
+        Interface Method Implementations
+************************************************
+*/
+
+/* Initialize a bitset */
+int bitset_init(BitSet *set, int universe)
+{
+    if(universe < 0)
+        return -1;
+
+    /* Allocate whole 64-bit words so the set algebra never has to handle a partial word */
+    set->words = (universe + 63) / 64;
+    set->bits = calloc(set->words > 0 ? set->words : 1, sizeof(uint64_t));
+    if(set->bits == NULL)
+        return -1;
+
+    set->universe = universe;
+    set->size = 0;
+
+    return 0;
+}
+
+
+/* Destroy a bitset */
+void bitset_destroy(BitSet *set)
+{
+    /* Free the buffer and clear the structure to be safe */
+    free(set->bits);
+    memset(set, 0, sizeof(BitSet));
+}
+
+
+/* Insert a member into the set */
+int bitset_insert(BitSet *set, int data)
+{
+    /* Only allow members of the universe, and only once */
+    if(data < 0 || data >= set->universe || bit_get(set->bits, data))
+        return -1;
+
+    bit_set(set->bits, data, 1);
+    set->size += 1;
+
+    return 0;
+}
+
+
+/* Remove a member from the set */
+int bitset_remove(BitSet *set, int data)
+{
+    /* Cannot remove something that is not there */
+    if(!bitset_is_element(set, data))
+        return -1;
+
+    bit_set(set->bits, data, 0);
+    set->size -= 1;
+
+    return 0;
+}
+
+
+/* Compute the union of two sets */
+int bitset_union(BitSet *setr, const BitSet *set1, const BitSet *set2)
+{
+    if(bitset_prepare(setr, set1, set2) != 0)
+        return -1;
+
+    /* OR the sets a word at a time, counting the members of the result as we go */
+    for(int i = 0; i < setr->words; i++)
+    {
+        uint64_t word = bitset_load(set1->bits, i) | bitset_load(set2->bits, i);
+        bitset_store(setr->bits, i, word);
+        setr->size += __builtin_popcountll(word);
+    }
+
+    return 0;
+}
+
+
+/* Compute the intersection of two sets */
+int bitset_intersection(BitSet *setr, const BitSet *set1, const BitSet *set2)
+{
+    if(bitset_prepare(setr, set1, set2) != 0)
+        return -1;
+
+    /* AND the sets a word at a time, counting the members of the result as we go */
+    for(int i = 0; i < setr->words; i++)
+    {
+        uint64_t word = bitset_load(set1->bits, i) & bitset_load(set2->bits, i);
+        bitset_store(setr->bits, i, word);
+        setr->size += __builtin_popcountll(word);
+    }
+
+    return 0;
+}
+
+
+/* Compute the difference of two sets (set1 - set2) */
+int bitset_difference(BitSet *setr, const BitSet *set1, const BitSet *set2)
+{
+    if(bitset_prepare(setr, set1, set2) != 0)
+        return -1;
+
+    /* Keep the bits of set1 that are clear in set2, counting the members of the result as we go */
+    for(int i = 0; i < setr->words; i++)
+    {
+        uint64_t word = bitset_load(set1->bits, i) & ~bitset_load(set2->bits, i);
+        bitset_store(setr->bits, i, word);
+        setr->size += __builtin_popcountll(word);
+    }
+
+    return 0;
+}
+
+
+/* Determine whether a value is a member of the set */
+int bitset_is_element(const BitSet *set, int data)
+{
+    if(data < 0 || data >= set->universe)
+        return 0;
+
+    return bit_get(set->bits, data);
+}
+
+
+/* Determine whether set1 is a subset of set2 */
+int bitset_is_subset(const BitSet *set1, const BitSet *set2)
+{
+    /* Quick test -- Different universes or more members means it cannot be a subset */
+    if(set1->universe != set2->universe || bitset_size(set1) > bitset_size(set2))
+        return 0;
+
+    /* Every bit set in set1 must also be set in set2 */
+    for(int i = 0; i < set1->words; i++)
+        if(bitset_load(set1->bits, i) & ~bitset_load(set2->bits, i))
+            return 0;
+
+    return 1;
+}
+
+
+/* Determine whether two sets are equal */
+int bitset_is_equal(const BitSet *set1, const BitSet *set2)
+{
+    /* Quick test -- The sets must share a universe and be the same size */
+    if(set1->universe != set2->universe || bitset_size(set1) != bitset_size(set2))
+        return 0;
+
+    return memcmp(set1->bits, set2->bits, set1->words * sizeof(uint64_t)) == 0 ? 1 : 0;
+}
+
+
+/* Count the members two sets have in common */
+int bitset_intersection_count(const BitSet *set1, const BitSet *set2)
+{
+    if(set1->universe != set2->universe)
+        return -1;
+
+    int count = 0;
+    for(int i = 0; i < set1->words; i++)
+        count += __builtin_popcountll(bitset_load(set1->bits, i) & bitset_load(set2->bits, i));
+
+    return count;
+}
+
+
+/* Count the members of the set */
+int bitset_count(BitSet *set)
+{
+    int count = 0;
+    for(int i = 0; i < set->words; i++)
+        count += __builtin_popcountll(bitset_load(set->bits, i));
+
+    /* Refresh the cached size */
+    set->size = count;
+
+    return count;
+}
+
+
+/* Find the smallest member >= pos */
+int bitset_next(const BitSet *set, int pos)
+{
+    if(pos < 0)
+        pos = 0;
+    if(pos >= set->universe)
+        return -1;
+
+    /* Look at the word containing pos, ignoring the members before pos */
+    int i = pos / 64;
+    uint64_t word = bitset_load_ordered(set->bits, i) & (~(uint64_t)0 >> (pos % 64));
+
+    /* Skip empty words */
+    while(word == 0)
+    {
+        if(++i >= set->words)
+            return -1;
+        word = bitset_load_ordered(set->bits, i);
+    }
+
+    /* The left-most set bit of the word is the next member (padding bits are always clear) */
+    return i * 64 + __builtin_clzll(word);
+}
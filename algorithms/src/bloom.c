@@ -0,0 +1,365 @@
+/* Implementation of Bloom Filters */
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "bit.h"
+#include "list.h"
+#include "chtbl.h"
+#include "ohtbl.h"
+#include "bloom.h"
+
+/*
+*************************************
+        Private Useful Macros
+*************************************
+*/
+
+/* Keys located ahead of touching the filter in the batch methods */
+#define BLOOM_BATCH 16
+
+/* Most hashes per key (more never pays: k = 24 is already a rate of about 1e-7) */
+#define BLOOM_MAX_HASHES 24
+
+/* Cache line size, which buffers are aligned to */
+#define BLOOM_LINE 64
+
+
+
+
+/*
+*************************************
+        Private Helper Functions
+*************************************
+*/
+
+/* Remix a caller's hash so both halves are uniform (splitmix64 finalizer) */
+static inline uint64_t bloom_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+
+/* Map a 32-bit value onto [0, n) without a division (Lemire's multiply-shift) */
+static inline uint32_t bloom_range(uint32_t x, uint32_t n)
+{
+    return (uint32_t)(((uint64_t)x * n) >> 32);
+}
+
+
+/* Positions of a key's bits
+     - Standard: anywhere in the m bits, row i of double hashing being h1 + i * h2 (Kirsch and Mitzenmacher)
+     - Blocked: the high half picks a block, and each position inside its 512 bits takes 9 fresh hash bits -- Double hashing
+       modulo 512 only draws on 17 bits, and its patterns collide often enough to double the rate at 0.1%
+*/
+static inline void bloom_positions(const Bloom *bloom, uint64_t hash, uint32_t *pos)
+{
+    hash = bloom_mix(hash);
+    uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+
+    if(bloom->kind == BLOOM_BLOCKED)
+    {
+        uint32_t base = bloom_range(h2, (uint32_t)(bloom->num_bits / BLOOM_BLOCK_BITS)) * BLOOM_BLOCK_BITS;
+        uint64_t stream = bloom_mix(hash + 0x9e3779b97f4a7c15ULL);
+        int left = 64;
+
+        for(int i = 0; i < bloom->hashes; i++)
+        {
+            if(left < 9)
+            {
+                stream = bloom_mix(stream + 0x9e3779b97f4a7c15ULL);
+                left = 64;
+            }
+            pos[i] = base + (uint32_t)(stream & (BLOOM_BLOCK_BITS - 1));
+            stream >>= 9;
+            left -= 9;
+        }
+    }
+    else
+    {
+        for(int i = 0; i < bloom->hashes; i++)
+            pos[i] = bloom_range(h1 + (uint32_t)i * h2, (uint32_t)bloom->num_bits);
+    }
+}
+
+
+/* Set the bits at a key's positions -- bit.h order, position 0 being the left-most bit of the first byte */
+static inline void bloom_set(unsigned char *bits, const uint32_t *pos, int k)
+{
+    for(int i = 0; i < k; i++)
+        bits[pos[i] >> 3] |= (unsigned char)(0x80 >> (pos[i] & 7));
+}
+
+
+/* Test the bits at a key's positions */
+static inline int bloom_test(const unsigned char *bits, const uint32_t *pos, int k)
+{
+    for(int i = 0; i < k; i++)
+        if(!(bits[pos[i] >> 3] & (0x80 >> (pos[i] & 7))))
+            return 0;
+    return 1;
+}
+
+
+/* Rate of false positives of a blocked filter
+     - Keys spread over the blocks as a Poisson distribution with mean n / blocks, and a block holding i keys answers like a
+       standard filter of 512 bits holding i keys
+*/
+static double bloom_blocked_rate(int blocks, double n, int k)
+{
+    double mean = n / blocks, p = exp(-mean), rate = 0.0;
+    int last = (int)(mean + 12.0 * sqrt(mean)) + 20;
+
+    for(int i = 0; i <= last; i++)
+    {
+        rate += p * pow(1.0 - pow(1.0 - 1.0 / BLOOM_BLOCK_BITS, (double)k * i), k);
+        p *= mean / (i + 1);
+    }
+
+    return rate;
+}
+
+
+/* Put an element of a guarded table into its filter */
+static void bloom_guard_add(BloomGuard *guard, const void *data)
+{
+    bloom_add(&guard->filter, guard->hash(data));
+}
+
+
+
+
+/*
+************************************************
+        Interface Method Implementations
+************************************************
+*/
+
+/* Initialize a Bloom filter */
+int bloom_init(Bloom *bloom, int kind, int expected, double fp_rate)
+{
+    if( (kind != BLOOM_STANDARD && kind != BLOOM_BLOCKED) || expected < 1 || fp_rate <= 0.0 || fp_rate >= 1.0 )
+        return -1;
+
+    /* The optimal standard filter */
+    double ln2 = log(2.0);
+    double m = ceil(-(double)expected * log(fp_rate) / (ln2 * ln2));
+    int k = (int)(m / expected * ln2 + 0.5);
+    k = (k < 1) ? 1 : (k > BLOOM_MAX_HASHES) ? BLOOM_MAX_HASHES : k;
+
+    /* A blocked filter grows 5% at a time until its uneven blocks get the rate down too */
+    if(kind == BLOOM_BLOCKED)
+    {
+        double blocks = ceil(m / BLOOM_BLOCK_BITS);
+        while(blocks * BLOOM_BLOCK_BITS < INT32_MAX / 2 && bloom_blocked_rate((int)blocks, expected, k) > fp_rate)
+            blocks = ceil(blocks * 1.05);
+        m = blocks * BLOOM_BLOCK_BITS;
+    }
+
+    if(m > INT32_MAX - BLOOM_LINE * 8)
+        return -1;
+
+    /* Whole cache lines of bytes, aligned so a block never straddles two */
+    size_t bytes = ((size_t)m / 8 + BLOOM_LINE) / BLOOM_LINE * BLOOM_LINE;
+    bloom->bits = aligned_alloc(BLOOM_LINE, bytes);
+    if(bloom->bits == NULL)
+        return -1;
+    memset(bloom->bits, 0, bytes);
+
+    bloom->kind = kind;
+    bloom->num_bits = (int)m;
+    bloom->hashes = k;
+    bloom->size = 0;
+
+    return 0;
+}
+
+
+/* Destroy a Bloom filter */
+void bloom_destroy(Bloom *bloom)
+{
+    free(bloom->bits);
+
+    /* To be safe, clear the structure */
+    memset(bloom, 0, sizeof(Bloom));
+}
+
+
+/* Add a key to the filter */
+void bloom_add(Bloom *bloom, uint64_t hash)
+{
+    uint32_t pos[BLOOM_MAX_HASHES];
+
+    bloom_positions(bloom, hash, pos);
+    bloom_set(bloom->bits, pos, bloom->hashes);
+    bloom->size++;
+}
+
+
+/* Determine whether a key may have been added */
+int bloom_contains(const Bloom *bloom, uint64_t hash)
+{
+    uint32_t pos[BLOOM_MAX_HASHES];
+
+    bloom_positions(bloom, hash, pos);
+    return bloom_test(bloom->bits, pos, bloom->hashes);
+}
+
+
+/* Add an array of keys */
+void bloom_add_n(Bloom *bloom, const uint64_t *hashes, int n)
+{
+    uint32_t pos[BLOOM_BATCH][BLOOM_MAX_HASHES];
+    int k = bloom->hashes;
+
+    for(int start = 0; start < n; start += BLOOM_BATCH)
+    {
+        int batch = (n - start < BLOOM_BATCH) ? n - start : BLOOM_BATCH;
+
+        /* Locate the whole batch first, asking for each line it will write */
+        for(int j = 0; j < batch; j++)
+        {
+            bloom_positions(bloom, hashes[start + j], pos[j]);
+            if(bloom->kind == BLOOM_BLOCKED)
+                __builtin_prefetch(&bloom->bits[pos[j][0] >> 3], 1);
+            else
+                for(int i = 0; i < k; i++)
+                    __builtin_prefetch(&bloom->bits[pos[j][i] >> 3], 1);
+        }
+
+        for(int j = 0; j < batch; j++)
+            bloom_set(bloom->bits, pos[j], k);
+    }
+
+    bloom->size += n;
+}
+
+
+/* Query an array of keys */
+int bloom_contains_n(const Bloom *bloom, const uint64_t *hashes, int n, unsigned char *found)
+{
+    uint32_t pos[BLOOM_BATCH][BLOOM_MAX_HASHES];
+    int k = bloom->hashes, count = 0;
+
+    for(int start = 0; start < n; start += BLOOM_BATCH)
+    {
+        int batch = (n - start < BLOOM_BATCH) ? n - start : BLOOM_BATCH;
+
+        for(int j = 0; j < batch; j++)
+        {
+            bloom_positions(bloom, hashes[start + j], pos[j]);
+            if(bloom->kind == BLOOM_BLOCKED)
+                __builtin_prefetch(&bloom->bits[pos[j][0] >> 3], 0);
+            else
+                for(int i = 0; i < k; i++)
+                    __builtin_prefetch(&bloom->bits[pos[j][i] >> 3], 0);
+        }
+
+        for(int j = 0; j < batch; j++)
+        {
+            int maybe = bloom_test(bloom->bits, pos[j], k);
+            if(found != NULL)
+                found[start + j] = (unsigned char)maybe;
+            count += maybe;
+        }
+    }
+
+    return count;
+}
+
+
+/* Merge another filter into this one */
+int bloom_union(Bloom *bloom, const Bloom *other)
+{
+    if(bloom->kind != other->kind || bloom->num_bits != other->num_bits || bloom->hashes != other->hashes)
+        return -1;
+
+    bit_or(bloom->bits, other->bits, bloom->bits, bloom->num_bits);
+    bloom->size += other->size;
+
+    return 0;
+}
+
+
+/* Put a filter in front of a chained hash table */
+int bloom_guard_chtbl(BloomGuard *guard, CHTbl *htbl, uint64_t (*hash)(const void *data), int kind, int expected, double fp_rate)
+{
+    if(bloom_init(&guard->filter, kind, expected, fp_rate) != 0)
+        return -1;
+
+    guard->hash = hash;
+    guard->chtbl = htbl;
+    guard->ohtbl = NULL;
+
+    /* Elements already in the table */
+    for(int b = 0; b < htbl->buckets; b++)
+        for(ListElement *element = list_head(&htbl->table[b]); element != NULL; element = list_next(element))
+            bloom_guard_add(guard, list_data(element));
+
+    return 0;
+}
+
+
+/* Put a filter in front of an open-addressed hash table */
+int bloom_guard_ohtbl(BloomGuard *guard, OHTbl *htbl, uint64_t (*hash)(const void *data), int kind, int expected, double fp_rate)
+{
+    if(bloom_init(&guard->filter, kind, expected, fp_rate) != 0)
+        return -1;
+
+    guard->hash = hash;
+    guard->chtbl = NULL;
+    guard->ohtbl = htbl;
+
+    /* Elements already in the table, skipping empty and vacated positions */
+    for(int i = 0; i < htbl->positions; i++)
+        if(htbl->table[i] != NULL && htbl->table[i] != htbl->vacated)
+            bloom_guard_add(guard, htbl->table[i]);
+
+    return 0;
+}
+
+
+/* Stop guarding a table */
+void bloom_guard_destroy(BloomGuard *guard)
+{
+    bloom_destroy(&guard->filter);
+
+    /* To be safe, clear the structure */
+    memset(guard, 0, sizeof(BloomGuard));
+}
+
+
+/* Insert an element into a guarded table */
+int bloom_guard_insert(BloomGuard *guard, const void *data)
+{
+    int retval = (guard->chtbl != NULL) ? chtbl_insert(guard->chtbl, data) : ohtbl_insert(guard->ohtbl, data);
+
+    /* An element that was already there is already in the filter */
+    if(retval == 0)
+        bloom_guard_add(guard, data);
+
+    return retval;
+}
+
+
+/* Remove an element from a guarded table */
+int bloom_guard_remove(BloomGuard *guard, void **data)
+{
+    return (guard->chtbl != NULL) ? chtbl_remove(guard->chtbl, data) : ohtbl_remove(guard->ohtbl, data);
+}
+
+
+/* Look up an element in a guarded table */
+int bloom_guard_lookup(const BloomGuard *guard, void **data)
+{
+    /* Definitely absent: skip the table */
+    if(!bloom_contains(&guard->filter, guard->hash(*data)))
+        return -1;
+
+    return (guard->chtbl != NULL) ? chtbl_lookup(guard->chtbl, data) : ohtbl_lookup(guard->ohtbl, data);
+}
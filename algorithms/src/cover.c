@@ -0,0 +1,105 @@
+/* Implementation of Set Covering */
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "cover.h"
+#include "pqueue.h"
+
+/* Candidate subset waiting in the priority queue */
+typedef struct CoverCandidate_ {
+    int index;  /* Index of the subset */
+    int gain;   /* Number of uncovered members the subset covered when gain was computed */
+    int round;  /* Round in which gain was computed */
+} CoverCandidate;
+
+
+/* Order candidates by gain (largest first), breaking ties by index (smallest first) */
+static int cover_compare(const void *key1, const void *key2)
+{
+    const CoverCandidate *c1 = key1, *c2 = key2;
+
+    if(c1->gain != c2->gain)
+        return (c1->gain > c2->gain) ? 1 : -1;
+    if(c1->index != c2->index)
+        return (c1->index < c2->index) ? 1 : -1;
+    return 0;
+}
+
+
+/* Find a covering with the lazy greedy heuristic */
+int set_cover(const BitSet *members, const BitSet *subsets, int count, int *covering, int *size)
+{
+    *size = 0;
+
+    /* The members not yet covered (the union of members with itself is a copy) */
+    BitSet uncovered;
+    if(bitset_union(&uncovered, members, members) != 0)
+        return -1;
+
+    /* One candidate per subset, all allocated at once */
+    CoverCandidate *candidates = malloc((count > 0 ? count : 1) * sizeof(CoverCandidate));
+    if(candidates == NULL)
+    {
+        bitset_destroy(&uncovered);
+        return -1;
+    }
+
+    /* Queue up every subset that covers something, keyed by its initial gain */
+    PQueue queue;
+    pqueue_init(&queue, cover_compare, NULL);
+    int retval = 0, round = 0;
+    for(int i = 0; i < count && retval == 0; i++)
+    {
+        candidates[i].index = i;
+        candidates[i].gain = bitset_intersection_count(&subsets[i], &uncovered);
+        candidates[i].round = round;
+
+        if(candidates[i].gain < 0)
+            retval = -1;
+        else if(candidates[i].gain > 0 && pqueue_insert(&queue, &candidates[i]) != 0)
+            retval = -1;
+    }
+
+    /* Pick subsets until everything is covered or nothing useful is left */
+    while(retval == 0 && bitset_size(&uncovered) > 0)
+    {
+        CoverCandidate *top;
+        if(pqueue_extract(&queue, (void **)&top) != 0)
+        {
+            /* The queue is empty, so the remaining members cannot be covered */
+            retval = 1;
+            break;
+        }
+
+        /* A stale gain is recomputed and the candidate goes back in line (or is dropped once it covers nothing) */
+        if(top->round != round)
+        {
+            top->gain = bitset_intersection_count(&subsets[top->index], &uncovered);
+            top->round = round;
+            if(top->gain > 0 && pqueue_insert(&queue, top) != 0)
+                retval = -1;
+            continue;
+        }
+
+        /* An up-to-date gain at the top of the queue beats every other candidate, so pick it */
+        covering[(*size)++] = top->index;
+
+        BitSet remaining;
+        if(bitset_difference(&remaining, &uncovered, &subsets[top->index]) != 0)
+        {
+            retval = -1;
+            break;
+        }
+        bitset_destroy(&uncovered);
+        uncovered = remaining;
+        round++;
+    }
+
+    /* Cleanup */
+    pqueue_destroy(&queue);
+    bitset_destroy(&uncovered);
+    free(candidates);
+
+    return retval;
+}
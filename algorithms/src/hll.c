@@ -0,0 +1,436 @@
+/* Implementation of HyperLogLog Cardinality Estimation */
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bit.h"
+#include "hll.h"
+
+/*
+*************************************
+        Private Useful Macros
+*************************************
+*/
+
+/* Bytes read past the last register by the word-wide merge (whole words and vectors may overhang a group) */
+#define HLL_PADDING 32
+
+/* The eight 6-bit registers of a group, read as the top 48 bits of a word, and the top bit of each */
+#define HLL_FIELDS 0xFFFFFFFFFFFF0000ULL
+#define HLL_HIGHS 0x8208208208200000ULL
+
+
+
+
+/*
+*************************************
+        Private Helper Functions
+*************************************
+*/
+
+/* Finish a 64-bit hash so every bit depends on every input bit (splitmix64) */
+static inline uint64_t hll_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+
+/* Position of the first 1 bit in the low bits of a hash once its index bits are shifted off
+     - A hash of all zeros past the index counts as if its next bit were 1
+*/
+static inline int hll_rank(uint64_t hash, int index_bits)
+{
+    uint64_t rest = hash << index_bits;
+    return rest ? __builtin_clzll(rest) + 1 : 64 - index_bits + 1;
+}
+
+
+/* Raise a dense register to a rank if the rank is larger */
+static inline void hll_dense_update(Hll *hll, int j, int rank)
+{
+    if(rank > (int)bit_get_field(hll->dense, 6 * j, 6))
+        bit_set_field(hll->dense, 6 * j, 6, rank);
+}
+
+
+/* Encode a hash as a sparse entry (25-bit index << 6 | rank) */
+static inline uint32_t hll_sparse_entry(uint64_t hash)
+{
+    uint32_t index = (uint32_t)(hash >> (64 - HLL_SPARSE_PRECISION));
+    return (index << 6) | (uint32_t)hll_rank(hash, HLL_SPARSE_PRECISION);
+}
+
+
+/* Apply a sparse entry to the dense registers
+     - The dense index is the top p bits of the 25-bit index
+     - If the remaining 25 - p bits of that index hold a 1, the dense rank is found there; otherwise it continues the sparse rank
+*/
+static inline void hll_dense_apply(Hll *hll, uint32_t entry)
+{
+    int extra = HLL_SPARSE_PRECISION - hll->precision;
+    uint32_t index = entry >> 6, low = index & ((1u << extra) - 1);
+    int rank = low ? __builtin_clz(low) - (32 - extra) + 1 : extra + (int)(entry & 63);
+
+    hll_dense_update(hll, (int)(index >> extra), rank);
+}
+
+
+/* Order sparse entries for qsort() */
+static int hll_compare(const void *key1, const void *key2)
+{
+    uint32_t a = *(const uint32_t *)key1, b = *(const uint32_t *)key2;
+    return (a > b) - (a < b);
+}
+
+
+/* Sort the sparse entries and keep only the largest rank for each index */
+static void hll_sparse_compact(Hll *hll)
+{
+    if(hll->sparse_sorted == hll->sparse_size)
+        return;
+
+    qsort(hll->sparse, hll->sparse_size, sizeof(uint32_t), hll_compare);
+
+    /* Entries sort by index, then rank, so the last entry of each index wins */
+    int kept = 0;
+    for(int i = 0; i < hll->sparse_size; i++)
+    {
+        if(i + 1 < hll->sparse_size && (hll->sparse[i + 1] >> 6) == (hll->sparse[i] >> 6))
+            continue;
+        hll->sparse[kept++] = hll->sparse[i];
+    }
+
+    hll->sparse_size = kept;
+    hll->sparse_sorted = kept;
+}
+
+
+/* Move a sparse sketch to dense registers */
+static int hll_to_dense(Hll *hll)
+{
+    size_t bytes = (size_t)hll->registers * 6 / 8;
+    hll->dense = calloc(bytes + HLL_PADDING, 1);
+    if(hll->dense == NULL)
+        return -1;
+
+    for(int i = 0; i < hll->sparse_size; i++)
+        hll_dense_apply(hll, hll->sparse[i]);
+
+    free(hll->sparse);
+    hll->sparse = NULL;
+    hll->sparse_size = hll->sparse_sorted = hll->sparse_capacity = 0;
+
+    return 0;
+}
+
+
+/* Add an entry to a sparse sketch, compacting when the list fills and going dense once compaction stops freeing half */
+static int hll_sparse_add(Hll *hll, uint32_t entry)
+{
+    if(hll->sparse_size == hll->sparse_capacity)
+    {
+        hll_sparse_compact(hll);
+        if(hll->sparse_size > hll->sparse_capacity / 2)
+        {
+            if(hll_to_dense(hll) != 0)
+                return -1;
+            hll_dense_apply(hll, entry);
+            return 0;
+        }
+    }
+
+    hll->sparse[hll->sparse_size++] = entry;
+    return 0;
+}
+
+
+/* sigma(x) = x + sum over k >= 1 of x^(2^k) * 2^(k-1) -- Accounts for registers still at zero */
+static double hll_sigma(double x)
+{
+    if(x == 1.0)
+        return INFINITY;
+
+    double y = 1.0, z = x, previous;
+    do
+    {
+        x *= x;
+        previous = z;
+        z += x * y;
+        y += y;
+    } while(z != previous);
+
+    return z;
+}
+
+
+/* tau(x) = (1 - x - sum over k >= 1 of (1 - x^(2^-k))^2 * 2^-k) / 3 -- Accounts for registers at their maximum */
+static double hll_tau(double x)
+{
+    if(x == 0.0 || x == 1.0)
+        return 0.0;
+
+    double y = 1.0, z = 1.0 - x, previous;
+    do
+    {
+        x = sqrt(x);
+        previous = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while(z != previous);
+
+    return z / 3.0;
+}
+
+
+/* Load a group of eight registers (6 bytes) as the top 48 bits of a word */
+static inline uint64_t hll_group_load(const unsigned char *bytes)
+{
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    return word & HLL_FIELDS;
+}
+
+
+/* Store the top 48 bits of a word as a group of eight registers */
+static inline void hll_group_store(unsigned char *bytes, uint64_t word)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    memcpy(bytes, &word, 6);
+}
+
+
+/* Maximum of each of the eight 6-bit fields of two words, without unpacking them
+     - With the top bit of each field of x forced on, subtracting the low 5 bits of y's field cannot borrow out of the field,
+       and the top bit survives exactly when x's low bits are at least y's
+     - x >= y when x's top bit is set and y's is not, or the top bits agree and the low bits did not borrow
+     - The top bit of each field where x wins is widened to the whole field to select between x and y
+*/
+static inline uint64_t hll_group_max(uint64_t x, uint64_t y)
+{
+    uint64_t low = (x | HLL_HIGHS) - (y & ~HLL_HIGHS);
+    uint64_t ge = ((x & ~y) | (~(x ^ y) & low)) & HLL_HIGHS;
+    uint64_t mask = ge | (ge - (ge >> 5));
+
+    return (x & mask) | (y & ~mask);
+}
+
+
+/* Merge dense registers, eight at a time, or 32 at a time with AVX2
+     - An SSE2 version (16 at a time) measured no faster than the word version, since reversing bytes without a byte
+       shuffle costs as much as it saves
+*/
+static void hll_dense_merge(unsigned char *dst, const unsigned char *src, int registers)
+{
+    int groups = registers / 8, g = 0;
+
+#if defined(__AVX2__)
+    /* Four groups (24 bytes) per step: spread them into the four 64-bit lanes, byte-reversed into the top 48 bits */
+    const __m256i spread = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+    const __m256i gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+    const __m256i unpack = _mm256_setr_epi8(-128, -128, 5, 4, 3, 2, 1, 0, -128, -128, 11, 10, 9, 8, 7, 6,
+                                            -128, -128, 5, 4, 3, 2, 1, 0, -128, -128, 11, 10, 9, 8, 7, 6);
+    const __m256i pack = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 15, 14, 13, 12, 11, 10, -128, -128, -128, -128,
+                                          7, 6, 5, 4, 3, 2, 15, 14, 13, 12, 11, 10, -128, -128, -128, -128);
+    const __m256i highs = _mm256_set1_epi64x((long long)HLL_HIGHS);
+
+    for(; g + 4 <= groups; g += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(dst + 6 * g));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(src + 6 * g));
+        x = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(x, spread), unpack);
+        y = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(y, spread), unpack);
+
+        __m256i low = _mm256_sub_epi64(_mm256_or_si256(x, highs), _mm256_andnot_si256(highs, y));
+        __m256i ge = _mm256_or_si256(_mm256_andnot_si256(y, x), _mm256_andnot_si256(_mm256_xor_si256(x, y), low));
+        ge = _mm256_and_si256(ge, highs);
+        __m256i mask = _mm256_or_si256(ge, _mm256_sub_epi64(ge, _mm256_srli_epi64(ge, 5)));
+        __m256i max = _mm256_or_si256(_mm256_and_si256(mask, x), _mm256_andnot_si256(mask, y));
+
+        /* Store exactly the 24 bytes, since a wider (even masked) store would overlap the next step's load and stall it */
+        max = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(max, pack), gather);
+        _mm_storeu_si128((__m128i *)(dst + 6 * g), _mm256_castsi256_si128(max));
+        _mm_storel_epi64((__m128i *)(dst + 6 * g + 16), _mm256_extracti128_si256(max, 1));
+    }
+#endif
+
+    /* Remaining groups (all of them, without AVX2) one word at a time */
+    for(; g < groups; g++)
+        hll_group_store(dst + 6 * g, hll_group_max(hll_group_load(dst + 6 * g), hll_group_load(src + 6 * g)));
+}
+
+
+
+
+/*
+************************************************
+        Interface Method Implementations
+************************************************
+*/
+
+/* Initialize a HyperLogLog sketch */
+int hll_init(Hll *hll, int precision)
+{
+    if(precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION)
+        return -1;
+
+    hll->precision = precision;
+    hll->registers = 1 << precision;
+    hll->dense = NULL;
+
+    /* The sparse list may use as many bytes as the dense registers would */
+    hll->sparse_capacity = hll->registers * 6 / 8 / sizeof(uint32_t);
+    hll->sparse_size = hll->sparse_sorted = 0;
+    hll->sparse = malloc(hll->sparse_capacity * sizeof(uint32_t));
+    if(hll->sparse == NULL)
+        return -1;
+
+    return 0;
+}
+
+
+/* Destroy a HyperLogLog sketch */
+void hll_destroy(Hll *hll)
+{
+    free(hll->dense);
+    free(hll->sparse);
+
+    /* To be safe, clear the structure */
+    memset(hll, 0, sizeof(Hll));
+}
+
+
+/* Hash a key for the sketch */
+uint64_t hll_hash(const void *data, int size)
+{
+    const unsigned char *bytes = data;
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ (uint64_t)size, chunk;
+
+    /* Eight bytes at a time, then the tail zero-padded */
+    for(; size >= 8; size -= 8, bytes += 8)
+    {
+        memcpy(&chunk, bytes, 8);
+        hash = (hash ^ hll_mix(chunk)) * 0x9fb21c651e98df25ULL;
+    }
+    if(size > 0)
+    {
+        chunk = 0;
+        memcpy(&chunk, bytes, size);
+        hash = (hash ^ hll_mix(chunk)) * 0x9fb21c651e98df25ULL;
+    }
+
+    return hll_mix(hash);
+}
+
+
+/* Add a hashed key to the sketch */
+int hll_add(Hll *hll, uint64_t hash)
+{
+    if(hll->dense == NULL)
+        return hll_sparse_add(hll, hll_sparse_entry(hash));
+
+    hll_dense_update(hll, (int)(hash >> (64 - hll->precision)), hll_rank(hash, hll->precision));
+    return 0;
+}
+
+
+/* Add an array of hashed keys to the sketch */
+int hll_add_n(Hll *hll, const uint64_t *hashes, int n)
+{
+    int i = 0;
+
+    /* While sparse, entries are only appended, so the list's room says how many can go in without a check */
+    while(i < n && hll->dense == NULL)
+    {
+        int room = hll->sparse_capacity - hll->sparse_size;
+        if(room == 0)
+        {
+            if(hll_sparse_add(hll, hll_sparse_entry(hashes[i++])) != 0)
+                return -1;
+            continue;
+        }
+
+        int take = (n - i < room) ? n - i : room;
+        for(int k = 0; k < take; k++)
+            hll->sparse[hll->sparse_size + k] = hll_sparse_entry(hashes[i + k]);
+        hll->sparse_size += take;
+        i += take;
+    }
+
+    /* Dense: index and rank straight from each hash */
+    int shift = 64 - hll->precision;
+    for(; i < n; i++)
+        hll_dense_update(hll, (int)(hashes[i] >> shift), hll_rank(hashes[i], hll->precision));
+
+    return 0;
+}
+
+
+/* Estimate the number of distinct keys added */
+double hll_count(Hll *hll)
+{
+    /* Sparse: linear counting over the 2^25 sparse registers, nearly exact while few are taken */
+    if(hll->dense == NULL)
+    {
+        hll_sparse_compact(hll);
+        double m = (double)(1 << HLL_SPARSE_PRECISION);
+        return m * log(m / (m - hll->sparse_size));
+    }
+
+    /* Dense: Ertl's estimator from the histogram of register values */
+    int q = 64 - hll->precision, counts[66] = {0};
+    for(int j = 0; j < hll->registers; j++)
+        counts[hll_register(hll, j)]++;
+
+    double m = (double)hll->registers;
+    if(counts[0] == hll->registers)
+        return 0.0;
+
+    double z = m * hll_tau(1.0 - counts[q + 1] / m);
+    for(int k = q; k >= 1; k--)
+        z = 0.5 * (z + counts[k]);
+    z += m * hll_sigma(counts[0] / m);
+
+    return (0.5 / log(2.0)) * m * m / z;
+}
+
+
+/* Merge another sketch into this one */
+int hll_merge(Hll *hll, Hll *other)
+{
+    if(hll->precision != other->precision)
+        return -1;
+
+    /* A sparse sketch contributes its entries, which go wherever this sketch keeps its own */
+    if(other->dense == NULL)
+    {
+        hll_sparse_compact(other);
+        for(int i = 0; i < other->sparse_size; i++)
+        {
+            if(hll->dense != NULL)
+                hll_dense_apply(hll, other->sparse[i]);
+            else if(hll_sparse_add(hll, other->sparse[i]) != 0)
+                return -1;
+        }
+        return 0;
+    }
+
+    if(hll->dense == NULL && hll_to_dense(hll) != 0)
+        return -1;
+
+    hll_dense_merge(hll->dense, other->dense, hll->registers);
+    return 0;
+}
@@ -1,6 +1,7 @@
 /* Testing Bit Operations */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "bit.h"
 
@@ -49,7 +50,70 @@ int main()
     printf("buf0 AND ~buf0:  "); bit_and(buf0, buf0_invert, bufo, 20); print_bits(bufo, 20); printf("\n");
     printf("buf0 OR  ~buf0:  "); bit_or(buf0, buf0_invert, bufo, 20); print_bits(bufo, 20); printf("\n");
     printf("buf0 XOR ~buf0:  "); bit_xor(buf0, buf0_invert, bufo, 20); print_bits(bufo, 20); printf("\n");
+    printf("NOT buf0:  "); bit_not(buf0, bufo, 20); print_bits(bufo, 20); printf("\n");
+    printf("buf0 ANDNOT 1:  "); bit_andnot(buf0, ones, bufo, 20); print_bits(bufo, 20); printf("\n");
+    printf("buf0 ANDNOT ~buf0:  "); bit_andnot(buf0, buf0_invert, bufo, 20); print_bits(bufo, 20); printf("\n");
+
+    /* Bits past num_bits in the last byte of bufo are left alone */
+    bufo[2] = 0x05;
+    bit_or(buf0, ones, bufo, 20);
+    printf("Tail bits of bufo kept? : %s\n", (bufo[2] & 0x0F) == 0x05 ? "yes" : "no");
+
+    /* Long buffers go through the word and vector loops: compare with one bit at a time at several lengths */
+    int big = 1000, agree = 1;
+    unsigned char *a = malloc(big), *b = malloc(big), *out = malloc(big), *expect = malloc(big);
+    srand(5);
+    for(int i = 0; i < big; i++)
+    {
+        a[i] = rand() & 0xFF;
+        b[i] = rand() & 0xFF;
+    }
+    int lengths[] = {1, 63, 64, 65, 127, 129, 255, 256, 257, 511, 4001, 8 * big};
+    for(int l = 0; l < (int)(sizeof(lengths) / sizeof(lengths[0])); l++)
+    {
+        int n = lengths[l];
+        for(int op = 0; op < 5; op++)
+        {
+            memset(out, 0xA5, big);
+            memset(expect, 0xA5, big);
+            for(int i = 0; i < n; i++)
+            {
+                int x = bit_get(a, i), y = bit_get(b, i);
+                int r = (op == 0) ? x & y : (op == 1) ? x | y : (op == 2) ? x ^ y : (op == 3) ? x & !y : !x;
+                bit_set(expect, i, r);
+            }
+            if(op == 0) bit_and(a, b, out, n);
+            if(op == 1) bit_or(a, b, out, n);
+            if(op == 2) bit_xor(a, b, out, n);
+            if(op == 3) bit_andnot(a, b, out, n);
+            if(op == 4) bit_not(a, out, n);
+            agree = agree && memcmp(out, expect, big) == 0;
+        }
+    }
+    printf("AND, OR, XOR, ANDNOT, NOT match bit by bit up to %d bits? : %s\n", 8 * big, agree ? "yes" : "no");
+
+    /* Result written over one of the inputs */
+    memcpy(out, a, big);
+    bit_xor(out, b, out, 8 * big);
+    bit_xor(out, b, out, 8 * big);
+    printf("In place XOR twice restores the buffer? : %s\n", memcmp(out, a, big) == 0 ? "yes" : "no");
+    free(a);
+    free(b);
+    free(out);
+    free(expect);
     
+    /* Getting and setting fields of bits */
+    unsigned char fields[3] = {0xF8, 0x3E, 0xEE};  /* 11111000 00111110 11101110 */
+    printf("\n---------- Bit Fields ----------\n");
+    printf("fields:  "); print_bits(fields, 24); printf("\n");
+    printf("6 bits at pos  5:  %u\n", bit_get_field(fields, 5, 6));
+    printf("4 bits at pos  0:  %u\n", bit_get_field(fields, 0, 4));
+    printf("20 bits at pos 4:  %u\n", bit_get_field(fields, 4, 20));
+    bit_set_field(fields, 5, 6, 42);
+    printf("Set 6 bits at pos 5 to 42:  "); print_bits(fields, 24); printf(" (Read back %u)\n", bit_get_field(fields, 5, 6));
+    bit_set_field(fields, 18, 6, 0);
+    printf("Set 6 bits at pos 18 to 0:  "); print_bits(fields, 24); printf("\n");
+
     /* Rotating bits */
     printf("\n---------- Bit Rotate Left ----------\n");
     printf("buf0:  "); print_bits(buf0, 20); printf("\n");
@@ -0,0 +1,133 @@
+/* Testing the Bitset-Backed Set Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bit.h"
+#include "bitset.h"
+
+#define UNIVERSE 100
+#define BIG_UNIVERSE 1000000
+
+void print_bitset(BitSet *set, char *name);
+void insert_multiples(BitSet *set, int step);
+
+/* Testing methods and macros
+    Methods:
+      - bitset_init()
+      - bitset_destroy()
+      - bitset_insert()
+      - bitset_remove()
+      - bitset_union()
+      - bitset_intersection()
+      - bitset_difference()
+      - bitset_is_element()
+      - bitset_is_subset()
+      - bitset_is_equal()
+      - bitset_intersection_count()
+      - bitset_count()
+      - bitset_next()
+    Macros:
+      - bitset_size()
+      - bitset_universe()
+      - bitset_bits()
+*/
+int main()
+{
+    /* Create some sets over the universe [0, 100) */
+    BitSet A, B, C;
+    bitset_init(&A, UNIVERSE);
+    bitset_init(&B, UNIVERSE);
+    bitset_init(&C, UNIVERSE);
+
+    /* A = multiples of 6, B = multiples of 15, C = {0, 1, ..., 9} */
+    insert_multiples(&A, 6);
+    insert_multiples(&B, 15);
+    for(int i = 0; i < 10; i++)
+        bitset_insert(&C, i);
+    printf("--- Inserted Members into Set ---\n");
+    print_bitset(&A, "A");
+    print_bitset(&B, "B");
+    print_bitset(&C, "C");
+    printf("Inserting 6 into A again : %s\n", bitset_insert(&A, 6) == 0 ? "inserted" : "rejected");
+    printf("Inserting 100 into A     : %s\n", bitset_insert(&A, 100) == 0 ? "inserted" : "rejected");
+    printf("\n");
+
+    /* Set algebra */
+    BitSet AuB, AB, CA;
+    bitset_union(&AuB, &A, &B);
+    bitset_intersection(&AB, &A, &B);
+    bitset_difference(&CA, &C, &A);
+    printf("--- Performed Set Algebra ---\n");
+    print_bitset(&AuB, "A+B");
+    print_bitset(&AB, "AB");
+    print_bitset(&CA, "C-A");
+    printf("|AB| without building AB = %d\n", bitset_intersection_count(&A, &B));
+    printf("\n");
+
+    /* Membership, subsets, and equality */
+    printf("--- Checking Membership, Subsets, and Equality ---\n");
+    printf("30 in A? : %s\n", bitset_is_element(&A, 30) ? "yes" : "no");
+    printf("31 in A? : %s\n", bitset_is_element(&A, 31) ? "yes" : "no");
+    printf("AB is subset of A? : %s\n", bitset_is_subset(&AB, &A) ? "yes" : "no");
+    printf("A is subset of AB? : %s\n", bitset_is_subset(&A, &AB) ? "yes" : "no");
+    printf("A is equal to A?   : %s\n", bitset_is_equal(&A, &A) ? "yes" : "no");
+    printf("A is equal to B?   : %s\n", bitset_is_equal(&A, &B) ? "yes" : "no");
+    printf("\n");
+
+    /* Remove members */
+    printf("--- Removing Members ---\n");
+    for(int i = 0; i < 10; i += 2)
+        bitset_remove(&C, i);
+    print_bitset(&C, "C");
+    printf("Removing 0 from C again : %s\n", bitset_remove(&C, 0) == 0 ? "removed" : "not found");
+    printf("\n");
+
+    /* The buffer follows bit.h conventions, so bit.h functions can be used on it directly */
+    printf("--- Using bit.h on the Buffer ---\n");
+    bit_set(bitset_bits(&C), 50, 1);
+    printf("After bit_set(bits, 50, 1): cached size = %d, ", bitset_size(&C));
+    printf("recounted size = %d\n", bitset_count(&C));
+    print_bitset(&C, "C");
+    printf("\n");
+
+    /* Large universe */
+    BitSet D, E, DE;
+    bitset_init(&D, BIG_UNIVERSE);
+    bitset_init(&E, BIG_UNIVERSE);
+    insert_multiples(&D, 2);
+    insert_multiples(&E, 3);
+    clock_t start = clock();
+    bitset_intersection(&DE, &D, &E);
+    clock_t end = clock();
+    printf("--- Intersection over a Universe of %d ---\n", BIG_UNIVERSE);
+    printf("|D| = %d, |E| = %d, |DE| = %d (expected %d)\n", bitset_size(&D), bitset_size(&E), bitset_size(&DE), (BIG_UNIVERSE + 5) / 6);
+    printf("Time: %.1f us\n", 1e6 * (double)(end - start) / CLOCKS_PER_SEC);
+
+    /* Destroy the sets */
+    bitset_destroy(&A);
+    bitset_destroy(&B);
+    bitset_destroy(&C);
+    bitset_destroy(&AuB);
+    bitset_destroy(&AB);
+    bitset_destroy(&CA);
+    bitset_destroy(&D);
+    bitset_destroy(&E);
+    bitset_destroy(&DE);
+
+    return 0;
+}
+
+void insert_multiples(BitSet *set, int step)
+{
+    for(int i = 0; i < bitset_universe(set); i += step)
+        bitset_insert(set, i);
+}
+
+void print_bitset(BitSet *set, char *name)
+{
+    printf("Set %s:  Size = %d,  Contents = ", name, bitset_size(set));
+    for(int m = bitset_next(set, 0); m != -1; m = bitset_next(set, m + 1))
+        printf("%d  ", m);
+    printf("\n");
+}
@@ -0,0 +1,237 @@
+/* Testing the Bloom Filter Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "chtbl.h"
+#include "ohtbl.h"
+#include "bloom.h"
+
+#define KEYS 100000
+#define PROBES 1000000
+
+uint64_t mix(uint64_t x);
+uint64_t hash_int(const void *data);
+int h1_int(const void *key);
+int h2_int(const void *key);
+int match_int(const void *key1, const void *key2);
+double measured_rate(Bloom *bloom, int first, int n);
+
+/* Number of times a guarded table compared keys (i.e., was actually searched) */
+int matches = 0;
+
+/* Testing methods and macros
+    Methods:
+      - bloom_init()
+      - bloom_destroy()
+      - bloom_add()
+      - bloom_contains()
+      - bloom_add_n()
+      - bloom_contains_n()
+      - bloom_union()
+      - bloom_guard_chtbl()
+      - bloom_guard_ohtbl()
+      - bloom_guard_destroy()
+      - bloom_guard_insert()
+      - bloom_guard_remove()
+      - bloom_guard_lookup()
+    Macros:
+      - bloom_size()
+      - bloom_num_bits()
+      - bloom_hashes()
+      - bloom_guard_filter()
+*/
+int main()
+{
+    Bloom bloom, other;
+
+    printf("--- Initialization ---\n");
+    printf("Rate of 0 rejected? : %s\n", bloom_init(&bloom, BLOOM_STANDARD, KEYS, 0.0) == -1 ? "yes" : "no");
+    printf("Unknown kind rejected? : %s\n", bloom_init(&bloom, 7, KEYS, 0.01) == -1 ? "yes" : "no");
+
+    /* Hashes of the keys [0, KEYS), and of the keys [KEYS, 2 KEYS) for the union */
+    uint64_t *hashes = malloc(2 * KEYS * sizeof(uint64_t));
+    for(int i = 0; i < 2 * KEYS; i++)
+        hashes[i] = mix(i);
+
+    /* Both kinds at two rates: no false negatives, and false positives near what was asked for */
+    const char *names[] = {"standard", "blocked"};
+    double rates[] = {0.01, 0.001};
+    for(int kind = BLOOM_STANDARD; kind <= BLOOM_BLOCKED; kind++)
+    {
+        for(int r = 0; r < 2; r++)
+        {
+            printf("\n--- %s, %.1f%% for %d keys ---\n", names[kind], 100.0 * rates[r], KEYS);
+            bloom_init(&bloom, kind, KEYS, rates[r]);
+            printf("%d bits (%.1f per key), %d hashes\n", bloom_num_bits(&bloom), (double)bloom_num_bits(&bloom) / KEYS,
+                   bloom_hashes(&bloom));
+
+            for(int i = 0; i < KEYS; i++)
+                bloom_add(&bloom, hashes[i]);
+            int all = 1;
+            for(int i = 0; i < KEYS; i++)
+                all = all && bloom_contains(&bloom, hashes[i]);
+            printf("Size: %d, every key found? : %s\n", bloom_size(&bloom), all ? "yes" : "no");
+
+            double rate = measured_rate(&bloom, 10 * KEYS, PROBES);
+            printf("False positive rate %.3f%%, within 25%% of %.1f%%? : %s\n", 100.0 * rate, 100.0 * rates[r],
+                   rate < 1.25 * rates[r] ? "yes" : "no");
+
+            /* The batch methods agree with the single ones */
+            unsigned char *found = malloc(PROBES);
+            uint64_t *probes = malloc(PROBES * sizeof(uint64_t));
+            for(int i = 0; i < PROBES; i++)
+                probes[i] = mix(i + KEYS / 2);
+            int count = bloom_contains_n(&bloom, probes, PROBES, found), agree = 1, expected = 0;
+            for(int i = 0; i < PROBES; i++)
+            {
+                agree = agree && (found[i] == bloom_contains(&bloom, probes[i]));
+                expected += found[i];
+            }
+            printf("Batch query agrees with single queries? : %s\n", (agree && count == expected) ? "yes" : "no");
+
+            bloom_init(&other, kind, KEYS, rates[r]);
+            bloom_add_n(&other, hashes, KEYS);
+            printf("Batch add sets the same bits? : %s\n",
+                   memcmp(bloom.bits, other.bits, (bloom_num_bits(&bloom) + 7) / 8) == 0 ? "yes" : "no");
+            bloom_destroy(&other);
+
+            free(found);
+            free(probes);
+            bloom_destroy(&bloom);
+        }
+    }
+
+    /* Union: the filter of both halves is the filter of all the keys */
+    printf("\n--- Union ---\n");
+    Bloom both;
+    bloom_init(&bloom, BLOOM_BLOCKED, 2 * KEYS, 0.01);
+    bloom_init(&other, BLOOM_BLOCKED, 2 * KEYS, 0.01);
+    bloom_init(&both, BLOOM_BLOCKED, 2 * KEYS, 0.01);
+    bloom_add_n(&bloom, hashes, KEYS);
+    bloom_add_n(&other, hashes + KEYS, KEYS);
+    bloom_add_n(&both, hashes, 2 * KEYS);
+    bloom_union(&bloom, &other);
+    printf("Union matches one filter of every key? : %s\n",
+           memcmp(bloom.bits, both.bits, bloom_num_bits(&both) / 8) == 0 && bloom_size(&bloom) == 2 * KEYS ? "yes" : "no");
+    bloom_destroy(&other);
+    bloom_init(&other, BLOOM_STANDARD, 2 * KEYS, 0.01);
+    printf("Union with a different filter rejected? : %s\n", bloom_union(&bloom, &other) == -1 ? "yes" : "no");
+    bloom_destroy(&other);
+    bloom_destroy(&both);
+    bloom_destroy(&bloom);
+
+    /* Guarding tables: misses the filter rules out never reach the table */
+    int *values = malloc(2 * KEYS * sizeof(int)), *data;
+    for(int i = 0; i < 2 * KEYS; i++)
+        values[i] = i;
+
+    for(int t = 0; t < 2; t++)
+    {
+        CHTbl chtbl;
+        OHTbl ohtbl;
+        BloomGuard guard;
+
+        printf("\n--- Guarded %s ---\n", t ? "OHTbl" : "CHTbl");
+        if(t == 0)
+            chtbl_init(&chtbl, 1699, h1_int, match_int, NULL);
+        else
+            ohtbl_init(&ohtbl, 2 * KEYS + 3, h1_int, h2_int, match_int, NULL);
+
+        /* Half the elements before the guard, half through it */
+        for(int i = 0; i < KEYS / 2; i++)
+        {
+            if(t == 0)
+                chtbl_insert(&chtbl, &values[i]);
+            else
+                ohtbl_insert(&ohtbl, &values[i]);
+        }
+        if(t == 0)
+            bloom_guard_chtbl(&guard, &chtbl, hash_int, BLOOM_BLOCKED, KEYS, 0.01);
+        else
+            bloom_guard_ohtbl(&guard, &ohtbl, hash_int, BLOOM_BLOCKED, KEYS, 0.01);
+        printf("Elements already in the table added to the filter: %d\n", bloom_size(bloom_guard_filter(&guard)));
+        for(int i = KEYS / 2; i < KEYS; i++)
+            bloom_guard_insert(&guard, &values[i]);
+        printf("Inserting an element twice returns 1? : %s\n", bloom_guard_insert(&guard, &values[7]) == 1 ? "yes" : "no");
+
+        int all = 1;
+        for(int i = 0; i < KEYS; i++)
+        {
+            data = &values[i];
+            all = all && (bloom_guard_lookup(&guard, (void **)&data) == 0) && (data == &values[i]);
+        }
+        printf("Every element found? : %s\n", all ? "yes" : "no");
+
+        /* Misses: only the filter's false positives should search the table */
+        int reached = 0, none = 1;
+        for(int i = KEYS; i < 2 * KEYS; i++)
+        {
+            int before = matches;
+            data = &values[i];
+            none = none && (bloom_guard_lookup(&guard, (void **)&data) == -1);
+            reached += (matches != before);
+        }
+        printf("No absent element found? : %s\n", none ? "yes" : "no");
+        printf("Absent lookups that searched the table: %d of %d (%s 2%%)\n", reached, KEYS, reached < KEYS / 50 ? "under" : "over");
+
+        /* Removal goes through to the table; the filter keeps the bits */
+        data = &values[3];
+        printf("Remove an element? : %s\n", bloom_guard_remove(&guard, (void **)&data) == 0 ? "yes" : "no");
+        data = &values[3];
+        printf("Removed element no longer found? : %s\n", bloom_guard_lookup(&guard, (void **)&data) == -1 ? "yes" : "no");
+
+        bloom_guard_destroy(&guard);
+        if(t == 0)
+            chtbl_destroy(&chtbl);
+        else
+            ohtbl_destroy(&ohtbl);
+    }
+
+    free(values);
+    free(hashes);
+
+    return 0;
+}
+
+
+/* A 64-bit hash of an integer (splitmix64) */
+uint64_t mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t hash_int(const void *data)
+{
+    return mix(*(const int *)data);
+}
+
+int h1_int(const void *key)
+{
+    return (int)(mix(*(const int *)key) & 0x7fffffff);
+}
+
+int h2_int(const void *key)
+{
+    return 1 + (int)((mix(*(const int *)key) >> 32) % 1021);
+}
+
+int match_int(const void *key1, const void *key2)
+{
+    matches++;
+    return *(const int *)key1 == *(const int *)key2;
+}
+
+
+/* Fraction of the keys [first, first + n), none of them added, that the filter claims */
+double measured_rate(Bloom *bloom, int first, int n)
+{
+    int claimed = 0;
+    for(int i = 0; i < n; i++)
+        claimed += bloom_contains(bloom, mix(first + i));
+    return (double)claimed / n;
+}
@@ -0,0 +1,129 @@
+/* Testing the Set Covering Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bitset.h"
+#include "cover.h"
+
+#define UNIVERSE 5000
+#define SUBSETS 2000
+
+int eager_cover(const BitSet *members, const BitSet *subsets, int count, int *covering, int *size);
+void print_covering(const BitSet *subsets, int *covering, int size);
+
+int main()
+{
+    /* Example from data_structures/examples/cover.c: S = {1,2,3,4,5}, P = { {1,2,3}, {2,4}, {3,4}, {4,5} } */
+    int vals[4][3] = { {1, 2, 3}, {2, 4, 0}, {3, 4, 0}, {4, 5, 0} };
+    BitSet S, P[4];
+    bitset_init(&S, 6);
+    for(int i = 1; i < 6; i++)
+        bitset_insert(&S, i);
+    for(int i = 0; i < 4; i++)
+    {
+        bitset_init(&P[i], 6);
+        for(int j = 0; j < 3 && vals[i][j] != 0; j++)
+            bitset_insert(&P[i], vals[i][j]);
+    }
+
+    int covering[SUBSETS], size;
+    printf("--- Small Example ---\n");
+    printf("Return value: %d\n", set_cover(&S, P, 4, covering, &size));
+    print_covering(P, covering, size);
+
+    /* Without {4,5}, member 5 cannot be covered */
+    printf("Without {4,5}: return value = %d\n", set_cover(&S, P, 3, covering, &size));
+    printf("\n");
+
+    /* Larger random instance -- Compare against the eager greedy algorithm */
+    BitSet members, *subsets = malloc(SUBSETS * sizeof(*subsets));
+    int *expected = malloc(SUBSETS * sizeof(*expected)), expected_size;
+    srand(time(NULL));
+    bitset_init(&members, UNIVERSE);
+    for(int i = 0; i < UNIVERSE; i++)
+        bitset_insert(&members, i);
+    for(int i = 0; i < SUBSETS; i++)
+    {
+        bitset_init(&subsets[i], UNIVERSE);
+        int picks = rand() % 40 + 1;
+        for(int j = 0; j < picks; j++)
+            bitset_insert(&subsets[i], rand() % UNIVERSE);
+    }
+
+    clock_t start = clock();
+    int lazy_ret = set_cover(&members, subsets, SUBSETS, covering, &size);
+    clock_t mid = clock();
+    int eager_ret = eager_cover(&members, subsets, SUBSETS, expected, &expected_size);
+    clock_t end = clock();
+
+    int same = (lazy_ret == eager_ret) && (size == expected_size);
+    for(int i = 0; same && i < size; i++)
+        same = (covering[i] == expected[i]);
+
+    printf("--- Random Instance (%d members, %d subsets) ---\n", UNIVERSE, SUBSETS);
+    printf("Lazy greedy:  return value = %d, %d subsets picked, %.2f ms\n", lazy_ret, size, 1e3 * (mid - start) / CLOCKS_PER_SEC);
+    printf("Eager greedy: return value = %d, %d subsets picked, %.2f ms\n", eager_ret, expected_size, 1e3 * (end - mid) / CLOCKS_PER_SEC);
+    printf("Same picks in the same order? : %s\n", same ? "yes" : "no");
+
+    /* Cleanup */
+    bitset_destroy(&S);
+    for(int i = 0; i < 4; i++)
+        bitset_destroy(&P[i]);
+    bitset_destroy(&members);
+    for(int i = 0; i < SUBSETS; i++)
+        bitset_destroy(&subsets[i]);
+    free(subsets);
+    free(expected);
+
+    return 0;
+}
+
+/* Eager greedy covering -- Recompute every gain each round and pick the first largest (as in data_structures/examples/cover.c) */
+int eager_cover(const BitSet *members, const BitSet *subsets, int count, int *covering, int *size)
+{
+    BitSet uncovered, remaining;
+    char *used = calloc(count, 1);
+    bitset_union(&uncovered, members, members);
+    *size = 0;
+
+    while(bitset_size(&uncovered) > 0)
+    {
+        int best = -1, best_gain = 0;
+        for(int i = 0; i < count; i++)
+        {
+            int gain = used[i] ? 0 : bitset_intersection_count(&subsets[i], &uncovered);
+            if(gain > best_gain)
+            {
+                best = i;
+                best_gain = gain;
+            }
+        }
+        if(best == -1)
+            break;
+
+        used[best] = 1;
+        covering[(*size)++] = best;
+        bitset_difference(&remaining, &uncovered, &subsets[best]);
+        bitset_destroy(&uncovered);
+        uncovered = remaining;
+    }
+
+    int retval = (bitset_size(&uncovered) > 0) ? 1 : 0;
+    bitset_destroy(&uncovered);
+    free(used);
+    return retval;
+}
+
+void print_covering(const BitSet *subsets, int *covering, int size)
+{
+    printf("Cover:  Size = %d,  Contents = ", size);
+    for(int i = 0; i < size; i++)
+    {
+        printf("{");
+        for(int m = bitset_next(&subsets[covering[i]], 0); m != -1; m = bitset_next(&subsets[covering[i]], m + 1))
+            printf("%d  ", m);
+        printf("}   ");
+    }
+    printf("\n");
+}
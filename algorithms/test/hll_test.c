@@ -0,0 +1,172 @@
+/* Testing the HyperLogLog Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "hll.h"
+
+#define PRECISION 14
+#define MAX_KEYS 2000000
+
+uint64_t *hash_range(int first, int n);
+int same_registers(Hll *a, Hll *b);
+
+/* Testing methods and macros
+    Methods:
+      - hll_init()
+      - hll_destroy()
+      - hll_hash()
+      - hll_add()
+      - hll_add_n()
+      - hll_count()
+      - hll_merge()
+    Macros:
+      - hll_precision()
+      - hll_is_sparse()
+      - hll_register()
+*/
+int main()
+{
+    Hll hll, other;
+
+    printf("--- Initialization ---\n");
+    printf("Precision 3 rejected? : %s\n", hll_init(&hll, 3) == -1 ? "yes" : "no");
+    printf("Precision 19 rejected? : %s\n", hll_init(&hll, 19) == -1 ? "yes" : "no");
+    hll_init(&hll, PRECISION);
+    printf("Precision %d: %d registers, %d bytes dense, starts sparse? : %s\n", hll_precision(&hll), 1 << PRECISION,
+           (1 << PRECISION) * 6 / 8, hll_is_sparse(&hll) ? "yes" : "no");
+    printf("Empty sketch counts 0? : %s\n", hll_count(&hll) == 0.0 ? "yes" : "no");
+
+    /* Sparse: small cardinalities come out nearly exact, and duplicates change nothing */
+    printf("\n--- Sparse ---\n");
+    uint64_t *hashes = hash_range(0, MAX_KEYS);
+    for(int i = 0; i < 1000; i++)
+        hll_add(&hll, hashes[i]);
+    double once = hll_count(&hll);
+    for(int i = 0; i < 1000; i++)
+        hll_add(&hll, hashes[i]);
+    printf("1000 keys: estimate %.1f, still sparse? : %s\n", once, hll_is_sparse(&hll) ? "yes" : "no");
+    printf("Within 0.1%%? : %s\n", fabs(once - 1000) < 1.0 ? "yes" : "no");
+    printf("Adding them again changes nothing? : %s\n", hll_count(&hll) == once ? "yes" : "no");
+    hll_destroy(&hll);
+
+    /* Across the whole range, through the switch to dense */
+    printf("\n--- Error by cardinality (p = %d, standard error %.2f%%) ---\n", PRECISION, 104.0 / sqrt(1 << PRECISION));
+    int sizes[] = {10, 100, 1000, 3000, 10000, 100000, 1000000, MAX_KEYS};
+    int within = 1;
+    hll_init(&hll, PRECISION);
+    int added = 0;
+    for(int s = 0; s < 8; s++)
+    {
+        hll_add_n(&hll, hashes + added, sizes[s] - added);
+        added = sizes[s];
+
+        double estimate = hll_count(&hll), error = (estimate - sizes[s]) / sizes[s];
+        printf("%8d keys: estimate %10.1f, error %+6.2f%% (%s)\n", sizes[s], estimate, 100.0 * error,
+               hll_is_sparse(&hll) ? "sparse" : "dense");
+        within = within && (fabs(error) < 4 * 1.04 / sqrt(1 << PRECISION));
+    }
+    printf("Every estimate within four standard errors? : %s\n", within ? "yes" : "no");
+
+    /* Batch and one at a time build the same registers */
+    hll_init(&other, PRECISION);
+    for(int i = 0; i < MAX_KEYS; i++)
+        hll_add(&other, hashes[i]);
+    printf("Batch add matches one at a time? : %s\n", same_registers(&hll, &other) ? "yes" : "no");
+    hll_destroy(&other);
+
+    /* Merging is exact: the union of two sketches is the sketch of the union */
+    printf("\n--- Merge ---\n");
+    Hll left, right, both;
+    int pairs[][2] = {{500, 400}, {500, 600000}, {600000, 500}, {600000, 900000}};
+    const char *kinds[] = {"sparse + sparse", "sparse + dense", "dense + sparse", "dense + dense"};
+    for(int c = 0; c < 4; c++)
+    {
+        /* Overlapping ranges: [0, a) and [a / 2, a / 2 + b) */
+        int a = pairs[c][0], b = pairs[c][1];
+        hll_init(&left, PRECISION);
+        hll_init(&right, PRECISION);
+        hll_init(&both, PRECISION);
+        hll_add_n(&left, hashes, a);
+        hll_add_n(&right, hashes + a / 2, b);
+        hll_add_n(&both, hashes, a);
+        hll_add_n(&both, hashes + a / 2, b);
+
+        hll_merge(&left, &right);
+        int exact = hll_is_sparse(&both) ? (hll_count(&left) == hll_count(&both)) : same_registers(&left, &both);
+        printf("%-16s: union of %d estimated %.1f, same as one sketch of it? : %s\n", kinds[c],
+               (a / 2 + b > a) ? a / 2 + b : a, hll_count(&left), exact ? "yes" : "no");
+
+        hll_destroy(&left);
+        hll_destroy(&right);
+        hll_destroy(&both);
+    }
+
+    /* Odd register counts exercise the merge's scalar tail after any vector steps */
+    int ok = 1;
+    for(int p = HLL_MIN_PRECISION; p <= 8; p++)
+    {
+        hll_init(&left, p);
+        hll_init(&right, p);
+        hll_add_n(&left, hashes, 5000);
+        hll_add_n(&right, hashes + 100000, 5000);
+
+        int *expected = malloc((1 << p) * sizeof(int));
+        for(int j = 0; j < (1 << p); j++)
+            expected[j] = (hll_register(&left, j) > hll_register(&right, j)) ? hll_register(&left, j) : hll_register(&right, j);
+        hll_merge(&left, &right);
+        for(int j = 0; j < (1 << p); j++)
+            ok = ok && (hll_register(&left, j) == (unsigned int)expected[j]);
+
+        free(expected);
+        hll_destroy(&left);
+        hll_destroy(&right);
+    }
+    printf("Register-wise maximum for precisions 4 to 8? : %s\n", ok ? "yes" : "no");
+
+    hll_init(&other, PRECISION + 1);
+    printf("Merge of different precisions rejected? : %s\n", hll_merge(&hll, &other) == -1 ? "yes" : "no");
+    hll_destroy(&other);
+    hll_destroy(&hll);
+
+    /* Hashing keys of any length */
+    printf("\n--- Hashing ---\n");
+    char *words[] = {"alpha", "beta", "gamma", "alpha", "a key longer than eight bytes", "beta"};
+    hll_init(&hll, PRECISION);
+    for(int i = 0; i < 6; i++)
+        hll_add(&hll, hll_hash(words[i], (int)strlen(words[i])));
+    printf("6 strings, 4 distinct: estimate %.1f\n", hll_count(&hll));
+    hll_destroy(&hll);
+
+    free(hashes);
+
+    return 0;
+}
+
+
+/* Hashes of the integers [first, first + n) */
+uint64_t *hash_range(int first, int n)
+{
+    uint64_t *hashes = malloc(n * sizeof(uint64_t));
+    for(int i = 0; i < n; i++)
+    {
+        int key = first + i;
+        hashes[i] = hll_hash(&key, sizeof(key));
+    }
+    return hashes;
+}
+
+
+/* Determine whether two dense sketches hold the same registers */
+int same_registers(Hll *a, Hll *b)
+{
+    if(hll_is_sparse(a) || hll_is_sparse(b))
+        return 0;
+
+    for(int j = 0; j < (1 << hll_precision(a)); j++)
+        if(hll_register(a, j) != hll_register(b, j))
+            return 0;
+    return 1;
+}
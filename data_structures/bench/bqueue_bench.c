@@ -0,0 +1,158 @@
+/* Benchmark Blocking Queue against a polled, mutex-protected Queue */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "queue.h"
+#include "bqueue.h"
+
+#define ITEMS 4000000
+#define CAPACITY 1024
+#define MAX_PRODUCERS 4
+
+/* Ways of handing items from producers to one consumer */
+enum Mode { POLLED, SINGLE, BATCH };
+
+/* Shared state for one benchmark run */
+typedef struct Run_ {
+    enum Mode mode;
+    int batch;                  /* Items drained per lock acquisition (BATCH only) */
+    Queue queue;                /* POLLED: unbounded Queue under mutex */
+    pthread_mutex_t mutex;
+    BQueue bqueue;              /* SINGLE and BATCH */
+} Run;
+
+/* One producer thread */
+typedef struct Producer_ {
+    Run *run;
+    int cpu;
+    long count;
+} Producer;
+
+void pin(int cpu);
+double now_ns(void);
+void *produce(void *arg);
+void consume(Run *run);
+double throughput(enum Mode mode, int batch, int producers);
+
+int main()
+{
+    printf("Online CPUs: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-10s %14s %14s %14s %14s\n", "producers", "polled Queue", "bqueue_pop", "batch of 16", "batch of 256");
+    printf("%-10s %14s %14s %14s %14s\n", "", "(Mitems/s)", "(Mitems/s)", "(Mitems/s)", "(Mitems/s)");
+    for(int producers = 1; producers <= MAX_PRODUCERS; producers *= 2)
+    {
+        printf("%-10d %14.1f %14.1f %14.1f %14.1f\n", producers,
+               throughput(POLLED, 1, producers), throughput(SINGLE, 1, producers),
+               throughput(BATCH, 16, producers), throughput(BATCH, 256, producers));
+    }
+
+    return 0;
+}
+
+/* Pin the calling thread to a CPU (wrapping around the online CPUs) */
+void pin(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % sysconf(_SC_NPROCESSORS_ONLN), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Push count items */
+void *produce(void *arg)
+{
+    Producer *producer = arg;
+    Run *run = producer->run;
+    pin(producer->cpu);
+
+    for(uintptr_t i = 1; i <= (uintptr_t)producer->count; i++)
+    {
+        if(run->mode == POLLED)
+        {
+            pthread_mutex_lock(&run->mutex);
+            queue_push(&run->queue, (void *)i);
+            pthread_mutex_unlock(&run->mutex);
+        }
+        else
+            bqueue_push(&run->bqueue, (void *)i, BQUEUE_FOREVER);
+    }
+
+    return NULL;
+}
+
+/* Take ITEMS items, the way each pipeline stage would */
+void consume(Run *run)
+{
+    void *batch[256], *data;
+    long taken = 0;
+    int popped;
+
+    while(taken < ITEMS)
+    {
+        switch(run->mode)
+        {
+        case POLLED:
+            /* Lock round trip per item, and a yield whenever the queue is found empty */
+            pthread_mutex_lock(&run->mutex);
+            popped = (queue_pop(&run->queue, &data) == 0);
+            pthread_mutex_unlock(&run->mutex);
+            if(!popped)
+                sched_yield();
+            break;
+
+        case SINGLE:
+            popped = (bqueue_pop(&run->bqueue, &data, BQUEUE_FOREVER) == 0);
+            break;
+
+        default:
+            popped = bqueue_pop_batch(&run->bqueue, batch, run->batch, BQUEUE_FOREVER);
+            break;
+        }
+        taken += popped;
+    }
+}
+
+/* Move ITEMS items from the given number of producers to one consumer */
+double throughput(enum Mode mode, int batch, int producers)
+{
+    Run *run = malloc(sizeof(*run));
+    run->mode = mode;
+    run->batch = batch;
+    queue_init(&run->queue, NULL);
+    pthread_mutex_init(&run->mutex, NULL);
+    bqueue_init(&run->bqueue, CAPACITY, CAPACITY / 2, NULL);
+
+    pthread_t ids[MAX_PRODUCERS];
+    Producer args[MAX_PRODUCERS];
+    for(int i = 0; i < producers; i++)
+        args[i] = (Producer){run, i + 1, ITEMS / producers};
+
+    pin(0);
+    double start = now_ns();
+    for(int i = 0; i < producers; i++)
+        pthread_create(&ids[i], NULL, produce, &args[i]);
+    consume(run);
+    for(int i = 0; i < producers; i++)
+        pthread_join(ids[i], NULL);
+    double elapsed = now_ns() - start;
+
+    queue_destroy(&run->queue);
+    pthread_mutex_destroy(&run->mutex);
+    bqueue_destroy(&run->bqueue);
+    free(run);
+
+    return (double)ITEMS / elapsed * 1e3;
+}
@@ -0,0 +1,133 @@
+/* Benchmark Deque against Doubly-Linked List used as a deque */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dlist.h"
+#include "deque.h"
+
+#define ELEMENTS 2000000
+#define ROUNDS 10
+#define LOOKUPS 2000000
+
+double elapsed_ms(clock_t start, clock_t end);
+
+int main()
+{
+    int *values = malloc(ELEMENTS * sizeof(*values));
+    for(int i = 0; i < ELEMENTS; i++)
+        values[i] = i;
+
+    DList list;
+    Deque deque;
+    dlist_init(&list, NULL);
+    deque_init(&deque, NULL);
+    clock_t start, end;
+    long sum;
+    void *data;
+
+    printf("%-28s %12s %12s\n", "", "dlist (ms)", "deque (ms)");
+
+    /* Fill from both ends */
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i += 2)
+    {
+        dlist_insert_next(&list, dlist_tail(&list), &values[i]);
+        dlist_insert_prev(&list, dlist_head(&list), &values[i + 1]);
+    }
+    end = clock();
+    double list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i += 2)
+    {
+        deque_push_back(&deque, &values[i]);
+        deque_push_front(&deque, &values[i + 1]);
+    }
+    end = clock();
+    printf("%-28s %12.1f %12.1f\n", "push both ends", list_ms, elapsed_ms(start, end));
+
+    /* Sequential traversal */
+    sum = 0;
+    start = clock();
+    for(int r = 0; r < ROUNDS; r++)
+        for(DListElement *e = dlist_head(&list); e != NULL; e = dlist_next(e))
+            sum += *(int *)dlist_data(e);
+    end = clock();
+    list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int r = 0; r < ROUNDS; r++)
+        for(int b = 0; b < deque_blocks(&deque); b++)
+        {
+            void **block;
+            int count = deque_block(&deque, b, &block);
+            for(int j = 0; j < count; j++)
+                sum -= *(int *)block[j];
+        }
+    end = clock();
+    printf("%-28s %12.1f %12.1f   (checksum %s)\n", "traverse x10", list_ms, elapsed_ms(start, end), sum == 0 ? "ok" : "MISMATCH");
+
+    /* Rotate: pop one end, push the other, as a work queue does */
+    start = clock();
+    for(int r = 0; r < ROUNDS; r++)
+        for(int i = 0; i < ELEMENTS / ROUNDS; i++)
+        {
+            dlist_remove(&list, dlist_head(&list), &data);
+            dlist_insert_next(&list, dlist_tail(&list), data);
+        }
+    end = clock();
+    list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int r = 0; r < ROUNDS; r++)
+        for(int i = 0; i < ELEMENTS / ROUNDS; i++)
+        {
+            deque_pop_front(&deque, &data);
+            deque_push_back(&deque, data);
+        }
+    end = clock();
+    printf("%-28s %12.1f %12.1f\n", "rotate front to back", list_ms, elapsed_ms(start, end));
+
+    /* Random access has no list counterpart short of a walk */
+    sum = 0;
+    unsigned int index = 1;
+    start = clock();
+    for(int i = 0; i < LOOKUPS; i++)
+    {
+        index = index * 1103515245u + 12345u;
+        sum += *(int *)deque_item(&deque, (index >> 8) % ELEMENTS);
+    }
+    end = clock();
+    printf("%-28s %12s %12.1f   (sum %ld)\n", "random index x2M", "-", elapsed_ms(start, end), sum);
+
+    /* Drain from both ends */
+    start = clock();
+    while(dlist_size(&list) > 0)
+    {
+        dlist_remove(&list, dlist_head(&list), &data);
+        dlist_remove(&list, dlist_tail(&list), &data);
+    }
+    end = clock();
+    list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    while(deque_size(&deque) > 0)
+    {
+        deque_pop_front(&deque, &data);
+        deque_pop_back(&deque, &data);
+    }
+    end = clock();
+    printf("%-28s %12.1f %12.1f\n", "pop both ends until empty", list_ms, elapsed_ms(start, end));
+
+    dlist_destroy(&list);
+    deque_destroy(&deque);
+    free(values);
+
+    return 0;
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
@@ -0,0 +1,162 @@
+/* Benchmark Space-Saving and Count-Min Sketch against exact counting in a Chained Hash Table */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "chtbl.h"
+#include "list.h"
+#include "spacesaving.h"
+#include "cmsketch.h"
+
+#define STREAM 4000000
+#define DISTINCT 2000000
+#define BUCKETS 1048573
+#define TOP 10
+#define CAPACITY 1000
+
+/* What exact counting keeps per key */
+typedef struct Tally_ {
+    uint64_t key;
+    uint64_t count;
+} Tally;
+
+int tally_hash(const void *key);
+int tally_match(const void *key1, const void *key2);
+uint64_t next_key(uint64_t *state);
+double elapsed_ms(clock_t start, clock_t end);
+
+int main()
+{
+    /* A few heavy keys over a long tail of rare ones -- Keys are 64-bit hashes of flows, not small integers */
+    uint64_t *keys = malloc(STREAM * sizeof(uint64_t));
+    uint64_t state = 99;
+    for(int i = 0; i < STREAM; i++)
+        keys[i] = next_key(&state) * 0x9e3779b97f4a7c15ULL;
+
+    printf("%d keys, up to %d distinct, top %d\n", STREAM, DISTINCT, TOP);
+    printf("%-30s %10s %12s %10s\n", "", "time (ms)", "memory (KB)", "top right");
+
+    /* Today's approach: a CHTbl entry per key */
+    CHTbl table;
+    Tally *tallies = malloc(DISTINCT * sizeof(Tally)), *tally;
+    int used = 0;
+    chtbl_init(&table, BUCKETS, tally_hash, tally_match, NULL);
+    clock_t start = clock();
+    for(int i = 0; i < STREAM; i++)
+    {
+        Tally probe = {keys[i], 0};
+        tally = &probe;
+        if(chtbl_lookup(&table, (void **)&tally) == 0)
+            tally->count++;
+        else
+        {
+            tally = &tallies[used++];
+            tally->key = keys[i];
+            tally->count = 1;
+            chtbl_insert(&table, tally);
+        }
+    }
+    clock_t end = clock();
+
+    /* The true top keys, for scoring the others */
+    Tally exact[TOP] = {{0, 0}};
+    for(int i = 0; i < used; i++)
+    {
+        int j = TOP - 1;
+        if(tallies[i].count <= exact[j].count)
+            continue;
+        while(j > 0 && exact[j - 1].count < tallies[i].count)
+        {
+            exact[j] = exact[j - 1];
+            j--;
+        }
+        exact[j] = tallies[i];
+    }
+    size_t bytes = (size_t)used * (sizeof(Tally) + sizeof(ListElement)) + BUCKETS * sizeof(List);
+    printf("%-30s %10.1f %12zu %10s\n", "chtbl exact counts", elapsed_ms(start, end), bytes / 1024, "10/10");
+    chtbl_destroy(&table);
+    free(tallies);
+
+    /* Space-saving, one key at a time and in a batch */
+    SpaceSaving summary;
+    SSCounter top[TOP];
+    for(int batch = 0; batch < 2; batch++)
+    {
+        spacesaving_init(&summary, CAPACITY);
+        start = clock();
+        if(batch)
+            spacesaving_add_n(&summary, keys, NULL, STREAM);
+        else
+            for(int i = 0; i < STREAM; i++)
+                spacesaving_add(&summary, keys[i], 1);
+        spacesaving_top(&summary, top, TOP);
+        end = clock();
+
+        int right = 0;
+        for(int i = 0; i < TOP; i++)
+            for(int j = 0; j < TOP; j++)
+                right += (top[i].key == exact[j].key);
+        bytes = CAPACITY * (sizeof(SSCounter) + sizeof(int)) + (summary.index_mask + 1) * sizeof(int);
+        printf("%-30s %10.1f %12zu %7d/%d\n", batch ? "space-saving k=1000 (batch)" : "space-saving k=1000",
+               elapsed_ms(start, end), bytes / 1024, right, TOP);
+        spacesaving_destroy(&summary);
+    }
+
+    /* Count-min answers "how often was this key seen", not "which keys are top" -- Score it on the true top */
+    CMSketch sketch;
+    for(int batch = 0; batch < 2; batch++)
+    {
+        cmsketch_init(&sketch, 0.0001, 0.01);
+        start = clock();
+        if(batch)
+            cmsketch_add_n(&sketch, keys, NULL, STREAM);
+        else
+            for(int i = 0; i < STREAM; i++)
+                cmsketch_add(&sketch, keys[i], 1);
+        end = clock();
+
+        double worst = 0.0;
+        for(int i = 0; i < TOP; i++)
+        {
+            double over = (double)(cmsketch_estimate(&sketch, exact[i].key) - exact[i].count) / exact[i].count;
+            if(over > worst)
+                worst = over;
+        }
+        printf("%-30s %10.1f %12zu  max over %.2f%%\n", batch ? "count-min e=1e-4 (batch)" : "count-min e=1e-4",
+               elapsed_ms(start, end), cmsketch_bytes(&sketch) / 1024, 100.0 * worst);
+        cmsketch_destroy(&sketch);
+    }
+
+    free(keys);
+
+    return 0;
+}
+
+int tally_hash(const void *key)
+{
+    uint64_t k = ((const Tally *)key)->key;
+    return (int)((k ^ (k >> 32)) & 0x7fffffff);
+}
+
+int tally_match(const void *key1, const void *key2)
+{
+    return ((const Tally *)key1)->key == ((const Tally *)key2)->key;
+}
+
+/* One key in four from 100 heavy keys (the product of two uniform picks, so lower keys are heavier), the rest spread
+   thinly over the tail */
+uint64_t next_key(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t r = *state >> 24;
+
+    if(r % 4 == 0)
+        return (r >> 2) % 100 * ((r >> 9) % 100) / 100;
+    return 100 + (r >> 2) % (DISTINCT - 100);
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
@@ -0,0 +1,125 @@
+/* Benchmark Lock-Free Stack against a mutex-protected Stack */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hazard.h"
+#include "lfstack.h"
+#include "stack.h"
+
+#define OPERATIONS 4000000
+#define MAX_THREADS 8
+
+/* Shared state for one benchmark run */
+typedef struct Run_ {
+    int locked;                 /* Use the mutex-protected Stack instead of the lock-free stack */
+    int cpu;                    /* CPU to pin the thread to */
+    int pairs;                  /* Push/pop pairs this thread performs */
+    LFStack *lfstack;
+    Stack *stack;
+    pthread_mutex_t *mutex;
+} Run;
+
+void pin(int cpu);
+double now_ns(void);
+void *work(void *arg);
+double throughput(int locked, int threads);
+
+int main()
+{
+    printf("Online CPUs: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-10s %18s %18s\n", "threads", "mutex Stack", "lfstack");
+    printf("%-10s %18s %18s\n", "", "(Mops/s)", "(Mops/s)");
+    for(int threads = 1; threads <= MAX_THREADS; threads *= 2)
+        printf("%-10d %18.1f %18.1f\n", threads, throughput(1, threads), throughput(0, threads));
+
+    return 0;
+}
+
+/* Pin the calling thread to a CPU (wrapping around the online CPUs) */
+void pin(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % sysconf(_SC_NPROCESSORS_ONLN), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Push then pop, as an object-recycling free list would */
+void *work(void *arg)
+{
+    Run *run = arg;
+    HazardRecord *record = run->locked ? NULL : hazard_acquire(lfstack_domain(run->lfstack));
+    void *data;
+    pin(run->cpu);
+
+    for(uintptr_t i = 1; i <= (uintptr_t)run->pairs; i++)
+    {
+        if(run->locked)
+        {
+            pthread_mutex_lock(run->mutex);
+            stack_push(run->stack, (void *)i);
+            pthread_mutex_unlock(run->mutex);
+            pthread_mutex_lock(run->mutex);
+            stack_pop(run->stack, &data);
+            pthread_mutex_unlock(run->mutex);
+        }
+        else
+        {
+            lfstack_push(run->lfstack, (void *)i);
+            lfstack_pop(run->lfstack, record, &data);
+        }
+    }
+
+    if(record != NULL)
+        hazard_release(record);
+    return NULL;
+}
+
+/* Run OPERATIONS push/pop pairs split over the given number of threads */
+double throughput(int locked, int threads)
+{
+    LFStack *lfstack = aligned_alloc(LFSTACK_CACHE_LINE, sizeof(*lfstack));
+    Stack stack;
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    lfstack_init(lfstack, NULL);
+    stack_init(&stack, NULL);
+
+    /* Start from a non-empty stack so pops rarely find it empty */
+    for(uintptr_t i = 0; i < 64; i++)
+    {
+        lfstack_push(lfstack, (void *)i);
+        stack_push(&stack, (void *)i);
+    }
+
+    pthread_t ids[MAX_THREADS];
+    Run runs[MAX_THREADS];
+    for(int i = 0; i < threads; i++)
+        runs[i] = (Run){locked, i, OPERATIONS / threads, lfstack, &stack, &mutex};
+
+    double start = now_ns();
+    for(int i = 0; i < threads; i++)
+        pthread_create(&ids[i], NULL, work, &runs[i]);
+    for(int i = 0; i < threads; i++)
+        pthread_join(ids[i], NULL);
+    double elapsed = now_ns() - start;
+
+    lfstack_destroy(lfstack);
+    free(lfstack);
+    stack_destroy(&stack);
+
+    /* Each pair is two operations */
+    return 2.0 * (OPERATIONS / threads) * threads / elapsed * 1e3;
+}
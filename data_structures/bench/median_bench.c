@@ -0,0 +1,132 @@
+/* Benchmark Running Median against walking a Binary Search Tree (AVL) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bistree.h"
+#include "median.h"
+
+#define SAMPLES 200000
+#define READ_EVERY 1000
+#define LONG_STREAM 50000000
+
+int compare_double(const void *key1, const void *key2);
+double tree_median(BisTree *tree, BiTreeNode **stack);
+double elapsed_ms(clock_t start, clock_t end);
+
+int main()
+{
+    /* Distinct samples in random order, since a BisTree rejects duplicates */
+    double *values = malloc(SAMPLES * sizeof(double));
+    for(int i = 0; i < SAMPLES; i++)
+        values[i] = i;
+    srand(13);
+    for(int i = SAMPLES - 1; i > 0; i--)
+    {
+        int j = rand() % (i + 1);
+        double tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+
+    printf("%d samples, median read every %d\n", SAMPLES, READ_EVERY);
+    printf("%-28s %10s %12s\n", "", "time (ms)", "median");
+
+    /* Today's approach: insert into a BisTree and walk to the middle */
+    BisTree tree;
+    BiTreeNode **stack = malloc(64 * sizeof(BiTreeNode *));
+    double median = 0.0;
+    bistree_init(&tree, compare_double, NULL);
+    clock_t start = clock();
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        bistree_insert(&tree, &values[i]);
+        if((i + 1) % READ_EVERY == 0)
+            median = tree_median(&tree, stack);
+    }
+    clock_t end = clock();
+    printf("%-28s %10.1f %12.1f\n", "bistree in-order walk", elapsed_ms(start, end), median);
+    bistree_destroy(&tree);
+    free(stack);
+
+    Median running;
+    median_init(&running, MEDIAN_EXACT);
+    start = clock();
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        median_add(&running, values[i]);
+        if((i + 1) % READ_EVERY == 0)
+            median_get(&running, &median);
+    }
+    end = clock();
+    printf("%-28s %10.1f %12.1f\n", "median exact (two heaps)", elapsed_ms(start, end), median);
+    median_destroy(&running);
+
+    median_init(&running, MEDIAN_APPROX);
+    start = clock();
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        median_add(&running, values[i]);
+        if((i + 1) % READ_EVERY == 0)
+            median_get(&running, &median);
+    }
+    end = clock();
+    printf("%-28s %10.1f %12.1f\n", "median approximate (sketch)", elapsed_ms(start, end), median);
+    median_destroy(&running);
+
+    /* A long stream through the sketch, in batches */
+    QSketch sketch;
+    double p50, p99, p999;
+    qsketch_init(&sketch, MEDIAN_COMPRESSION);
+    start = clock();
+    for(long i = 0; i < LONG_STREAM; i += SAMPLES)
+        qsketch_add_n(&sketch, values, SAMPLES);
+    qsketch_quantile(&sketch, 0.5, &p50);
+    qsketch_quantile(&sketch, 0.99, &p99);
+    qsketch_quantile(&sketch, 0.999, &p999);
+    end = clock();
+    printf("\nSketch of %d samples: %.1f ms (%.1f ns/sample), %d centroids\n", LONG_STREAM, elapsed_ms(start, end),
+           elapsed_ms(start, end) * 1e6 / LONG_STREAM, sketch.centroids);
+    printf("p50 %.1f (exact %.1f), p99 %.1f (exact %.1f), p99.9 %.1f (exact %.1f)\n",
+           p50, (SAMPLES - 1) * 0.5, p99, (SAMPLES - 1) * 0.99, p999, (SAMPLES - 1) * 0.999);
+    qsketch_destroy(&sketch);
+
+    free(values);
+
+    return 0;
+}
+
+int compare_double(const void *key1, const void *key2)
+{
+    double a = *(const double *)key1, b = *(const double *)key2;
+    return (a > b) ? 1 : (a < b) ? -1 : 0;
+}
+
+/* Walk the tree in order up to its middle element (an AVL tree of 2^32 nodes is under 64 levels deep) */
+double tree_median(BisTree *tree, BiTreeNode **stack)
+{
+    int depth = 0, seen = 0, middle = (bistree_size(tree) - 1) / 2;
+    BiTreeNode *node = bitree_root(tree);
+
+    while(depth > 0 || node != NULL)
+    {
+        if(node != NULL)
+        {
+            stack[depth++] = node;
+            node = bitree_left(node);
+            continue;
+        }
+
+        node = stack[--depth];
+        if(seen++ == middle)
+            return *(double *)((AvlNode *)bitree_data(node))->data;
+        node = bitree_right(node);
+    }
+
+    return 0.0;
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
@@ -0,0 +1,148 @@
+/* Benchmark Multi-Producer/Multi-Consumer Queue against a mutex-protected Queue */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "mpmcq.h"
+#include "queue.h"
+
+#define ITEMS 4000000
+#define MAX_THREADS 8
+
+/* Shared state for one benchmark run */
+typedef struct Run_ {
+    int locked;                 /* Use the mutex-protected Queue instead of the MPMC queue */
+    int cpu;                    /* CPU to pin the thread to */
+    int count;                  /* Items this thread pushes or pops */
+    MPMCQueue *mpmc;
+    Queue *queue;
+    pthread_mutex_t *mutex;
+} Run;
+
+void pin(int cpu);
+double now_ns(void);
+void *produce(void *arg);
+void *consume(void *arg);
+double throughput(int locked, int pairs);
+
+int main()
+{
+    printf("Online CPUs: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-22s %16s %16s\n", "producer/consumer", "mutex Queue", "mpmcq");
+    printf("%-22s %16s %16s\n", "pairs", "(Mitems/s)", "(Mitems/s)");
+    for(int pairs = 1; pairs <= MAX_THREADS / 2; pairs *= 2)
+        printf("%-22d %16.1f %16.1f\n", pairs, throughput(1, pairs), throughput(0, pairs));
+
+    return 0;
+}
+
+/* Pin the calling thread to a CPU (wrapping around the online CPUs) */
+void pin(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % sysconf(_SC_NPROCESSORS_ONLN), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Producer -- The mutex variant yields when it finds the queue full, like a blocking push would sleep */
+void *produce(void *arg)
+{
+    Run *run = arg;
+    pin(run->cpu);
+
+    for(uintptr_t i = 1; i <= (uintptr_t)run->count; i++)
+    {
+        if(!run->locked)
+        {
+            mpmcq_push(run->mpmc, (void *)i);
+            continue;
+        }
+
+        for(;;)
+        {
+            pthread_mutex_lock(run->mutex);
+            int full = (queue_size(run->queue) >= 4096);
+            if(!full)
+                queue_push(run->queue, (void *)i);
+            pthread_mutex_unlock(run->mutex);
+            if(!full)
+                break;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Consumer */
+void *consume(void *arg)
+{
+    Run *run = arg;
+    void *data;
+    pin(run->cpu);
+
+    for(int i = 0; i < run->count; i++)
+    {
+        if(!run->locked)
+        {
+            mpmcq_pop(run->mpmc, &data);
+            continue;
+        }
+
+        for(;;)
+        {
+            pthread_mutex_lock(run->mutex);
+            int got = (queue_pop(run->queue, &data) == 0);
+            pthread_mutex_unlock(run->mutex);
+            if(got)
+                break;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Move ITEMS pointers through the queue with the given number of producer/consumer pairs */
+double throughput(int locked, int pairs)
+{
+    MPMCQueue *mpmc = aligned_alloc(MPMCQ_CACHE_LINE, sizeof(*mpmc));
+    Queue queue;
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    mpmcq_init(mpmc, 4096);
+    queue_init(&queue, NULL);
+
+    pthread_t threads[MAX_THREADS];
+    Run runs[MAX_THREADS];
+    for(int i = 0; i < 2 * pairs; i++)
+        runs[i] = (Run){locked, i, ITEMS / pairs, mpmc, &queue, &mutex};
+
+    double start = now_ns();
+    for(int i = 0; i < pairs; i++)
+    {
+        pthread_create(&threads[2 * i], NULL, consume, &runs[2 * i]);
+        pthread_create(&threads[2 * i + 1], NULL, produce, &runs[2 * i + 1]);
+    }
+    for(int i = 0; i < 2 * pairs; i++)
+        pthread_join(threads[i], NULL);
+    double elapsed = now_ns() - start;
+
+    mpmcq_destroy(mpmc);
+    free(mpmc);
+    queue_destroy(&queue);
+
+    return (double)(ITEMS / pairs) * pairs / elapsed * 1e3;
+}
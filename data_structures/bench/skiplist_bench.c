@@ -0,0 +1,96 @@
+/* Benchmark Skip List against Binary Search Tree (AVL) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bistree.h"
+#include "skiplist.h"
+
+#define ELEMENTS 500000
+
+int compare_int(const void *key1, const void *key2);
+double elapsed_ms(clock_t start, clock_t end);
+
+int main()
+{
+    int *values = malloc(ELEMENTS * sizeof(*values));
+    for(int i = 0; i < ELEMENTS; i++)
+        values[i] = i;
+
+    /* Shuffle so both structures see the same random insert order */
+    srand(3);
+    for(int i = ELEMENTS - 1; i > 0; i--)
+    {
+        int j = rand() % (i + 1), tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+
+    BisTree tree;
+    SkipList list;
+    bistree_init(&tree, compare_int, NULL);
+    skiplist_init(&list, compare_int, NULL);
+    clock_t start, end;
+    double tree_ms;
+    int found = 0;
+    void *data;
+
+    printf("%-24s %12s %14s\n", "", "bistree (ms)", "skiplist (ms)");
+
+    /* Insert */
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i++)
+        bistree_insert(&tree, &values[i]);
+    end = clock();
+    tree_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i++)
+        skiplist_insert(&list, &values[i]);
+    end = clock();
+    printf("%-24s %12.1f %14.1f\n", "insert", tree_ms, elapsed_ms(start, end));
+
+    /* Lookup every element */
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i++)
+    {
+        data = &values[i];
+        found += (bistree_lookup(&tree, &data) == 0);
+    }
+    end = clock();
+    tree_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i++)
+    {
+        data = &values[i];
+        found -= (skiplist_lookup(&list, &data) == 0);
+    }
+    end = clock();
+    printf("%-24s %12.1f %14.1f   (%s)\n", "lookup", tree_ms, elapsed_ms(start, end), found == 0 ? "ok" : "MISMATCH");
+
+    /* In-order scan -- BisTree has no iterator, so only the skip list is timed */
+    long sum = 0;
+    start = clock();
+    for(SkipListNode *node = skiplist_first(&list); node != NULL; node = skiplist_next(node))
+        sum += *(int *)skiplist_data(node);
+    end = clock();
+    printf("%-24s %12s %14.1f   (sum %ld)\n", "in-order scan", "n/a", elapsed_ms(start, end), sum);
+
+    bistree_destroy(&tree);
+    skiplist_destroy(&list);
+    free(values);
+
+    return 0;
+}
+
+int compare_int(const void *key1, const void *key2)
+{
+    int a = *(const int *)key1, b = *(const int *)key2;
+    return (a > b) ? 1 : (a < b) ? -1 : 0;
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
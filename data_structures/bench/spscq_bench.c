@@ -0,0 +1,214 @@
+/* Benchmark Single-Producer/Single-Consumer Queue against a mutex-protected Queue */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "queue.h"
+#include "spscq.h"
+
+#define ITEMS 10000000
+#define ROUND_TRIPS 200000
+#define BATCH 64
+
+/* Shared state for one benchmark run */
+typedef struct Run_ {
+    int mode;                   /* 0 = SPSC single, 1 = SPSC batch, 2 = mutex Queue */
+    int cpu;                    /* CPU to pin the thread to */
+    SPSCQueue *spsc;
+    SPSCQueue *reply;
+    Queue *locked;
+    pthread_mutex_t *mutex;
+} Run;
+
+void pin(int cpu);
+double now_ns(void);
+void *produce(void *arg);
+void *consume(void *arg);
+void *echo(void *arg);
+double throughput(int mode);
+double latency(void);
+
+int main()
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("Online CPUs: %ld%s\n", cpus, cpus < 2 ? " (producer and consumer share a CPU -- expect yield-bound numbers)" : "");
+    printf("%-26s %14s\n", "throughput", "Mitems/s");
+    printf("%-26s %14.1f\n", "mutex Queue", throughput(2));
+    printf("%-26s %14.1f\n", "spscq push/pop", throughput(0));
+    printf("%-26s %14.1f\n", "spscq push_n/pop_n (64)", throughput(1));
+    printf("%-26s %14.0f\n", "round trip latency (ns)", latency());
+
+    return 0;
+}
+
+/* Pin the calling thread to a CPU (wrapping around the online CPUs) */
+void pin(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % sysconf(_SC_NPROCESSORS_ONLN), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Producer side of the throughput test */
+void *produce(void *arg)
+{
+    Run *run = arg;
+    void *batch[BATCH];
+    pin(run->cpu);
+
+    for(uintptr_t i = 1; i <= ITEMS; )
+    {
+        int sent = 0;
+        if(run->mode == 0)
+        {
+            sent = (spscq_push(run->spsc, (void *)i) == 0);
+        }
+        else if(run->mode == 1)
+        {
+            int n = 0;
+            for(; n < BATCH && i + n <= ITEMS; n++)
+                batch[n] = (void *)(i + n);
+            sent = spscq_push_n(run->spsc, batch, n);
+        }
+        else
+        {
+            pthread_mutex_lock(run->mutex);
+            sent = (queue_push(run->locked, (void *)i) == 0);
+            pthread_mutex_unlock(run->mutex);
+        }
+
+        i += sent;
+        if(sent == 0)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+/* Consumer side of the throughput test */
+void *consume(void *arg)
+{
+    Run *run = arg;
+    void *batch[BATCH];
+    uintptr_t received = 0, sum = 0;
+    pin(run->cpu);
+
+    while(received < ITEMS)
+    {
+        int got = 0;
+        if(run->mode == 0)
+        {
+            got = (spscq_pop(run->spsc, &batch[0]) == 0);
+        }
+        else if(run->mode == 1)
+        {
+            got = spscq_pop_n(run->spsc, batch, BATCH);
+        }
+        else
+        {
+            pthread_mutex_lock(run->mutex);
+            got = (queue_pop(run->locked, &batch[0]) == 0);
+            pthread_mutex_unlock(run->mutex);
+        }
+
+        for(int i = 0; i < got; i++)
+            sum += (uintptr_t)batch[i];
+        received += got;
+        if(got == 0)
+            sched_yield();
+    }
+
+    return (void *)sum;
+}
+
+/* Transfer ITEMS pointers between two pinned threads and return millions of items per second */
+double throughput(int mode)
+{
+    SPSCQueue *spsc = aligned_alloc(SPSCQ_CACHE_LINE, sizeof(*spsc));
+    Queue locked;
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    spscq_init(spsc, 4096);
+    queue_init(&locked, NULL);
+
+    Run producer = {mode, 0, spsc, NULL, &locked, &mutex}, consumer = {mode, 1, spsc, NULL, &locked, &mutex};
+    pthread_t prod, cons;
+    uintptr_t sum;
+
+    double start = now_ns();
+    pthread_create(&cons, NULL, consume, &consumer);
+    pthread_create(&prod, NULL, produce, &producer);
+    pthread_join(prod, NULL);
+    pthread_join(cons, (void **)&sum);
+    double elapsed = now_ns() - start;
+
+    if(sum != (uintptr_t)ITEMS * (ITEMS + 1) / 2)
+        printf("checksum mismatch in mode %d\n", mode);
+
+    spscq_destroy(spsc);
+    free(spsc);
+    queue_destroy(&locked);
+
+    return ITEMS / elapsed * 1e3;
+}
+
+/* Echo every message back on the reply queue */
+void *echo(void *arg)
+{
+    Run *run = arg;
+    void *data;
+    pin(run->cpu);
+
+    for(int i = 0; i < ROUND_TRIPS; i++)
+    {
+        while(spscq_pop(run->spsc, &data) != 0)
+            sched_yield();
+        while(spscq_push(run->reply, data) != 0)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+/* Ping-pong a message between two pinned threads and return the mean round trip in nanoseconds */
+double latency(void)
+{
+    SPSCQueue *ping = aligned_alloc(SPSCQ_CACHE_LINE, sizeof(*ping)), *pong = aligned_alloc(SPSCQ_CACHE_LINE, sizeof(*pong));
+    spscq_init(ping, 64);
+    spscq_init(pong, 64);
+
+    Run run = {0, 1, ping, pong, NULL, NULL};
+    pthread_t thread;
+    void *data;
+    pthread_create(&thread, NULL, echo, &run);
+    pin(0);
+
+    double start = now_ns();
+    for(uintptr_t i = 0; i < ROUND_TRIPS; i++)
+    {
+        spscq_push(ping, (void *)i);
+        while(spscq_pop(pong, &data) != 0)
+            sched_yield();
+    }
+    double elapsed = now_ns() - start;
+
+    pthread_join(thread, NULL);
+    spscq_destroy(ping);
+    spscq_destroy(pong);
+    free(ping);
+    free(pong);
+
+    return elapsed / ROUND_TRIPS;
+}
@@ -0,0 +1,92 @@
+/* Benchmark Sliding Window against rescanning a Doubly-Linked List window */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dlist.h"
+#include "swindow.h"
+
+#define SAMPLES 1000000
+#define BATCH 256
+
+double elapsed_ms(clock_t start, clock_t end);
+
+int main()
+{
+    double *values = malloc(SAMPLES * sizeof(double));
+    srand(9);
+    for(int i = 0; i < SAMPLES; i++)
+        values[i] = rand() / (double)RAND_MAX;
+
+    printf("%d samples, min/max/sum read after every sample (batch: after every %d)\n", SAMPLES, BATCH);
+    printf("%-10s %14s %14s %14s\n", "window", "dlist rescan", "swindow", "swindow batch");
+    printf("%-10s %14s %14s %14s\n", "", "(ms)", "(ms)", "(ms)");
+
+    for(int span = 10; span <= 1000; span *= 10)
+    {
+        double check = 0, min, max;
+        void *data;
+
+        /* Today's approach: keep the window in a DList and rescan it */
+        DList list;
+        dlist_init(&list, NULL);
+        clock_t start = clock();
+        for(int i = 0; i < SAMPLES; i++)
+        {
+            if(dlist_size(&list) == span)
+                dlist_remove(&list, dlist_head(&list), &data);
+            dlist_insert_next(&list, dlist_tail(&list), &values[i]);
+
+            double sum = 0;
+            min = max = values[i];
+            for(DListElement *e = dlist_head(&list); e != NULL; e = dlist_next(e))
+            {
+                double v = *(double *)dlist_data(e);
+                min = (v < min) ? v : min;
+                max = (v > max) ? v : max;
+                sum += v;
+            }
+            check += min + max + sum;
+        }
+        clock_t end = clock();
+        double list_ms = elapsed_ms(start, end);
+        dlist_destroy(&list);
+
+        SWindow window;
+        swindow_init(&window, SWINDOW_COUNT, span);
+        start = clock();
+        for(int i = 0; i < SAMPLES; i++)
+        {
+            swindow_add(&window, 0, values[i]);
+            swindow_min(&window, &min);
+            swindow_max(&window, &max);
+            check -= min + max + swindow_sum(&window);
+        }
+        end = clock();
+        double window_ms = elapsed_ms(start, end);
+        swindow_destroy(&window);
+
+        swindow_init(&window, SWINDOW_COUNT, span);
+        start = clock();
+        for(int i = 0; i < SAMPLES; i += BATCH)
+        {
+            swindow_add_n(&window, NULL, &values[i], (SAMPLES - i < BATCH) ? SAMPLES - i : BATCH);
+            swindow_min(&window, &min);
+            swindow_max(&window, &max);
+        }
+        end = clock();
+        swindow_destroy(&window);
+
+        printf("%-10d %14.1f %14.1f %14.1f   (checksum %s)\n", span, list_ms, window_ms, elapsed_ms(start, end),
+               (check < 1e-3 && check > -1e-3) ? "ok" : "MISMATCH");
+    }
+
+    free(values);
+
+    return 0;
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
@@ -0,0 +1,122 @@
+/* Benchmark Timer Wheel against Priority Queue for connection timeouts */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "pqueue.h"
+#include "twheel.h"
+
+#define TIMERS 1000000
+#define MAX_DELAY 100000
+#define STEP 100
+
+/* Connection timeout, as a PQueue element */
+typedef struct Timeout_ {
+    uint64_t expires;
+    int cancelled;          /* PQueue cannot remove an arbitrary element, so cancelled timeouts are skipped when they surface */
+} Timeout;
+
+long expired = 0;
+
+double elapsed_ms(clock_t start, clock_t end);
+int earlier(const void *key1, const void *key2);
+void on_expire(void *arg);
+void run(int cancel_percent);
+
+int main()
+{
+    printf("%d timeouts, delays up to %d ticks, advancing %d ticks at a time\n", TIMERS, MAX_DELAY, STEP);
+    printf("%-12s %14s %14s %14s %14s\n", "cancelled", "pqueue sched", "twheel sched", "pqueue total", "twheel total");
+    printf("%-12s %14s %14s %14s %14s\n", "", "(ms)", "(ms)", "(ms)", "(ms)");
+    run(0);
+    run(50);
+    run(90);
+
+    return 0;
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
+
+/* Earliest expiry has the highest priority */
+int earlier(const void *key1, const void *key2)
+{
+    uint64_t a = ((const Timeout *)key1)->expires, b = ((const Timeout *)key2)->expires;
+    return (a < b) ? 1 : (a > b) ? -1 : 0;
+}
+
+void on_expire(void *arg)
+{
+    (void)arg;
+    expired++;
+}
+
+/* Schedule every timeout, cancel a share of them, then run the clock until all have expired */
+void run(int cancel_percent)
+{
+    Timeout *timeouts = malloc(TIMERS * sizeof(Timeout));
+    TWheelTimer **timers = malloc(TIMERS * sizeof(TWheelTimer *));
+    uint64_t *delays = malloc(TIMERS * sizeof(uint64_t));
+    srand(3);
+    for(int i = 0; i < TIMERS; i++)
+        delays[i] = 1 + rand() % MAX_DELAY;
+
+    /* Priority queue */
+    PQueue pqueue;
+    pqueue_init(&pqueue, earlier, NULL);
+    clock_t start = clock();
+    for(int i = 0; i < TIMERS; i++)
+    {
+        timeouts[i] = (Timeout){delays[i], 0};
+        pqueue_insert(&pqueue, &timeouts[i]);
+    }
+    clock_t scheduled = clock();
+    for(int i = 0; i < TIMERS; i++)
+        if(i % 100 < cancel_percent)
+            timeouts[i].cancelled = 1;
+
+    long pqueue_expired = 0;
+    for(uint64_t now = 0; pqueue_size(&pqueue) > 0; now += STEP)
+    {
+        Timeout *top;
+        while(pqueue_size(&pqueue) > 0 && ((Timeout *)pqueue_peek(&pqueue))->expires <= now)
+        {
+            pqueue_extract(&pqueue, (void **)&top);
+            if(!top->cancelled)
+                pqueue_expired++;
+        }
+    }
+    clock_t end = clock();
+    double pqueue_schedule = elapsed_ms(start, scheduled), pqueue_total = elapsed_ms(start, end);
+    pqueue_destroy(&pqueue);
+
+    /* Timer wheel */
+    TWheel *wheel = malloc(sizeof(TWheel));
+    twheel_init(wheel, 0);
+    expired = 0;
+    start = clock();
+    for(int i = 0; i < TIMERS; i++)
+        timers[i] = twheel_schedule(wheel, delays[i], on_expire, NULL);
+    scheduled = clock();
+    for(int i = 0; i < TIMERS; i++)
+        if(i % 100 < cancel_percent)
+            twheel_cancel(wheel, timers[i]);
+
+    while(twheel_pending(wheel) > 0)
+        twheel_advance(wheel, STEP);
+    end = clock();
+
+    char label[16];
+    snprintf(label, sizeof(label), "%d%%", cancel_percent);
+    printf("%-12s %14.1f %14.1f %14.1f %14.1f%s\n", label, pqueue_schedule, elapsed_ms(start, scheduled),
+           pqueue_total, elapsed_ms(start, end), (expired == pqueue_expired) ? "" : "   (expiry count MISMATCH)");
+
+    twheel_destroy(wheel);
+    free(wheel);
+    free(timeouts);
+    free(timers);
+    free(delays);
+}
@@ -0,0 +1,102 @@
+/* Benchmark Unrolled Linked List against Linked List */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "list.h"
+#include "ulist.h"
+
+#define ELEMENTS 2000000
+#define SCANS 10
+#define MIDDLE 2000
+
+double elapsed_ms(clock_t start, clock_t end);
+
+int main()
+{
+    int *values = malloc(ELEMENTS * sizeof(*values));
+    for(int i = 0; i < ELEMENTS; i++)
+        values[i] = i;
+
+    List list;
+    UList ulist;
+    list_init(&list, NULL);
+    ulist_init(&ulist, NULL);
+    clock_t start, end;
+    long sum;
+    void *data;
+
+    printf("%-28s %12s %12s\n", "", "list (ms)", "ulist (ms)");
+
+    /* Append every element */
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i++)
+        list_insert_next(&list, list_tail(&list), &values[i]);
+    end = clock();
+    double list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int i = 0; i < ELEMENTS; i++)
+        ulist_append(&ulist, &values[i]);
+    end = clock();
+    printf("%-28s %12.1f %12.1f\n", "append", list_ms, elapsed_ms(start, end));
+
+    /* Sequential traversal */
+    sum = 0;
+    start = clock();
+    for(int s = 0; s < SCANS; s++)
+        for(ListElement *e = list_head(&list); e != NULL; e = list_next(e))
+            sum += *(int *)list_data(e);
+    end = clock();
+    list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int s = 0; s < SCANS; s++)
+        for(UListNode *n = ulist_head(&ulist); n != NULL; n = ulist_next(n))
+            for(int i = 0; i < ulist_count(n); i++)
+                sum -= *(int *)ulist_data(n, i);
+    end = clock();
+    printf("%-28s %12.1f %12.1f   (checksum %s)\n", "traverse x10", list_ms, elapsed_ms(start, end), sum == 0 ? "ok" : "MISMATCH");
+
+    /* Insert in the middle -- Both must walk to the position */
+    start = clock();
+    for(int i = 0; i < MIDDLE; i++)
+    {
+        ListElement *e = list_head(&list);
+        for(int j = 0; j < ELEMENTS / 2; j++)
+            e = list_next(e);
+        list_insert_next(&list, e, &values[i]);
+    }
+    end = clock();
+    list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    for(int i = 0; i < MIDDLE; i++)
+        ulist_insert(&ulist, ELEMENTS / 2 + 1, &values[i]);
+    end = clock();
+    printf("%-28s %12.1f %12.1f\n", "insert middle x2000", list_ms, elapsed_ms(start, end));
+
+    /* Remove from the head until empty */
+    start = clock();
+    while(list_size(&list) > 0)
+        list_remove_next(&list, NULL, &data);
+    end = clock();
+    list_ms = elapsed_ms(start, end);
+
+    start = clock();
+    while(ulist_size(&ulist) > 0)
+        ulist_remove(&ulist, 0, &data);
+    end = clock();
+    printf("%-28s %12.1f %12.1f\n", "remove head until empty", list_ms, elapsed_ms(start, end));
+
+    list_destroy(&list);
+    ulist_destroy(&ulist);
+    free(values);
+
+    return 0;
+}
+
+double elapsed_ms(clock_t start, clock_t end)
+{
+    return 1e3 * (end - start) / CLOCKS_PER_SEC;
+}
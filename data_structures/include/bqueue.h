@@ -0,0 +1,159 @@
+/* Header for Blocking Queue */
+#ifndef BQUEUE_H
+#define BQUEUE_H
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "queue.h"
+
+/* Purpose:
+     - Bounded producer/consumer queue for pipeline stages, built on the ring buffer Queue (see queue.h) and one mutex
+     - Consumers sleep on a condition variable instead of polling, and bqueue_pop_batch() drains many items per lock acquisition
+     - Backpressure with hysteresis: once the queue reaches its high watermark, producers block until consumers
+       drain it down to the low watermark, so a slow stage throttles its producers in bursts rather than per item
+     - bqueue_close() stops further pushes and wakes everyone -- Consumers still drain what is left before seeing the close
+*/
+
+
+/*
+********************************************
+        Queue Definition
+********************************************
+*/
+
+/* Timeout value meaning wait as long as it takes */
+#define BQUEUE_FOREVER -1
+
+
+/* Struct representing blocking queue */
+typedef struct BQueue_ {
+    Queue queue;                /* Elements, front first */
+
+    int high_watermark;         /* Size at which producers start blocking (the capacity of the queue) */
+    int low_watermark;          /* Size at which blocked producers are released */
+    int throttled;              /* Nonzero from reaching the high watermark until draining to the low watermark */
+    int closed;                 /* Nonzero once bqueue_close() has been called */
+    int pop_waiters;            /* Consumers sleeping on not_empty -- Pushes only signal when there are some */
+    int push_waiters;           /* Producers sleeping on not_full */
+
+    pthread_mutex_t mutex;      /* Guards every field above */
+    pthread_cond_t not_empty;   /* Signaled when elements arrive (or on close) */
+    pthread_cond_t not_full;    /* Broadcast when the throttle lifts (or on close) */
+} BQueue;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a blocking queue
+    @param queue           The allocated BQueue structure
+    @param high_watermark  Maximum number of elements -- Producers block once the queue holds this many
+    @param low_watermark   Producers blocked at the high watermark resume once the queue drains to this many
+    @param destroy         Pointer to function that will be used for deallocation
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must be called before the queue is shared between threads
+      - Requires 0 <= low_watermark < high_watermark
+      - If queue contains data that should not be freed, set destroy to NULL
+      - Complexity: O(high_watermark)
+*/
+int bqueue_init(BQueue *queue, int high_watermark, int low_watermark, void (*destroy)(void *data));
+
+
+/* Destroy a blocking queue
+    @param queue  The queue to be destroyed
+
+    Notes:
+      - Calls the function passed as destroy to bqueue_init() once for each remaining element
+      - Must not be called while any thread may still use the queue
+      - Complexity: O(n)
+*/
+void bqueue_destroy(BQueue *queue);
+
+
+/* Push an element, blocking while the queue is throttled
+    @param queue       The BQueue structure
+    @param data        The data to be pushed
+    @param timeout_ms  Milliseconds to wait for room (0 to not wait, BQUEUE_FOREVER to wait indefinitely)
+
+    @return 0 if pushed, 1 if the timeout expired, -1 if the queue is closed (or on error)
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1)
+*/
+int bqueue_push(BQueue *queue, const void *data, int timeout_ms);
+
+
+/* Pop an element, blocking while the queue is empty
+    @param queue       The BQueue structure
+    @param data        The data of the popped element
+    @param timeout_ms  Milliseconds to wait for an element (0 to not wait, BQUEUE_FOREVER to wait indefinitely)
+
+    @return 0 if popped, 1 if the timeout expired, -1 if the queue is closed and empty
+
+    Notes:
+      - Upon return, data points to the data of the popped element
+      - Complexity: O(1)
+*/
+int bqueue_pop(BQueue *queue, void **data, int timeout_ms);
+
+
+/* Pop up to max_n elements under a single lock acquisition, blocking while the queue is empty
+    @param queue       The BQueue structure
+    @param data        Array receiving the popped data, front of the queue first
+    @param max_n       The maximum number of elements to pop
+    @param timeout_ms  Milliseconds to wait for the first element (0 to not wait, BQUEUE_FOREVER to wait indefinitely)
+
+    @return The number of elements popped (at least 1), 0 if the timeout expired, -1 if the queue is closed and empty
+
+    Notes:
+      - Returns as soon as any element is available -- It never waits to fill the batch
+      - Complexity: O(max_n)
+*/
+int bqueue_pop_batch(BQueue *queue, void **data, int max_n, int timeout_ms);
+
+
+/* Close the queue
+    @param queue  The BQueue structure
+
+    Notes:
+      - Later pushes fail, and blocked producers return -1
+      - Consumers keep popping the remaining elements, then get -1
+      - Complexity: O(1)
+*/
+void bqueue_close(BQueue *queue);
+
+
+/* Number of elements in the queue
+    @param queue  The BQueue structure
+
+    @return The number of elements in the queue
+
+    Notes:
+      - Only a snapshot while other threads are running
+      - Complexity: O(1)
+*/
+int bqueue_size(BQueue *queue);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Maximum number of elements the queue holds */
+#define bqueue_capacity(queue) ((queue)->high_watermark)
+
+#endif
@@ -0,0 +1,128 @@
+/* Header for Count-Min Sketch */
+#ifndef CMSKETCH_H
+#define CMSKETCH_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Purpose:
+     - Estimate how often any key occurred in a stream, in fixed memory (Cormode and Muthukrishnan, 2005)
+     - depth rows of width counters: a key adds to one counter per row, and its estimate is the smallest of them
+     - Estimates never undercount, and overcount by more than epsilon * total with probability at most delta
+     - Conservative update raises only the counters below the new estimate, which cuts the overcount on skewed
+       streams without giving up either guarantee (Estan and Varghese, SIGCOMM 2002)
+     - Sketches of equal dimensions built on different threads merge by adding counters (the merged sketch is
+       the plain count-min of the combined stream, so still an upper bound)
+     - Keys are 64-bit values -- Hash longer keys down to 64 bits first
+*/
+
+
+/*
+*********************************
+        Sketch Definitions
+*********************************
+*/
+
+/* Struct representing count-min sketch */
+typedef struct CMSketch_ {
+    int width;          /* Counters per row, a power of two */
+    int depth;          /* Number of rows */
+    uint64_t total;     /* Sum of every count added */
+    uint32_t *counters; /* depth rows of width counters, saturating at UINT32_MAX */
+} CMSketch;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a count-min sketch
+    @param sketch   The allocated CMSketch structure
+    @param epsilon  The overcount allowed, as a fraction of the total (e.g., 0.001)
+    @param delta    The probability of exceeding it (e.g., 0.01)
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Width is e / epsilon rounded up to a power of two, depth is ln(1 / delta) rounded up
+      - Complexity: O(width * depth)
+*/
+int cmsketch_init(CMSketch *sketch, double epsilon, double delta);
+
+
+/* Destroy a count-min sketch
+    @param sketch  The sketch to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void cmsketch_destroy(CMSketch *sketch);
+
+
+/* Count occurrences of a key (conservative update)
+    @param sketch  The CMSketch structure
+    @param key     The key
+    @param count   The number of occurrences
+
+    Notes:
+      - Complexity: O(depth)
+*/
+void cmsketch_add(CMSketch *sketch, uint64_t key, uint64_t count);
+
+
+/* Count occurrences of an array of keys
+    @param sketch  The CMSketch structure
+    @param keys    The keys
+    @param counts  The occurrences of each key (NULL to count each key once)
+    @param n       The number of keys
+
+    Notes:
+      - Hashes a block of keys before touching the counters, so the row loads of different keys overlap
+      - Complexity: O(n * depth)
+*/
+void cmsketch_add_n(CMSketch *sketch, const uint64_t *keys, const uint64_t *counts, int n);
+
+
+/* Estimate the occurrences of a key
+    @param sketch  The CMSketch structure
+    @param key     The key
+
+    @return An upper bound on the key's occurrences
+
+    Notes:
+      - Complexity: O(depth)
+*/
+uint64_t cmsketch_estimate(const CMSketch *sketch, uint64_t key);
+
+
+/* Merge another sketch into this one
+    @param sketch  The CMSketch structure receiving the merge
+    @param other   The sketch to merge (unchanged)
+
+    @return 0 if successful, -1 if the dimensions differ
+
+    Notes:
+      - Complexity: O(width * depth)
+*/
+int cmsketch_merge(CMSketch *sketch, const CMSketch *other);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Sum of every count added */
+#define cmsketch_total(sketch) ((sketch)->total)
+
+/* Bytes of counters */
+#define cmsketch_bytes(sketch) ((size_t)(sketch)->width * (sketch)->depth * sizeof(uint32_t))
+
+#endif
@@ -0,0 +1,163 @@
+/* Header for Deque */
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdlib.h>
+
+/* Purpose:
+     - Double-ended queue for workloads that only push and pop at the ends, where a DList (see dlist.h)
+       pays a node and a malloc per element
+     - Elements live in fixed-size blocks of DEQUE_BLOCK data pointers, and a block map holds the blocks in order
+     - The map keeps free room at both ends, so growing at either end only allocates a block every DEQUE_BLOCK pushes
+     - Element i is found with a shift and a mask, and each block can be walked as a plain array (see deque_block())
+*/
+
+
+/*
+********************************************
+        Deque Definition
+********************************************
+*/
+
+/* Number of data pointers per block (a power of two) -- 512 bytes on 64-bit targets */
+#define DEQUE_BLOCK_SHIFT 6
+#define DEQUE_BLOCK (1 << DEQUE_BLOCK_SHIFT)
+
+
+/* Struct representing deque */
+typedef struct Deque_ {
+    int size;                       /* Number of elements */
+    int head;                       /* Slot of the front element in the first block (0 <= head < DEQUE_BLOCK) */
+
+    void (*destroy)(void *data);    /* Function that can be used for deallocation (e.g., free()) */
+
+    void ***map;                    /* Block map -- Blocks in use are map[first] .. map[first + blocks - 1] */
+    int map_capacity;               /* Number of entries allocated in map */
+    int first;                      /* Map entry of the first block */
+    int blocks;                     /* Number of blocks in use */
+    void **spare;                   /* Last block released, kept so a deque hovering at a block boundary does not thrash malloc */
+} Deque;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a deque
+    @param deque    The allocated Deque structure
+    @param destroy  Pointer to function that will be used for deallocation
+
+    Notes:
+      - Must call this function before deque can be used
+      - If deque contains data that should not be freed, set destroy to NULL
+      - No storage is allocated until the first push
+      - Complexity: O(1)
+*/
+void deque_init(Deque *deque, void (*destroy)(void *data));
+
+
+/* Destroy a deque
+    @param deque  The deque to be destroyed
+
+    Notes:
+      - Calls the function passed as destroy to deque_init() once for each element, front first
+      - Complexity: O(n)
+*/
+void deque_destroy(Deque *deque);
+
+
+/* Push an element at the front of the deque
+    @param deque  The Deque structure
+    @param data   The data to be pushed
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1) amortized (the map is recentered or doubled when an end runs out of room)
+*/
+int deque_push_front(Deque *deque, const void *data);
+
+
+/* Push an element at the back of the deque
+    @param deque  The Deque structure
+    @param data   The data to be pushed
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1) amortized
+*/
+int deque_push_back(Deque *deque, const void *data);
+
+
+/* Pop the element at the front of the deque
+    @param deque  The Deque structure
+    @param data   The data of the popped element
+
+    @return 0 if successful, -1 if the deque is empty
+
+    Notes:
+      - Upon return, data points to the data of the popped element
+      - Complexity: O(1)
+*/
+int deque_pop_front(Deque *deque, void **data);
+
+
+/* Pop the element at the back of the deque
+    @param deque  The Deque structure
+    @param data   The data of the popped element
+
+    @return 0 if successful, -1 if the deque is empty
+
+    Notes:
+      - Upon return, data points to the data of the popped element
+      - Complexity: O(1)
+*/
+int deque_pop_back(Deque *deque, void **data);
+
+
+/* Get a block of contiguous elements
+    @param deque  The Deque structure
+    @param block  The block (0 <= block < deque_blocks(deque)), front first
+    @param data   Set to the first element of the block
+
+    @return The number of elements in the block
+
+    Notes:
+      - Element j of the block is (*data)[j] -- Elements are in deque order within and across blocks
+      - Only the first and last blocks can be partial
+      - Complexity: O(1)
+*/
+int deque_block(const Deque *deque, int block, void ***data);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of elements in the deque */
+#define deque_size(deque) ((deque)->size)
+
+/* Element i, counting from the front (0 <= i < size) */
+#define deque_item(deque, i) ((deque)->map[(deque)->first + (((deque)->head + (i)) >> DEQUE_BLOCK_SHIFT)][((deque)->head + (i)) & (DEQUE_BLOCK - 1)])
+
+/* Front element, or NULL if the deque is empty */
+#define deque_front(deque) ((deque)->size == 0 ? NULL : deque_item((deque), 0))
+
+/* Back element, or NULL if the deque is empty */
+#define deque_back(deque) ((deque)->size == 0 ? NULL : deque_item((deque), (deque)->size - 1))
+
+/* Number of blocks holding elements */
+#define deque_blocks(deque) ((deque)->blocks)
+
+#endif
@@ -106,6 +106,37 @@ int dlist_insert_prev(DList *list, DListElement *element, const void *data);
 int dlist_remove(DList *list, DListElement *element, void **data);
 
 
+/* Move every element of another list into this one, just after an existing element
+    @param list     The DList structure
+    @param element  The existing element
+    @param other    The DList whose elements are moved
+
+    @return 0 if splice successful, -1 otherwise
+
+    Notes:
+      - If element is NULL, the elements of other are spliced in at the head of the list
+      - The elements are relinked, not copied, so no allocation takes place -- other is left empty
+      - Complexity: O(1)
+*/
+int dlist_splice(DList *list, DListElement *element, DList *other);
+
+
+/* Sort the list in place
+    @param list     The DList structure
+    @param compare  Function used to compare the data of two elements
+
+    @return 0 if sorting successful, -1 otherwise
+
+    Notes:
+      - For ascending sort, compare should return 1 if key1>key2, 0 if key1=key2, and -1 if key1<key2
+      - Bottom-up merge sort over the natural ascending runs of the list -- Elements are relinked, never copied or allocated
+      - Stable: elements that compare equal keep their relative order
+      - The prev links are rebuilt in one final pass
+      - Complexity: O(nlog(r)) where r is the number of natural runs (O(n) on an already sorted list)
+*/
+int dlist_sort(DList *list, int (*compare)(const void *key1, const void *key2));
+
+
 
 
 /*
@@ -0,0 +1,157 @@
+/* Header for Hazard Pointers */
+#ifndef HAZARD_H
+#define HAZARD_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Purpose:
+     - Safe memory reclamation for lock-free containers (Michael, "Hazard Pointers", IEEE TPDS 2004)
+     - Before dereferencing a shared node, a thread publishes its address in one of its hazard slots
+     - A node unlinked from a container is retired rather than freed, and is only reclaimed once no slot holds it
+     - This also rules out ABA on the container's CAS: an address cannot be reused while any thread protects it
+     - Each thread works through its own HazardRecord, taken from the domain with hazard_acquire()
+*/
+
+
+/*
+********************************************
+        Record and Domain Definitions
+********************************************
+*/
+
+/* Number of hazard slots per thread */
+#define HAZARD_SLOTS 2
+
+/* Minimum number of retired pointers a thread collects before scanning */
+#define HAZARD_SCAN_MIN 64
+
+
+/* Struct representing one thread's hazard slots and retired pointers */
+typedef struct HazardRecord_ {
+    _Atomic(void *) hazards[HAZARD_SLOTS];  /* Pointers this thread is dereferencing -- Read by every scan */
+    atomic_int active;                      /* Nonzero while a thread owns the record */
+    struct HazardRecord_ *next;             /* Next record in the domain (records are never removed) */
+    struct HazardDomain_ *domain;           /* Domain the record belongs to */
+
+    void **retired;                         /* Pointers retired by the owner and not yet reclaimed */
+    int retired_count;                      /* Number of retired pointers */
+    int retired_capacity;                   /* Allocated size of retired */
+} HazardRecord;
+
+
+/* Struct representing a set of threads sharing nodes */
+typedef struct HazardDomain_ {
+    _Atomic(HazardRecord *) records;        /* Every record ever acquired */
+    atomic_int record_count;                /* Number of records */
+
+    void (*reclaim)(void *ptr);             /* Called on a retired pointer once no thread protects it (e.g., free()) */
+} HazardDomain;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a hazard pointer domain
+    @param domain   The allocated HazardDomain structure
+    @param reclaim  Function used to reclaim retired pointers
+
+    Notes:
+      - Must be called before the domain is shared between threads
+      - Complexity: O(1)
+*/
+void hazard_init(HazardDomain *domain, void (*reclaim)(void *ptr));
+
+
+/* Destroy a hazard pointer domain
+    @param domain  The domain to be destroyed
+
+    Notes:
+      - Reclaims every retired pointer and frees every record
+      - Must not be called while any thread may still use the domain
+      - Complexity: O(r) where r is the number of retired pointers
+*/
+void hazard_destroy(HazardDomain *domain);
+
+
+/* Acquire a record for the calling thread
+    @param domain  The HazardDomain structure
+
+    @return The record, or NULL if one could not be allocated
+
+    Notes:
+      - Reuses a record released by another thread if there is one, taking over its retired pointers
+      - A record must only be used by one thread at a time
+      - Complexity: O(t) where t is the number of records
+*/
+HazardRecord *hazard_acquire(HazardDomain *domain);
+
+
+/* Release a record so another thread can acquire it
+    @param record  The record to be released
+
+    Notes:
+      - Clears the hazard slots -- Pointers retired through the record stay with it until its next owner scans
+      - Complexity: O(1)
+*/
+void hazard_release(HazardRecord *record);
+
+
+/* Load a shared pointer and protect it with a hazard slot
+    @param record  The calling thread's record
+    @param slot    The hazard slot to use (0 <= slot < HAZARD_SLOTS)
+    @param source  The shared location to load from
+
+    @return The pointer loaded from source, now safe to dereference until the slot is cleared or reused
+
+    Notes:
+      - Publishes the pointer, then rereads source to make sure it did not change in between
+      - Complexity: O(1) expected
+*/
+void *hazard_protect(HazardRecord *record, int slot, _Atomic(void *) *source);
+
+
+/* Retire a pointer that has been unlinked from the shared structure
+    @param record  The calling thread's record
+    @param ptr     The pointer to be reclaimed once no thread protects it
+
+    @return 0 if successful, -1 if the retired list is full and could not grow (ptr is then still owned by the caller)
+
+    Notes:
+      - Scans once the record holds max(HAZARD_SCAN_MIN, 2 * HAZARD_SLOTS * records) pointers
+      - Complexity: O(1) amortized
+*/
+int hazard_retire(HazardRecord *record, void *ptr);
+
+
+/* Reclaim every retired pointer of a record that no thread protects
+    @param record  The calling thread's record
+
+    @return The number of pointers reclaimed
+
+    Notes:
+      - Complexity: O(r log h) where r is the number of retired pointers and h the number of hazard slots
+*/
+int hazard_scan(HazardRecord *record);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Stop protecting the pointer in a hazard slot */
+#define hazard_clear(record, slot) atomic_store_explicit(&(record)->hazards[(slot)], NULL, memory_order_release)
+
+/* Number of pointers retired through a record and not yet reclaimed */
+#define hazard_retired(record) ((record)->retired_count)
+
+#endif
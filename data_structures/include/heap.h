@@ -5,6 +5,7 @@
 /* Structure definition for heaps */
 typedef struct Heap_ {
     int size;       /* Number of nodes */
+    int capacity;   /* Number of allocated slots in tree -- Doubles when full, so inserts do not reallocate every time */
 
     int (*compare)(const void *key1, const void *key2);     /* Function used to compare two keys */
     void (*destroy)(void *data);                            /* Function used for deallocation (e.g., free()) */
@@ -55,7 +56,7 @@ void heap_destroy(Heap *heap);
 
     Notes:
       - It is the responsibility of the caller to manage the storage associated with data
-      - Complexity: O(log n), where n is the number of nodes in the tree
+      - Complexity: O(log n) amortized, where n is the number of nodes in the tree
 */
 int heap_insert(Heap *heap, const void *data);
 
@@ -85,4 +86,7 @@ int heap_extract(Heap *heap, void **data);
 /* Get number of nodes in heap */
 #define heap_size(heap) ((heap)->size)
 
+/* Get the data at the top of the heap, or NULL if the heap is empty */
+#define heap_peek(heap) ((heap)->size == 0 ? NULL : (heap)->tree[0])
+
 #endif
@@ -0,0 +1,131 @@
+/* Header for Intrusive Doubly Linked List */
+#ifndef IDLIST_H
+#define IDLIST_H
+
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Purpose:
+     - Doubly linked counterpart of ilist.h -- Links are embedded in the user's structs, so the list never allocates
+     - Since each link knows its predecessor, an element can be unlinked in O(1) given only the element itself
+     - Ex: struct Vertex { int id; IDListLink link; };  -->  struct Vertex *v = idlist_entry(l, struct Vertex, link);
+*/
+
+
+/*
+********************************************
+        Element and List Definitions
+********************************************
+*/
+
+/* Structure definition for the link embedded in each element of an intrusive doubly linked list */
+typedef struct IDListLink_ {
+    struct IDListLink_ *prev;   /* Previous link in list */
+    struct IDListLink_ *next;   /* Next link in list */
+} IDListLink;
+
+
+/* Structure definition of intrusive doubly linked list */
+typedef struct IDList_ {
+    int size;           /* Number of elements */
+
+    IDListLink *head;   /* First link */
+    IDListLink *tail;   /* Last link */
+} IDList;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize an intrusive doubly linked list
+    @param list  The allocated IDList structure
+
+    Notes:
+      - Must be called before IDList operations can be used
+      - There is no destroy function -- The list owns no storage, so the caller frees its structs however it likes
+      - Complexity: O(1)
+*/
+void idlist_init(IDList *list);
+
+
+/* Link a new element just after an existing element
+    @param list     The IDList structure
+    @param element  The existing link in the list
+    @param link     The link embedded in the new element
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - When inserting into an empty list, set element to NULL
+      - A link can only be in one list at a time
+      - Complexity: O(1)
+*/
+int idlist_insert_next(IDList *list, IDListLink *element, IDListLink *link);
+
+
+/* Link a new element just before an existing element
+    @param list     The IDList structure
+    @param element  The existing link in the list
+    @param link     The link embedded in the new element
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - When inserting into an empty list, set element to NULL
+      - A link can only be in one list at a time
+      - Complexity: O(1)
+*/
+int idlist_insert_prev(IDList *list, IDListLink *element, IDListLink *link);
+
+
+/* Unlink an element from the list
+    @param list  The IDList structure
+    @param link  The link of the element to be removed
+
+    @return 0 if removal successful, -1 otherwise
+
+    Notes:
+      - The element itself is untouched, so the caller may free it or link it into another list
+      - Complexity: O(1)
+*/
+int idlist_remove(IDList *list, IDListLink *link);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get the struct of the given type containing the link (member is the name of the link field within the struct) */
+#define idlist_entry(link, type, member) ((type *)((char *)(link) - offsetof(type, member)))
+
+/* Number of elements in the list */
+#define idlist_size(list) ((list)->size)
+
+/* Link at head of the list */
+#define idlist_head(list) ((list)->head)
+
+/* Check if link is head of the list */
+#define idlist_is_head(link) ((link)->prev == NULL ? 1 : 0)
+
+/* Link at tail of the list */
+#define idlist_tail(list) ((list)->tail)
+
+/* Check if link is tail of the list */
+#define idlist_is_tail(link) ((link)->next == NULL ? 1 : 0)
+
+/* Link just after specified link */
+#define idlist_next(link) ((link)->next)
+
+/* Link just before specified link */
+#define idlist_prev(link) ((link)->prev)
+
+#endif
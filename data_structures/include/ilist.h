@@ -0,0 +1,115 @@
+/* Header for Intrusive Linked List */
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Purpose:
+     - List (see list.h) allocates a ListElement for every insert, and each element points back at the user's data
+     - An intrusive list instead links together IListLink fields embedded in the user's own structs
+     - Nothing is allocated by the list, and the struct is recovered from its link with ilist_entry()
+     - Ex: struct Entry { int key; IListLink link; };  -->  struct Entry *e = ilist_entry(l, struct Entry, link);
+*/
+
+
+/*
+********************************************
+        Element and List Definitions
+********************************************
+*/
+
+/* Struct representing the link embedded in each element of an intrusive list */
+typedef struct IListLink_ {
+    struct IListLink_ *next;    /* Next link in list */
+} IListLink;
+
+
+/* Struct representing intrusive linked list */
+typedef struct IList_ {
+    int size;           /* Number of elements */
+
+    IListLink *head;    /* First link */
+    IListLink *tail;    /* Last link */
+} IList;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize an intrusive linked list
+    @param list  The allocated IList structure
+
+    Notes:
+      - Must call this function before list can be used
+      - There is no destroy function -- The list owns no storage, so the caller frees its structs however it likes
+      - Complexity: O(1)
+*/
+void ilist_init(IList *list);
+
+
+/* Link a new element just after an existing element
+    @param list     The IList structure
+    @param element  The existing link in the list
+    @param link     The link embedded in the new element
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - If element is NULL, the new element is inserted at the head of the list
+      - A link can only be in one list at a time
+      - Complexity: O(1)
+*/
+int ilist_insert_next(IList *list, IListLink *element, IListLink *link);
+
+
+/* Unlink the element just after an existing element
+    @param list     The IList structure
+    @param element  The existing link in the list
+    @param link     The link of the removed element
+
+    @return 0 if removal successful, -1 otherwise
+
+    Notes:
+      - If element is NULL, the element at the head of the list is removed
+      - Upon return, link points to the link of the removed element (use ilist_entry() to get the element)
+      - Complexity: O(1)
+*/
+int ilist_remove_next(IList *list, IListLink *element, IListLink **link);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get the struct of the given type containing the link (member is the name of the link field within the struct) */
+#define ilist_entry(link, type, member) ((type *)((char *)(link) - offsetof(type, member)))
+
+/* Number of elements in list */
+#define ilist_size(list) ((list)->size)
+
+/* Link at head of the list */
+#define ilist_head(list) ((list)->head)
+
+/* Check if link is head of list */
+#define ilist_is_head(list, link) ((link) == (list)->head ? 1 : 0)
+
+/* Link at tail of list */
+#define ilist_tail(list) ((list)->tail)
+
+/* Check if link is tail of list */
+#define ilist_is_tail(link) ((link)->next == NULL ? 1 : 0)
+
+/* Link following specified link */
+#define ilist_next(link) ((link)->next)
+
+#endif
@@ -0,0 +1,118 @@
+/* Header for Lock-Free Stack */
+#ifndef LFSTACK_H
+#define LFSTACK_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#include "hazard.h"
+
+/* Purpose:
+     - Treiber stack: push and pop swing the top pointer with a single CAS, so any number of threads can share it without a lock
+     - Popped nodes are retired to a hazard pointer domain (see hazard.h) instead of being freed on the spot, which makes it
+       safe for another thread to still be reading the node and rules out ABA on the top pointer
+     - Every thread popping from the stack needs its own HazardRecord -- Get one with hazard_acquire(lfstack_domain(stack))
+*/
+
+
+/*
+********************************************
+        Element and Stack Definitions
+********************************************
+*/
+
+/* Size of a cache line -- Keeps the contended top pointer on its own line */
+#define LFSTACK_CACHE_LINE 64
+
+
+/* Struct representing element of a lock-free stack */
+typedef struct LFStackNode_ {
+    void *data;                 /* Data member */
+    struct LFStackNode_ *next;  /* Element below this one */
+} LFStackNode;
+
+
+/* Struct representing lock-free stack */
+typedef struct LFStack_ {
+    _Alignas(LFSTACK_CACHE_LINE) _Atomic(void *) top;   /* Top LFStackNode (declared void * to work with hazard_protect()) */
+
+    _Alignas(LFSTACK_CACHE_LINE) HazardDomain domain;   /* Where popped nodes wait to be freed */
+    void (*destroy)(void *data);                        /* Function that can be used for deallocation (e.g., free()) */
+} LFStack;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a lock-free stack
+    @param stack    The allocated LFStack structure
+    @param destroy  Pointer to function that will be used for deallocation
+
+    Notes:
+      - Must be called before the stack is shared between threads
+      - If stack contains data that should not be freed, set destroy to NULL
+      - Complexity: O(1)
+*/
+void lfstack_init(LFStack *stack, void (*destroy)(void *data));
+
+
+/* Destroy a lock-free stack
+    @param stack  The stack to be destroyed
+
+    Notes:
+      - Calls the function passed as destroy to lfstack_init() once for each element still on the stack
+      - Frees every retired node and every HazardRecord -- Must not be called while any thread may still use the stack
+      - Complexity: O(n)
+*/
+void lfstack_destroy(LFStack *stack);
+
+
+/* Push an element onto the stack
+    @param stack  The LFStack structure
+    @param data   The data to be pushed
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Lock-free: retries only when another thread changed the top first
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1) expected
+*/
+int lfstack_push(LFStack *stack, const void *data);
+
+
+/* Pop an element from the stack
+    @param stack   The LFStack structure
+    @param record  The calling thread's HazardRecord from lfstack_domain(stack)
+    @param data    The data of the popped element
+
+    @return 0 if successful, -1 if the stack is empty
+
+    Notes:
+      - Upon return, data points to the data of the popped element
+      - The node is retired through record and freed by a later scan once no thread protects it
+      - Complexity: O(1) expected
+*/
+int lfstack_pop(LFStack *stack, HazardRecord *record, void **data);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Hazard pointer domain that the stack's HazardRecords come from */
+#define lfstack_domain(stack) (&(stack)->domain)
+
+/* Check if the stack is empty -- Only a snapshot while other threads are running */
+#define lfstack_is_empty(stack) (atomic_load_explicit(&(stack)->top, memory_order_relaxed) == NULL ? 1 : 0)
+
+#endif
@@ -91,6 +91,66 @@ int list_insert_next(List *list, ListElement *element, const void *data);
 int list_remove_next(List *list, ListElement *element, void **data);
 
 
+/* Move every element of another list into this one, just after an existing element
+    @param list     The list structure
+    @param element  The existing element
+    @param other    The list whose elements are moved
+
+    @return 0 if splice successful, -1 otherwise
+
+    Notes:
+      - If element is NULL, the elements of other are spliced in at the head of the list
+      - The elements are relinked, not copied, so no allocation takes place -- other is left empty
+      - Complexity: O(1)
+*/
+int list_splice(List *list, ListElement *element, List *other);
+
+
+/* Insert an array of data at the tail of the list
+    @param list   The list structure
+    @param data   The array of data to be inserted (in order)
+    @param count  The number of entries in data
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - All or nothing: if any allocation fails, the list is left unchanged
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(count)
+*/
+int list_append_array(List *list, void **data, int count);
+
+
+/* Remove every element whose data satisfies a predicate
+    @param list       The list structure
+    @param predicate  Function returning nonzero for data that should be removed
+    @param arg        Passed through to predicate as its second argument
+
+    @return The number of elements removed
+
+    Notes:
+      - Runs in a single pass over the list
+      - Calls the function passed as destroy to list_init() on the data of each removed element
+      - Complexity: O(n)
+*/
+int list_remove_if(List *list, int (*predicate)(const void *data, void *arg), void *arg);
+
+
+/* Sort the list in place
+    @param list     The List structure
+    @param compare  Function used to compare the data of two elements
+
+    @return 0 if sorting successful, -1 otherwise
+
+    Notes:
+      - For ascending sort, compare should return 1 if key1>key2, 0 if key1=key2, and -1 if key1<key2
+      - Bottom-up merge sort over the natural ascending runs of the list -- Elements are relinked, never copied or allocated
+      - Stable: elements that compare equal keep their relative order
+      - Complexity: O(nlog(r)) where r is the number of natural runs (O(n) on an already sorted list)
+*/
+int list_sort(List *list, int (*compare)(const void *key1, const void *key2));
+
+
 
 
 /*
@@ -0,0 +1,225 @@
+/* Header for Running Median */
+#ifndef MEDIAN_H
+#define MEDIAN_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "heap.h"
+
+/* Purpose:
+     - Running median of an unbounded stream of doubles
+     - Exact mode keeps the smaller half of the samples in a top-heavy Heap and the larger half in a bottom-heavy one
+       (see heap.h), so a sample costs O(log n) and the median is read off the two tops
+     - Approximate mode feeds a QSketch instead: a merging t-digest (Dunning and Ertl, 2019) that summarizes the
+       stream with a bounded number of weighted centroids, answering any quantile in fixed memory
+     - Centroids near the median may absorb up to 4 n q (1 - q) / compression samples, those in the tails far fewer,
+       so extreme percentiles stay accurate -- A floor on that bound caps the number of centroids, and needs no libm
+*/
+
+
+/*
+********************************************
+        Sketch and Median Definitions
+********************************************
+*/
+
+/* Modes of a running median */
+#define MEDIAN_EXACT 0
+#define MEDIAN_APPROX 1
+
+/* Compression used by approximate mode -- Roughly the number of centroids kept around the median */
+#define MEDIAN_COMPRESSION 100
+
+/* Tail factor -- A centroid may always hold n / (compression * QSKETCH_TAIL) samples, which caps the sketch
+   at 2 * compression * QSKETCH_TAIL centroids however long the stream */
+#define QSKETCH_TAIL 16
+
+/* Samples buffered per compression unit before they are merged into the centroids */
+#define QSKETCH_BUFFER 4
+
+/* Samples stored per chunk by exact mode */
+#define MEDIAN_CHUNK 1024
+
+
+/* Struct representing quantile sketch */
+typedef struct QSketch_ {
+    double compression;     /* Accuracy parameter */
+    uint64_t count;         /* Number of samples seen */
+    double min;             /* Smallest sample seen */
+    double max;             /* Largest sample seen */
+
+    int capacity;           /* Maximum number of centroids */
+    int centroids;          /* Number of centroids */
+    double *means;          /* Centroid means, increasing */
+    double *weights;        /* Number of samples in each centroid */
+
+    int buffer_capacity;    /* Samples held before a merge */
+    int buffered;           /* Samples waiting to be merged */
+    double *buffer;         /* Samples waiting to be merged */
+
+    double *scratch;        /* Room for the merge output (means, then weights) */
+} QSketch;
+
+
+/* Struct representing block of samples owned by exact mode */
+typedef struct MedianChunk_ {
+    struct MedianChunk_ *next;
+    int used;
+    double values[MEDIAN_CHUNK];
+} MedianChunk;
+
+
+/* Struct representing running median */
+typedef struct Median_ {
+    int mode;               /* MEDIAN_EXACT or MEDIAN_APPROX */
+
+    Heap lower;             /* Exact: smaller half, largest on top -- Holds the extra sample when the count is odd */
+    Heap upper;             /* Exact: larger half, smallest on top */
+    MedianChunk *chunks;    /* Exact: storage for the samples the heaps point to */
+
+    QSketch sketch;         /* Approximate: the sketch */
+} Median;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a quantile sketch
+    @param sketch       The allocated QSketch structure
+    @param compression  Accuracy parameter (e.g., 100) -- Memory grows linearly with it
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Allocates everything the sketch will ever use: 8 * compression * (4 * QSKETCH_TAIL + QSKETCH_BUFFER) bytes and change
+      - Complexity: O(1)
+*/
+int qsketch_init(QSketch *sketch, double compression);
+
+
+/* Destroy a quantile sketch
+    @param sketch  The sketch to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void qsketch_destroy(QSketch *sketch);
+
+
+/* Add a sample to a quantile sketch
+    @param sketch  The QSketch structure
+    @param value   The sample
+
+    Notes:
+      - Complexity: O(log compression) amortized (a sort of the buffer each time it fills)
+*/
+void qsketch_add(QSketch *sketch, double value);
+
+
+/* Add an array of samples to a quantile sketch
+    @param sketch  The QSketch structure
+    @param values  The samples
+    @param count   The number of samples
+
+    Notes:
+      - Complexity: O(count log compression)
+*/
+void qsketch_add_n(QSketch *sketch, const double *values, int count);
+
+
+/* Estimate a quantile
+    @param sketch  The QSketch structure
+    @param q       The quantile (0 for the minimum, 0.5 for the median, 0.99 for the 99th percentile, ...)
+    @param value   Set to the estimate
+
+    @return 0 if successful, -1 if the sketch is empty
+
+    Notes:
+      - Merges any buffered samples first
+      - Interpolates between neighbouring centroids, and is exact for the minimum and maximum
+      - Complexity: O(compression)
+*/
+int qsketch_quantile(QSketch *sketch, double q, double *value);
+
+
+/* Initialize a running median
+    @param median  The allocated Median structure
+    @param mode    MEDIAN_EXACT or MEDIAN_APPROX
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Exact mode stores every sample; approximate mode uses a QSketch of compression MEDIAN_COMPRESSION
+      - Complexity: O(1)
+*/
+int median_init(Median *median, int mode);
+
+
+/* Destroy a running median
+    @param median  The median to be destroyed
+
+    Notes:
+      - Complexity: O(n / MEDIAN_CHUNK) in exact mode, O(1) in approximate mode
+*/
+void median_destroy(Median *median);
+
+
+/* Add a sample
+    @param median  The Median structure
+    @param value   The sample
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Complexity: O(log n) in exact mode, O(log compression) amortized in approximate mode
+*/
+int median_add(Median *median, double value);
+
+
+/* Get the median of the samples so far
+    @param median  The Median structure
+    @param value   Set to the median (the mean of the two middle samples when the count is even)
+
+    @return 0 if successful, -1 if there are no samples
+
+    Notes:
+      - Complexity: O(1) in exact mode, O(compression) in approximate mode
+*/
+int median_get(Median *median, double *value);
+
+
+/* Estimate any quantile of the samples so far
+    @param median  The Median structure
+    @param q       The quantile (0 <= q <= 1)
+    @param value   Set to the estimate
+
+    @return 0 if successful, -1 if there are no samples or the median is in exact mode
+
+    Notes:
+      - Only approximate mode keeps what arbitrary quantiles need
+      - Complexity: O(compression)
+*/
+int median_quantile(Median *median, double q, double *value);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of samples added to a sketch */
+#define qsketch_count(sketch) ((sketch)->count)
+
+/* Number of samples added to a running median */
+#define median_count(median) ((median)->mode == MEDIAN_EXACT ? (uint64_t)(heap_size(&(median)->lower) + heap_size(&(median)->upper)) : qsketch_count(&(median)->sketch))
+
+#endif
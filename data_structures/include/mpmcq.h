@@ -0,0 +1,150 @@
+/* Header for Multi-Producer/Multi-Consumer Queue */
+#ifndef MPMCQ_H
+#define MPMCQ_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Purpose:
+     - Bounded lock-free queue that any number of threads may push to and pop from
+     - Follows Vyukov's design: every slot carries a sequence number telling producers and consumers whose turn it is
+     - A thread claims a position with one CAS on tail (push) or head (pop), and never touches the other index
+     - Blocking variants sleep on a futex (Linux) once the queue is full/empty, and are only woken when someone is waiting
+*/
+
+
+/*
+********************************************
+        Slot and Queue Definitions
+********************************************
+*/
+
+/* Size of a cache line -- Used to keep the producer and consumer indices apart */
+#define MPMCQ_CACHE_LINE 64
+
+
+/* Struct representing one slot of the ring */
+typedef struct MPMCSlot_ {
+    atomic_size_t sequence;     /* Position the slot is ready for -- pos for a push, pos + 1 for a pop */
+    void *data;                 /* Data member */
+} MPMCSlot;
+
+
+/* Struct representing multi-producer/multi-consumer queue */
+typedef struct MPMCQueue_ {
+    _Alignas(MPMCQ_CACHE_LINE) atomic_size_t tail;  /* Next position to push */
+    _Alignas(MPMCQ_CACHE_LINE) atomic_size_t head;  /* Next position to pop */
+
+    /* Sleeping support for the blocking variants */
+    _Alignas(MPMCQ_CACHE_LINE) atomic_uint not_empty;   /* Futex word bumped when a push may wake a consumer */
+    atomic_uint not_full;                               /* Futex word bumped when a pop may wake a producer */
+    atomic_int pop_waiters;                             /* Consumers sleeping (or about to sleep) on not_empty */
+    atomic_int push_waiters;                            /* Producers sleeping (or about to sleep) on not_full */
+
+    /* Read-only after initialization */
+    _Alignas(MPMCQ_CACHE_LINE) size_t capacity;     /* Number of slots (a power of two) */
+    size_t mask;                                    /* capacity - 1 */
+    MPMCSlot *slots;                                /* Ring buffer */
+} MPMCQueue;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a multi-producer/multi-consumer queue
+    @param queue     The allocated MPMCQueue structure
+    @param capacity  The minimum number of elements the queue must hold
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must be called before the queue is shared between threads
+      - capacity is rounded up to a power of two (at least 2)
+      - Allocate the structure with aligned_alloc(MPMCQ_CACHE_LINE, ...) (or statically) to keep the indices on whole cache lines
+      - Complexity: O(capacity)
+*/
+int mpmcq_init(MPMCQueue *queue, size_t capacity);
+
+
+/* Destroy a multi-producer/multi-consumer queue
+    @param queue  The queue to be destroyed
+
+    Notes:
+      - Elements still in the queue are not touched -- Drain the queue first if they own storage
+      - Must not be called while any thread may still use the queue
+      - Complexity: O(1)
+*/
+void mpmcq_destroy(MPMCQueue *queue);
+
+
+/* Try to push an element onto the queue
+    @param queue  The MPMCQueue structure
+    @param data   The data to be pushed
+
+    @return 0 if successful, -1 if the queue is full
+
+    Notes:
+      - Lock-free: retries only when another producer claimed the same position first
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1)
+*/
+int mpmcq_try_push(MPMCQueue *queue, const void *data);
+
+
+/* Try to pop an element from the queue
+    @param queue  The MPMCQueue structure
+    @param data   The data of the popped element
+
+    @return 0 if successful, -1 if the queue is empty
+
+    Notes:
+      - Upon return, data points to the data of the popped element
+      - Lock-free: retries only when another consumer claimed the same position first
+      - Complexity: O(1)
+*/
+int mpmcq_try_pop(MPMCQueue *queue, void **data);
+
+
+/* Push an element, sleeping while the queue is full
+    @param queue  The MPMCQueue structure
+    @param data   The data to be pushed
+
+    @return 0 once the element is pushed
+
+    Notes:
+      - Retries briefly (spinning, then yielding the CPU) before sleeping on a futex
+      - Complexity: O(1) when the queue has room
+*/
+int mpmcq_push(MPMCQueue *queue, const void *data);
+
+
+/* Pop an element, sleeping while the queue is empty
+    @param queue  The MPMCQueue structure
+    @param data   The data of the popped element
+
+    @return 0 once an element is popped
+
+    Notes:
+      - Retries briefly (spinning, then yielding the CPU) before sleeping on a futex
+      - Complexity: O(1) when the queue is nonempty
+*/
+int mpmcq_pop(MPMCQueue *queue, void **data);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of slots in the queue */
+#define mpmcq_capacity(queue) ((queue)->capacity)
+
+#endif
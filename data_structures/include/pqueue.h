@@ -32,7 +32,7 @@ typedef Heap PQueue;
 #define pqueue_extract heap_extract
 
 /* Peek at the top node in a priority queue */
-#define pqueue_peek(pqueue) ((pqueue)->tree == NULL ? NULL : (pqueue)->tree[0])
+#define pqueue_peek heap_peek
 
 /* Get number of nodes in a priority queue */
 #define pqueue_size heap_size
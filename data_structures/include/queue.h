@@ -4,11 +4,17 @@
 
 #include <stdlib.h>
 
-#include "list.h"
 
+/* Implement a queue as a ring buffer -- capacity is always a power of two, so positions wrap with a mask */
+typedef struct Queue_ {
+    int size;                       /* Number of elements */
+    int capacity;                   /* Number of allocated slots (0 or a power of two) */
+    int head;                       /* Slot holding the front of the queue */
 
-/* Implement a queue as a linked list */
-typedef List Queue;
+    void (*destroy)(void *data);    /* Function that can be used for deallocation (e.g., free()) */
+
+    void **data;                    /* Slots */
+} Queue;
 
 
 
@@ -19,19 +25,20 @@ typedef List Queue;
 *********************************
  */
 
-/* Initialize a queue -- Uses list initialization implementation
+/* Initialize a queue
     @param queue    The allocated Queue structure
     @param destroy  Pointer to function that will be used for deallocation
     
     Notes: 
       - Must call this function before queue can be used
       - If queue contains data that should not be freed, set destroy to NULL
+      - No storage is allocated until the first push (or queue_reserve())
       - Complexity: O(1) 
 */
 void queue_init(Queue *queue, void (*destroy)(void *data));
 
 
-/* Destroy a queue -- Uses list destruction implementation
+/* Destroy a queue
     @param queue  The queue to be destroyed
 
     Notes:
@@ -41,20 +48,35 @@ void queue_init(Queue *queue, void (*destroy)(void *data));
 void queue_destroy(Queue *queue);
 
 
-/* Push an element onto the queue -- Uses list insertion implementation
+/* Make room for at least capacity elements
+    @param queue     The Queue structure
+    @param capacity  The number of elements the queue should hold without growing
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - The capacity is rounded up to a power of two, and the queue never shrinks
+      - Elements keep their order when the buffer is reallocated
+      - Complexity: O(n)
+*/
+int queue_reserve(Queue *queue, int capacity);
+
+
+/* Push an element onto the queue
     @param queue  The Queue structure
     @param data   The data associated with the element to be added to the queue
 
     @return 0 if pushing element was successful, -1 otherwise
 
     Notes:
+      - The buffer doubles when full
       - It is the responsibility of the caller to manage the storage associated with data
-      - Complexity: O(1)
+      - Complexity: O(1) amortized
 */
 int queue_push(Queue *queue, const void *data);
 
 
-/* Pop an element from the queue -- Uses list removal implementation
+/* Pop an element from the queue
     @param queue  The Queue structure
     @param data   The data associated with the popped element
 
@@ -68,6 +90,34 @@ int queue_push(Queue *queue, const void *data);
 int queue_pop(Queue *queue, void **data);
 
 
+/* Push several elements onto the queue
+    @param queue  The Queue structure
+    @param data   The data to push, in order
+    @param count  The number of entries in data
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - All or nothing: if the queue cannot grow, nothing is pushed
+      - Complexity: O(count) amortized
+*/
+int queue_push_n(Queue *queue, void **data, int count);
+
+
+/* Pop several elements from the queue
+    @param queue  The Queue structure
+    @param data   Array receiving the popped data, front of the queue first
+    @param count  The maximum number of elements to pop
+
+    @return The number of elements popped
+
+    Notes:
+      - Pops fewer than count elements only when the queue runs out
+      - Complexity: O(count)
+*/
+int queue_pop_n(Queue *queue, void **data, int count);
+
+
 
 
 /*
@@ -76,10 +126,13 @@ int queue_pop(Queue *queue, void **data);
 *****************************
 */
 
-/* Get data stored in top element, or NULL if queue is empty */
-#define queue_peek(queue) ((queue)->head == NULL ? NULL : (queue)->head->data)
+/* Get data stored in front element, or NULL if queue is empty */
+#define queue_peek(queue) ((queue)->size == 0 ? NULL : (queue)->data[(queue)->head])
+
+/* Get data stored i elements behind the front (0 is the front) */
+#define queue_item(queue, i) ((queue)->data[((queue)->head + (i)) & ((queue)->capacity - 1)])
 
-/* Number of elements in the queue -- Uses list size implementation */
-#define queue_size list_size
+/* Number of elements in the queue */
+#define queue_size(queue) ((queue)->size)
 
 #endif
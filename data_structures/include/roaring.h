@@ -0,0 +1,247 @@
+/* Header for Roaring Bitmaps */
+#ifndef ROARING_H
+#define ROARING_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Purpose:
+     - Compressed set of 32-bit unsigned integers that stays small for both sparse and dense data
+     - Values are split into chunks by their high 16 bits, and each non-empty chunk is kept in a container:
+         - Array container:  sorted array of low 16 bits (used for up to ROARING_ARRAY_MAX values)
+         - Bitmap container: 65536-bit bitmap (used for more values)
+         - Run container:    sorted runs of consecutive values (produced by roaring_optimize())
+     - Containers are kept in an array sorted by their key (i.e., high 16 bits)
+*/
+
+/* Largest number of values kept in an array container */
+#define ROARING_ARRAY_MAX 4096
+
+/* Number of 64-bit words in a bitmap container */
+#define ROARING_BITMAP_WORDS 1024
+
+/* Container types */
+#define ROARING_ARRAY 0
+#define ROARING_BITMAP 1
+#define ROARING_RUN 2
+
+
+/* Structure definition for a container holding the values of one 64K chunk */
+typedef struct RoaringContainer_ {
+    uint16_t key;       /* High 16 bits shared by all values in the container */
+    int type;           /* ROARING_ARRAY, ROARING_BITMAP, or ROARING_RUN */
+    int cardinality;    /* Number of values in the container */
+
+    int count;          /* Array: number of values, Bitmap: number of words, Run: number of runs */
+    int capacity;       /* Number of entries allocated (values for arrays, runs for run containers) */
+
+    void *data;         /* Array: uint16_t values, Bitmap: uint64_t words, Run: uint16_t (start, length - 1) pairs */
+} RoaringContainer;
+
+
+/* Structure definition for roaring bitmaps */
+typedef struct Roaring_ {
+    int size;       /* Number of containers */
+    int capacity;   /* Number of containers allocated */
+
+    RoaringContainer *containers;   /* Containers sorted by key */
+} Roaring;
+
+
+/* Structure definition for iterating over the values of a roaring bitmap in ascending order */
+typedef struct RoaringIter_ {
+    const Roaring *bitmap;  /* The bitmap being iterated over */
+    int container;          /* Index of the current container */
+    int pos;                /* Array: index of next value, Bitmap: next low 16 bits to test, Run: offset within current run */
+    int run;                /* Run: index of current run */
+} RoaringIter;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a roaring bitmap
+    @param bitmap  The allocated Roaring structure
+
+    Notes:
+      - Must be called before other roaring bitmap operations can be used
+      - Complexity: O(1)
+*/
+void roaring_init(Roaring *bitmap);
+
+
+/* Destroy a roaring bitmap
+    @param bitmap  The roaring bitmap to be destroyed
+
+    Notes:
+      - Complexity: O(c), where c is the number of containers
+*/
+void roaring_destroy(Roaring *bitmap);
+
+
+/* Insert a value into a roaring bitmap
+    @param bitmap  The Roaring structure
+    @param value   The value to be inserted
+
+    @return 0 if insertion successful, 1 if value already exists, -1 otherwise
+
+    Notes:
+      - An array container that grows past ROARING_ARRAY_MAX values becomes a bitmap container
+      - Inserting into a run container first converts it back to an array or bitmap container
+      - Complexity: O(log c + ROARING_ARRAY_MAX), where c is the number of containers
+*/
+int roaring_insert(Roaring *bitmap, uint32_t value);
+
+
+/* Remove a value from a roaring bitmap
+    @param bitmap  The Roaring structure
+    @param value   The value to be removed
+
+    @return 0 if removal successful, -1 otherwise
+
+    Notes:
+      - A bitmap container that shrinks to ROARING_ARRAY_MAX values becomes an array container
+      - Complexity: O(log c + ROARING_ARRAY_MAX), where c is the number of containers
+*/
+int roaring_remove(Roaring *bitmap, uint32_t value);
+
+
+/* Determine whether a value is in a roaring bitmap
+    @param bitmap  The Roaring structure
+    @param value   The value to look for
+
+    @return 1 if the value is in the bitmap, 0 otherwise
+
+    Notes:
+      - Complexity: O(log c + log ROARING_ARRAY_MAX), where c is the number of containers
+*/
+int roaring_is_element(const Roaring *bitmap, uint32_t value);
+
+
+/* Compute the union, intersection, or difference of two roaring bitmaps
+    @param bitmapr  The roaring bitmap containing the result
+    @param bitmap1  The first roaring bitmap
+    @param bitmap2  The second roaring bitmap
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - These functions call roaring_init() for bitmapr
+      - roaring_difference() computes bitmap1 - bitmap2
+      - Containers are combined pairwise by key: array/array by merging, array/other by probing, and bitmap/bitmap a word at a time
+      - Combined containers come out as array or bitmap containers, while containers copied from one input keep their form
+      - Complexity: O(c1 + c2) container operations, each O(ROARING_BITMAP_WORDS) at worst
+*/
+int roaring_union(Roaring *bitmapr, const Roaring *bitmap1, const Roaring *bitmap2);
+int roaring_intersection(Roaring *bitmapr, const Roaring *bitmap1, const Roaring *bitmap2);
+int roaring_difference(Roaring *bitmapr, const Roaring *bitmap1, const Roaring *bitmap2);
+
+
+/* Count the values in a roaring bitmap
+    @param bitmap  The Roaring structure
+
+    @return Number of values in the bitmap
+
+    Notes:
+      - Complexity: O(c), where c is the number of containers
+*/
+uint64_t roaring_cardinality(const Roaring *bitmap);
+
+
+/* Convert each container to whichever of the array, bitmap, or run forms takes the least memory
+    @param bitmap  The Roaring structure
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Call this after building a bitmap with long runs of consecutive values
+      - Complexity: O(c * ROARING_BITMAP_WORDS), where c is the number of containers
+*/
+int roaring_optimize(Roaring *bitmap);
+
+
+/* Begin iterating over the values of a roaring bitmap
+    @param iter    The RoaringIter structure
+    @param bitmap  The Roaring structure
+
+    Notes:
+      - The bitmap must not be modified while it is being iterated over
+      - Complexity: O(1)
+*/
+void roaring_iter_init(RoaringIter *iter, const Roaring *bitmap);
+
+
+/* Get the next value of an iteration
+    @param iter   The RoaringIter structure
+    @param value  The next value
+
+    @return 1 if a value was produced, 0 if the iteration is over
+
+    Notes:
+      - Values are produced in ascending order
+      - Complexity: O(1) amortized per value (bitmap containers skip 64 absent values at a time)
+*/
+int roaring_iter_next(RoaringIter *iter, uint32_t *value);
+
+
+/* Get the number of bytes needed to serialize a roaring bitmap
+    @param bitmap  The Roaring structure
+
+    @return Number of bytes roaring_serialize() will write
+
+    Notes:
+      - Complexity: O(c), where c is the number of containers
+*/
+size_t roaring_serialized_size(const Roaring *bitmap);
+
+
+/* Serialize a roaring bitmap
+    @param bitmap  The Roaring structure
+    @param buf     Buffer to hold the serialized bitmap
+
+    @return Number of bytes written
+
+    Notes:
+      - buf must hold at least roaring_serialized_size() bytes
+      - All integers are written in little-endian byte order, so the result can be read on any platform
+      - Layout: container count (4 bytes), then per container: key (2), type (1), count (4), and its payload
+      - Complexity: O(n), where n is the size of the serialized bitmap
+*/
+size_t roaring_serialize(const Roaring *bitmap, unsigned char *buf);
+
+
+/* Deserialize a roaring bitmap
+    @param bitmap  The roaring bitmap to hold the result
+    @param buf     Buffer holding a bitmap written by roaring_serialize()
+    @param len     Number of bytes in buf
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - This function calls roaring_init() for bitmap
+      - Returns -1 if buf is truncated or malformed
+      - Complexity: O(n), where n is the size of the serialized bitmap
+*/
+int roaring_deserialize(Roaring *bitmap, const unsigned char *buf, size_t len);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get number of containers in a roaring bitmap */
+#define roaring_containers(bitmap) ((bitmap)->size)
+
+/* Check if a roaring bitmap is empty */
+#define roaring_is_empty(bitmap) ((bitmap)->size == 0 ? 1 : 0)
+
+#endif
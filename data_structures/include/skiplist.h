@@ -0,0 +1,168 @@
+/* Header for Skip List */
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdlib.h>
+
+/* Purpose:
+     - Ordered container with O(log n) expected search, insert and remove (an alternative to BisTree, see bistree.h)
+     - Level 0 is a sorted singly linked list, so in-order iteration and range scans just follow forward[0]
+     - Each node is one allocation -- Its forward pointers are a flexible array member sized to the node's level
+     - Levels are drawn with probability 1/4 per extra level, which keeps the average node at 1.33 forward pointers
+*/
+
+
+/*
+********************************************
+        Element and List Definitions
+********************************************
+*/
+
+/* Maximum number of levels -- Plenty for 4^16 elements */
+#define SKIPLIST_MAX_LEVEL 16
+
+
+/* Struct representing node of a skip list */
+typedef struct SkipListNode_ {
+    void *data;                         /* Data member */
+    int level;                          /* Number of forward pointers */
+    struct SkipListNode_ *forward[];    /* Next node at each level, allocated with the node */
+} SkipListNode;
+
+
+/* Struct representing skip list */
+typedef struct SkipList_ {
+    int size;           /* Number of elements */
+    int level;          /* Number of levels in use */
+    unsigned int seed;  /* State of the generator used to pick levels */
+
+    int (*compare)(const void *key1, const void *key2);     /* Function used to order elements */
+    void (*destroy)(void *data);                            /* Function that can be used for deallocation (e.g., free()) */
+
+    SkipListNode *head; /* Header node holding SKIPLIST_MAX_LEVEL forward pointers and no data */
+} SkipList;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a skip list
+    @param list     The allocated SkipList structure
+    @param compare  Function used to compare elements
+    @param destroy  Function used for deallocation
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must be called before other skip list operations can be used
+      - compare should return 1 if key1>key2, 0 if key1=key2, and -1 if key1<key2
+      - If skip list contains data that should not be freed, set destroy to NULL
+      - Complexity: O(1)
+*/
+int skiplist_init(SkipList *list, int (*compare)(const void *key1, const void *key2), void (*destroy)(void *data));
+
+
+/* Destroy a skip list
+    @param list  The SkipList structure to be destroyed
+
+    Notes:
+      - Calls the function passed as destroy to skiplist_init() once for each element
+      - Complexity: O(n)
+*/
+void skiplist_destroy(SkipList *list);
+
+
+/* Insert an element into a skip list
+    @param list  The SkipList structure
+    @param data  The data to be inserted
+
+    @return 0 if insertion successful, 1 if the element already exists, -1 otherwise
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(log n) expected
+*/
+int skiplist_insert(SkipList *list, const void *data);
+
+
+/* Remove an element from a skip list
+    @param list  The SkipList structure
+    @param data  The key of the element to remove
+
+    @return 0 if removal successful, -1 otherwise
+
+    Notes:
+      - Upon return, data points to the data stored in the removed element
+      - It is the responsibility of the caller to deal with the storage associated with the data
+      - Complexity: O(log n) expected
+*/
+int skiplist_remove(SkipList *list, void **data);
+
+
+/* Find an element in a skip list
+    @param list  The SkipList structure
+    @param data  The key of the element to find
+
+    @return 0 if the element is found, -1 otherwise
+
+    Notes:
+      - If a matching element is found, data points to the data in the skip list upon return
+      - Complexity: O(log n) expected
+*/
+int skiplist_lookup(const SkipList *list, void **data);
+
+
+/* Find the first element not less than a key
+    @param list  The SkipList structure
+    @param key   The key to search for
+
+    @return The first node whose data compares >= key, or NULL if every element is less than key
+
+    Notes:
+      - Continue an in-order scan from the returned node with skiplist_next()
+      - Complexity: O(log n) expected
+*/
+SkipListNode *skiplist_lower_bound(const SkipList *list, const void *key);
+
+
+/* Visit every element in a half-open key range, in order
+    @param list      The SkipList structure
+    @param low       Elements >= low are visited (NULL means from the first element)
+    @param high      Elements < high are visited (NULL means through the last element)
+    @param callback  Function called with each element's data and arg -- Return nonzero to stop early
+    @param arg       Passed through to callback
+
+    @return The number of elements visited
+
+    Notes:
+      - Complexity: O(log n + k) expected, where k is the number of elements visited
+*/
+int skiplist_range(const SkipList *list, const void *low, const void *high, int (*callback)(const void *data, void *arg), void *arg);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of elements in skip list */
+#define skiplist_size(list) ((list)->size)
+
+/* Node holding the smallest element (NULL if empty) */
+#define skiplist_first(list) ((list)->head->forward[0])
+
+/* Node holding the next element in order (NULL at the end) */
+#define skiplist_next(node) ((node)->forward[0])
+
+/* Data stored in the specified node */
+#define skiplist_data(node) ((node)->data)
+
+#endif
@@ -0,0 +1,159 @@
+/* Header for Space-Saving Heavy Hitters */
+#ifndef SPACESAVING_H
+#define SPACESAVING_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Purpose:
+     - Find the most frequent keys of a stream in fixed memory (Metwally, Agrawal and El Abbadi, ICDT 2005)
+     - Keeps k counters: a tracked key adds to its own, an untracked key takes over the smallest counter,
+       inheriting its count as error -- Any key with more than n / k occurrences is always tracked
+     - Counters sit in a min-heap (ordered by count, with each counter knowing its heap position) so the smallest
+       is found in O(1), and in an open-addressing index so a key finds its counter in O(1) expected
+     - Summaries built on different threads merge into one (Agarwal et al., "Mergeable Summaries", PODS 2012)
+     - Keys are 64-bit values -- Hash longer keys (flow tuples, strings) down to 64 bits first
+*/
+
+
+/*
+********************************************
+        Counter and Summary Definitions
+********************************************
+*/
+
+/* Struct representing one counter */
+typedef struct SSCounter_ {
+    uint64_t key;
+    uint64_t count;     /* Upper bound on the key's occurrences */
+    uint64_t error;     /* Most by which count may overestimate them */
+    int position;       /* Slot of the counter in the heap */
+} SSCounter;
+
+
+/* Struct representing space-saving summary */
+typedef struct SpaceSaving_ {
+    int capacity;           /* Number of counters (k) */
+    int size;               /* Number of counters in use */
+    uint64_t total;         /* Sum of every count added */
+
+    SSCounter *counters;    /* Counters, in no particular order */
+    int *heap;              /* Counter numbers, a min-heap by count */
+    int *index;             /* Open-addressing table of counter numbers by key (-1 when free) */
+    int index_mask;         /* Index slots - 1 (a power of two, at least twice the capacity) */
+} SpaceSaving;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a space-saving summary
+    @param summary   The allocated SpaceSaving structure
+    @param capacity  The number of counters (keys more frequent than 1 / capacity of the stream are guaranteed to be kept)
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Allocates everything the summary will ever use, about 40 * capacity bytes
+      - Complexity: O(capacity)
+*/
+int spacesaving_init(SpaceSaving *summary, int capacity);
+
+
+/* Destroy a space-saving summary
+    @param summary  The summary to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void spacesaving_destroy(SpaceSaving *summary);
+
+
+/* Count occurrences of a key
+    @param summary  The SpaceSaving structure
+    @param key      The key
+    @param count    The number of occurrences (e.g., 1, or a byte count for top talkers by volume)
+
+    Notes:
+      - Complexity: O(log capacity) worst case, O(1) expected for keys whose counter stays near the heap's bottom
+*/
+void spacesaving_add(SpaceSaving *summary, uint64_t key, uint64_t count);
+
+
+/* Count occurrences of an array of keys
+    @param summary  The SpaceSaving structure
+    @param keys     The keys
+    @param counts   The occurrences of each key (NULL to count each key once)
+    @param n        The number of keys
+
+    Notes:
+      - Complexity: O(n log capacity)
+*/
+void spacesaving_add_n(SpaceSaving *summary, const uint64_t *keys, const uint64_t *counts, int n);
+
+
+/* Look up the estimate for a key
+    @param summary  The SpaceSaving structure
+    @param key      The key
+    @param counter  Set to the key's counter (count and error)
+
+    @return 0 if the key is tracked, -1 otherwise (its count is then at most spacesaving_min(summary))
+
+    Notes:
+      - The true count of a tracked key lies in [count - error, count]
+      - Complexity: O(1) expected
+*/
+int spacesaving_lookup(const SpaceSaving *summary, uint64_t key, SSCounter *counter);
+
+
+/* Get the most frequent keys
+    @param summary  The SpaceSaving structure
+    @param top      Array receiving up to n counters, largest count first
+    @param n        The number of counters wanted
+
+    @return The number of counters written
+
+    Notes:
+      - A key whose count - error exceeds the next key's count is certainly in the top
+      - Complexity: O(size log size)
+*/
+int spacesaving_top(const SpaceSaving *summary, SSCounter *top, int n);
+
+
+/* Merge another summary into this one
+    @param summary  The SpaceSaving structure receiving the merge
+    @param other    The summary to merge (unchanged)
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - A key missing from one full summary is credited with that summary's smallest count, as both count and error
+      - Keeps the capacity largest counters of the union, so the guarantee holds for the combined stream
+      - Complexity: O((size + other size) log (size + other size))
+*/
+int spacesaving_merge(SpaceSaving *summary, const SpaceSaving *other);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of keys tracked */
+#define spacesaving_size(summary) ((summary)->size)
+
+/* Sum of every count added */
+#define spacesaving_total(summary) ((summary)->total)
+
+/* Smallest tracked count -- An untracked key occurred at most this often (0 until the summary fills) */
+#define spacesaving_min(summary) ((summary)->size < (summary)->capacity ? 0 : (summary)->counters[(summary)->heap[0]].count)
+
+#endif
@@ -0,0 +1,154 @@
+/* Header for Single-Producer/Single-Consumer Queue */
+#ifndef SPSCQ_H
+#define SPSCQ_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Purpose:
+     - Bounded ring buffer that hands pointers from exactly one producer thread to exactly one consumer thread
+     - Wait-free: push and pop never block or retry, they only fail when the queue is full or empty
+     - tail is written only by the producer and head only by the consumer, each on its own cache line
+     - Each side keeps a cached copy of the other side's index and only rereads the shared one when the cache says full/empty
+*/
+
+
+/*
+********************************************
+        Queue Definition
+********************************************
+*/
+
+/* Size of a cache line -- Used to keep the producer and consumer fields apart */
+#define SPSCQ_CACHE_LINE 64
+
+
+/* Struct representing single-producer/single-consumer queue */
+typedef struct SPSCQueue_ {
+    /* Producer side */
+    _Alignas(SPSCQ_CACHE_LINE) atomic_size_t tail;  /* Next slot to write */
+    size_t head_cache;                              /* Producer's last view of head */
+
+    /* Consumer side */
+    _Alignas(SPSCQ_CACHE_LINE) atomic_size_t head;  /* Next slot to read */
+    size_t tail_cache;                              /* Consumer's last view of tail */
+
+    /* Read-only after initialization */
+    _Alignas(SPSCQ_CACHE_LINE) size_t capacity;     /* Number of slots (a power of two) */
+    size_t mask;                                    /* capacity - 1 */
+    void **slots;                                   /* Ring buffer */
+} SPSCQueue;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a single-producer/single-consumer queue
+    @param queue     The allocated SPSCQueue structure
+    @param capacity  The minimum number of elements the queue must hold
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must be called before the queue is shared between threads
+      - capacity is rounded up to a power of two
+      - Allocate the structure with aligned_alloc(SPSCQ_CACHE_LINE, ...) (or statically) to keep each side on whole cache lines
+      - Complexity: O(capacity)
+*/
+int spscq_init(SPSCQueue *queue, size_t capacity);
+
+
+/* Destroy a single-producer/single-consumer queue
+    @param queue  The queue to be destroyed
+
+    Notes:
+      - Elements still in the queue are not touched -- Drain the queue first if they own storage
+      - Must not be called while either thread may still use the queue
+      - Complexity: O(1)
+*/
+void spscq_destroy(SPSCQueue *queue);
+
+
+/* Push an element onto the queue (producer thread only)
+    @param queue  The SPSCQueue structure
+    @param data   The data to be pushed
+
+    @return 0 if successful, -1 if the queue is full
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1)
+*/
+int spscq_push(SPSCQueue *queue, const void *data);
+
+
+/* Pop an element from the queue (consumer thread only)
+    @param queue  The SPSCQueue structure
+    @param data   The data of the popped element
+
+    @return 0 if successful, -1 if the queue is empty
+
+    Notes:
+      - Upon return, data points to the data of the popped element
+      - Complexity: O(1)
+*/
+int spscq_pop(SPSCQueue *queue, void **data);
+
+
+/* Push as many elements of an array as fit (producer thread only)
+    @param queue  The SPSCQueue structure
+    @param data   The data to be pushed, in order
+    @param count  The number of entries in data
+
+    @return The number of elements pushed
+
+    Notes:
+      - Publishes the whole batch with a single release store of tail
+      - Complexity: O(count)
+*/
+size_t spscq_push_n(SPSCQueue *queue, void **data, size_t count);
+
+
+/* Pop up to count elements (consumer thread only)
+    @param queue  The SPSCQueue structure
+    @param data   Array receiving the popped data, front of the queue first
+    @param count  The maximum number of elements to pop
+
+    @return The number of elements popped
+
+    Notes:
+      - Releases the whole batch with a single release store of head
+      - Complexity: O(count)
+*/
+size_t spscq_pop_n(SPSCQueue *queue, void **data, size_t count);
+
+
+/* Number of elements in the queue
+    @param queue  The SPSCQueue structure
+
+    @return The number of elements in the queue
+
+    Notes:
+      - Only a snapshot when the other thread is running, but never more than the capacity
+      - Complexity: O(1)
+*/
+size_t spscq_size(const SPSCQueue *queue);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of slots in the queue */
+#define spscq_capacity(queue) ((queue)->capacity)
+
+#endif
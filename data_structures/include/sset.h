@@ -0,0 +1,210 @@
+/* Header for Sorted-Array Sets */
+#ifndef SSET_H
+#define SSET_H
+
+#include <stdlib.h>
+
+/* Purpose:
+     - Set (see set.h) stores void * members in a linked list, so every operation walks the list and calls match()
+     - SSet stores unsigned integer members (e.g., IDs) in a sorted contiguous array
+     - Set algebra becomes a linear merge, and intersection uses SIMD block compares (SSE2/AVX2) when available
+*/
+
+/* Implement a sorted-array set as a growable array of members kept in ascending order */
+typedef struct SSet_ {
+    int size;               /* Number of members */
+    int capacity;           /* Number of members that fit in the allocated array */
+
+    unsigned int *members;  /* The members themselves, in ascending order */
+} SSet;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a sorted-array set
+    @param set  The allocated SSet struct
+
+    Notes:
+      - Must be called before SSet operations can be used
+      - Complexity: O(1)
+*/
+void sset_init(SSet *set);
+
+
+/* Destroy a sorted-array set
+    @param set  The set to be destroyed
+
+    Notes:
+      - Frees the array of members
+      - Complexity: O(1)
+*/
+void sset_destroy(SSet *set);
+
+
+/* Insert new member into the set
+    @param set   The SSet structure
+    @param data  The member to be inserted
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Returns -1 if data is already a member
+      - Inserting members in ascending order only appends to the array
+      - Complexity: O(1) amortized when appending in ascending order, O(n) otherwise
+*/
+int sset_insert(SSet *set, unsigned int data);
+
+
+/* Remove a member from the set
+    @param set   The SSet structure
+    @param data  The member to be removed
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Returns -1 if data is not a member
+      - Complexity: O(n)
+*/
+int sset_remove(SSet *set, unsigned int data);
+
+
+/* Compute the union of two sets
+    @param setu  The set containing the union of the two sets
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - This function calls sset_init() for setu
+      - Complexity: O(m + n), where m,n = # of members in set1,set2
+*/
+int sset_union(SSet *setu, const SSet *set1, const SSet *set2);
+
+
+/* Compute the intersection of two sets
+    @param seti  The set containing the intersection of the two sets
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - This function calls sset_init() for seti
+      - Sets of similar size are intersected with SIMD block compares (or a scalar merge without SSE2)
+      - If one set is much larger than the other, members of the smaller set are located in the larger set by galloping
+      - Complexity: O(m + n) for similar sizes, O(m log(n/m)) when skewed, where m <= n are the set sizes
+*/
+int sset_intersection(SSet *seti, const SSet *set1, const SSet *set2);
+
+
+/* Compute the intersection of several sets at once
+    @param seti   The set containing the intersection of all the sets
+    @param sets   Array of pointers to the sets to be intersected
+    @param count  Number of sets in sets
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - This function calls sset_init() for seti
+      - No intermediate sets are built -- Only members present in every set are stored (see sset_intersection_stream())
+      - Complexity: O(k m log(n/m)) in the worst case, where k = count, m = size of smallest set, n = size of largest set
+*/
+int sset_intersection_multi(SSet *seti, const SSet **sets, int count);
+
+
+/* Visit each member of the intersection of several sets without storing it
+    @param sets      Array of pointers to the sets to be intersected
+    @param count     Number of sets in sets
+    @param callback  Function called once for each member of the intersection (in ascending order)
+    @param arg       Pointer passed through to callback
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - The sets are probed from smallest to largest, and each set is searched by galloping from where its last search ended
+      - A candidate missing from a set is replaced by the first member of the smallest set that is >= what that set held instead,
+        so runs of members absent from the other sets are skipped in one step
+      - Stops early (and returns 0) if callback returns a nonzero value
+      - Complexity: O(k m log(n/m)) in the worst case, where k = count, m = size of smallest set, n = size of largest set
+*/
+int sset_intersection_stream(const SSet **sets, int count, int (*callback)(unsigned int member, void *arg), void *arg);
+
+
+/* Compute the difference of two sets
+    @param setd  The set containing the difference of the two sets
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Computes set1 - set2
+      - This function calls sset_init() for setd
+      - Complexity: O(m + n), where m,n = # of members in set1,set2
+*/
+int sset_difference(SSet *setd, const SSet *set1, const SSet *set2);
+
+
+/* Determine whether a value is a member of the set
+    @param set   The SSet structure
+    @param data  The value to look for
+
+    @return 1 if data is a member of the set, 0 otherwise
+
+    Notes:
+      - Uses binary search
+      - Complexity: O(log n)
+*/
+int sset_is_element(const SSet *set, unsigned int data);
+
+
+/* Determine whether a set is a subset of another
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 1 if the set is a subset, 0 otherwise
+
+    Notes:
+      - Checks if set1 is a subset of set2
+      - Complexity: O(m + n), where m,n = # of members in set1,set2
+*/
+int sset_is_subset(const SSet *set1, const SSet *set2);
+
+
+/* Determine whether two sets are equal
+    @param set1  The first set
+    @param set2  The second set
+
+    @return 1 if the two sets are equal, 0 otherwise
+
+    Notes:
+      - Complexity: O(n), where n = # of members in each set
+*/
+int sset_is_equal(const SSet *set1, const SSet *set2);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Get number of members in set */
+#define sset_size(set) ((set)->size)
+
+/* Get the sorted array of members */
+#define sset_members(set) ((set)->members)
+
+/* Get the member at the specified position in sorted order */
+#define sset_member(set, pos) ((set)->members[(pos)])
+
+#endif
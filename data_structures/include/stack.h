@@ -4,11 +4,16 @@
 
 #include <stdlib.h>
 
-#include "list.h"
 
+/* Implement a stack as a growable array -- The top of the stack is the last used slot */
+typedef struct Stack_ {
+    int size;                       /* Number of elements */
+    int capacity;                   /* Number of allocated slots */
 
-/* Implement a stack as a linked list */
-typedef List Stack;
+    void (*destroy)(void *data);    /* Function that can be used for deallocation (e.g., free()) */
+
+    void **data;                    /* Slots, bottom of the stack first */
+} Stack;
 
 
 
@@ -19,19 +24,20 @@ typedef List Stack;
 *********************************
  */
 
-/* Initialize a stack -- Uses list initialization implementation
+/* Initialize a stack
     @param stack    The allocated Stack structure
     @param destroy  Pointer to function that will be used for deallocation
     
     Notes: 
       - Must call this function before stack can be used
       - If stack contains data that should not be freed, set destroy to NULL
+      - No storage is allocated until the first push (or stack_reserve())
       - Complexity: O(1) 
 */
 void stack_init(Stack *stack, void (*destroy)(void *data));
 
 
-/* Destroy a stack -- Uses list destruction implementation
+/* Destroy a stack
     @param stack  The stack to be destroyed
 
     Notes:
@@ -41,20 +47,34 @@ void stack_init(Stack *stack, void (*destroy)(void *data));
 void stack_destroy(Stack *stack);
 
 
-/* Push an element onto the stack -- Uses list insertion implementation
+/* Make room for at least capacity elements
+    @param stack     The Stack structure
+    @param capacity  The number of elements the stack should hold without growing
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Never shrinks the stack
+      - Complexity: O(n)
+*/
+int stack_reserve(Stack *stack, int capacity);
+
+
+/* Push an element onto the stack
     @param stack  The Stack structure
     @param data   The data associated with the element to be added to the stack
 
     @return 0 if pushing element was successful, -1 otherwise
 
     Notes:
+      - The array doubles when full
       - It is the responsibility of the caller to manage the storage associated with data
-      - Complexity: O(1)
+      - Complexity: O(1) amortized
 */
 int stack_push(Stack *stack, const void *data);
 
 
-/* Pop an element from the stack -- Uses list removal implementation
+/* Pop an element from the stack
     @param stack  The Stack structure
     @param data   The data associated with the popped element
 
@@ -68,6 +88,34 @@ int stack_push(Stack *stack, const void *data);
 int stack_pop(Stack *stack, void **data);
 
 
+/* Push several elements onto the stack
+    @param stack  The Stack structure
+    @param data   The data to push, in push order (data[count - 1] ends up on top)
+    @param count  The number of entries in data
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - All or nothing: if the stack cannot grow, nothing is pushed
+      - Complexity: O(count) amortized
+*/
+int stack_push_n(Stack *stack, void **data, int count);
+
+
+/* Pop several elements from the stack
+    @param stack  The Stack structure
+    @param data   Array receiving the popped data, in pop order (data[0] was the top)
+    @param count  The maximum number of elements to pop
+
+    @return The number of elements popped
+
+    Notes:
+      - Pops fewer than count elements only when the stack runs out
+      - Complexity: O(count)
+*/
+int stack_pop_n(Stack *stack, void **data, int count);
+
+
 
 
 /*
@@ -77,9 +125,12 @@ int stack_pop(Stack *stack, void **data);
 */
 
 /* Get data stored in top element, or NULL if stack is empty */
-#define stack_peek(stack) ((stack)->head == NULL ? NULL : (stack)->head->data)
+#define stack_peek(stack) ((stack)->size == 0 ? NULL : (stack)->data[(stack)->size - 1])
+
+/* Get data stored depth elements below the top (0 is the top) */
+#define stack_item(stack, depth) ((stack)->data[(stack)->size - 1 - (depth)])
 
-/* Number of elements in the stack -- Uses list size implementation */
-#define stack_size list_size
+/* Number of elements in the stack */
+#define stack_size(stack) ((stack)->size)
 
 #endif
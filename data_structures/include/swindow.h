@@ -0,0 +1,184 @@
+/* Header for Sliding Window */
+#ifndef SWINDOW_H
+#define SWINDOW_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Purpose:
+     - Rolling min, max, sum and mean over the most recent samples of a stream, at amortized O(1) per sample
+     - Min and max come from monotonic deques: a new sample drops every older sample it beats from the back,
+       so the front is always the answer and each sample is pushed and popped at most once
+     - Sum and mean come from a running sum with Neumaier compensation, so adding and removing
+       millions of samples does not drift
+     - A window either holds the last span samples (SWINDOW_COUNT) or the samples whose timestamp
+       lies within span of the newest one (SWINDOW_TIME)
+*/
+
+
+/*
+********************************************
+        Sample and Window Definitions
+********************************************
+*/
+
+/* Kinds of window */
+#define SWINDOW_COUNT 0     /* Last span samples */
+#define SWINDOW_TIME 1      /* Samples with stamp > newest stamp - span */
+
+
+/* Struct representing one sample */
+typedef struct SWindowSample_ {
+    double value;
+    uint64_t stamp;     /* Timestamp (time windows only) */
+    uint64_t seq;       /* Arrival number, identifying the sample in the deques */
+} SWindowSample;
+
+
+/* Struct representing a growable ring of samples, used as a deque */
+typedef struct SWindowRing_ {
+    SWindowSample *slots;
+    int capacity;       /* Number of slots (0 or a power of two) */
+    int head;           /* Slot of the front sample */
+    int size;           /* Number of samples */
+} SWindowRing;
+
+
+/* Struct representing sliding window */
+typedef struct SWindow_ {
+    int kind;               /* SWINDOW_COUNT or SWINDOW_TIME */
+    uint64_t span;          /* Window length, in samples or in time units */
+    uint64_t seq;           /* Arrival number of the next sample */
+
+    double sum;             /* Running sum of the samples in the window */
+    double compensation;    /* Low-order bits lost by sum */
+
+    SWindowRing samples;    /* Every sample in the window, oldest first */
+    SWindowRing min;        /* Samples with increasing values -- Front is the minimum */
+    SWindowRing max;        /* Samples with decreasing values -- Front is the maximum */
+} SWindow;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a sliding window
+    @param window  The allocated SWindow structure
+    @param kind    SWINDOW_COUNT or SWINDOW_TIME
+    @param span    The number of samples (SWINDOW_COUNT) or the length of time (SWINDOW_TIME) the window covers
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must call this function before window can be used
+      - Count windows allocate their whole ring up front; time windows grow as needed
+      - Complexity: O(1)
+*/
+int swindow_init(SWindow *window, int kind, uint64_t span);
+
+
+/* Destroy a sliding window
+    @param window  The window to be destroyed
+
+    Notes:
+      - Complexity: O(1)
+*/
+void swindow_destroy(SWindow *window);
+
+
+/* Add a sample, evicting the samples that fall out of the window
+    @param window  The SWindow structure
+    @param stamp   The timestamp of the sample (ignored by count windows)
+    @param value   The value of the sample
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - Time windows require stamps that never decrease
+      - Complexity: O(1) amortized
+*/
+int swindow_add(SWindow *window, uint64_t stamp, double value);
+
+
+/* Add an array of samples
+    @param window  The SWindow structure
+    @param stamps  The timestamps of the samples (may be NULL for count windows)
+    @param values  The values of the samples, oldest first
+    @param count   The number of samples
+
+    @return 0 if successful, -1 otherwise
+
+    Notes:
+      - A count window only ever sees the last span samples of a batch, and skips the rest outright
+      - Complexity: O(count) amortized
+*/
+int swindow_add_n(SWindow *window, const uint64_t *stamps, const double *values, int count);
+
+
+/* Evict the samples of a time window that are too old at a given time
+    @param window  The SWindow structure
+    @param now     The current time (not before the newest stamp)
+
+    Notes:
+      - Lets a time window shrink while no samples arrive -- Does nothing for count windows
+      - Complexity: O(1) amortized
+*/
+void swindow_expire(SWindow *window, uint64_t now);
+
+
+/* Minimum of the window
+    @param window  The SWindow structure
+    @param min     Set to the smallest value in the window
+
+    @return 0 if successful, -1 if the window is empty
+
+    Notes:
+      - Complexity: O(1)
+*/
+int swindow_min(const SWindow *window, double *min);
+
+
+/* Maximum of the window
+    @param window  The SWindow structure
+    @param max     Set to the largest value in the window
+
+    @return 0 if successful, -1 if the window is empty
+
+    Notes:
+      - Complexity: O(1)
+*/
+int swindow_max(const SWindow *window, double *max);
+
+
+/* Mean of the window
+    @param window  The SWindow structure
+    @param mean    Set to the mean of the values in the window
+
+    @return 0 if successful, -1 if the window is empty
+
+    Notes:
+      - Complexity: O(1)
+*/
+int swindow_mean(const SWindow *window, double *mean);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of samples in the window */
+#define swindow_count(window) ((window)->samples.size)
+
+/* Sum of the values in the window (0 when empty) */
+#define swindow_sum(window) ((window)->sum + (window)->compensation)
+
+#endif
@@ -0,0 +1,159 @@
+/* Header for Timer Wheel */
+#ifndef TWHEEL_H
+#define TWHEEL_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Purpose:
+     - Hierarchical timing wheel (Varghese and Lauck, SOSP 1987) for large numbers of timeouts that are mostly cancelled
+     - Each level is a ring of TWHEEL_SLOTS buckets, and each bucket a circular doubly-linked list (in the spirit of clist.h)
+       closed by a sentinel, so a timer is scheduled or cancelled by linking or unlinking one node
+     - Level 0 buckets hold one tick each; a bucket of level l spans TWHEEL_SLOTS^l ticks, and its timers cascade
+       down a level when the wheel below wraps around to it
+     - Timer nodes come from a pool that grows in chunks of TWHEEL_POOL_CHUNK and recycles cancelled and fired nodes
+*/
+
+
+/*
+********************************************
+        Timer and Wheel Definitions
+********************************************
+*/
+
+/* Buckets per level (a power of two) and number of levels -- Delays up to 2^32 ticks are placed exactly */
+#define TWHEEL_BITS 8
+#define TWHEEL_SLOTS (1 << TWHEEL_BITS)
+#define TWHEEL_LEVELS 4
+
+/* Timer nodes allocated at once when the pool runs out */
+#define TWHEEL_POOL_CHUNK 256
+
+
+/* Struct linking a timer into a bucket (also used as the bucket's sentinel) */
+typedef struct TWheelLink_ {
+    struct TWheelLink_ *prev;
+    struct TWheelLink_ *next;
+} TWheelLink;
+
+
+/* Struct representing a scheduled timer */
+typedef struct TWheelTimer_ {
+    TWheelLink link;                /* Bucket membership -- Must stay the first member */
+    uint64_t expires;               /* Tick at which the timer fires */
+    int level;                      /* Level of the bucket holding the timer */
+    void (*expire)(void *arg);      /* Function called when the timer fires */
+    void *arg;                      /* Argument passed to expire */
+} TWheelTimer;
+
+
+/* Struct representing a block of pooled timer nodes */
+typedef struct TWheelChunk_ {
+    struct TWheelChunk_ *next;
+    TWheelTimer timers[TWHEEL_POOL_CHUNK];
+} TWheelChunk;
+
+
+/* Struct representing timer wheel */
+typedef struct TWheel_ {
+    uint64_t now;                                   /* Current tick */
+    int pending;                                    /* Number of timers scheduled and not yet fired or cancelled */
+    int counts[TWHEEL_LEVELS];                      /* Number of timers in each level */
+
+    TWheelLink buckets[TWHEEL_LEVELS][TWHEEL_SLOTS];    /* Sentinels of the bucket lists */
+
+    TWheelChunk *chunks;                            /* Every chunk allocated for the pool */
+    TWheelTimer *free;                              /* Unused nodes, chained through link.next */
+} TWheel;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a timer wheel
+    @param wheel  The allocated TWheel structure
+    @param now    The tick the wheel starts at
+
+    Notes:
+      - Must call this function before wheel can be used
+      - No nodes are allocated until the first timer is scheduled
+      - Complexity: O(TWHEEL_LEVELS * TWHEEL_SLOTS)
+*/
+void twheel_init(TWheel *wheel, uint64_t now);
+
+
+/* Destroy a timer wheel
+    @param wheel  The wheel to be destroyed
+
+    Notes:
+      - Timers still pending are dropped without being fired
+      - Complexity: O(number of chunks)
+*/
+void twheel_destroy(TWheel *wheel);
+
+
+/* Schedule a timer
+    @param wheel   The TWheel structure
+    @param delay   Number of ticks from now until the timer fires (a delay of 0 fires on the next tick)
+    @param expire  Function called with arg when the timer fires
+    @param arg     Argument passed to expire
+
+    @return The timer, used to cancel it, or NULL if no node could be allocated
+
+    Notes:
+      - The timer belongs to the wheel -- It must not be used once it has fired or been cancelled
+      - Delays beyond the range of the top level wait in its furthest bucket and are placed again on each cascade
+      - Complexity: O(1) (amortized over pool growth)
+*/
+TWheelTimer *twheel_schedule(TWheel *wheel, uint64_t delay, void (*expire)(void *arg), void *arg);
+
+
+/* Cancel a pending timer
+    @param wheel  The TWheel structure
+    @param timer  A timer returned by twheel_schedule() that has not fired or been cancelled
+
+    Notes:
+      - The node goes back to the pool
+      - Complexity: O(1)
+*/
+void twheel_cancel(TWheel *wheel, TWheelTimer *timer);
+
+
+/* Advance the wheel, firing every timer that comes due
+    @param wheel  The TWheel structure
+    @param ticks  Number of ticks to advance
+
+    @return The number of timers fired
+
+    Notes:
+      - Timers due on the same tick fire in no particular order
+      - expire may schedule and cancel timers -- A timer scheduled with delay 0 fires on the following tick
+      - Jumps over stretches where the lower levels are empty, straight to the next tick that can cascade
+      - Complexity: O(ticks + timers fired) amortized, each timer cascading at most TWHEEL_LEVELS - 1 times
+*/
+int twheel_advance(TWheel *wheel, uint64_t ticks);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Current tick */
+#define twheel_now(wheel) ((wheel)->now)
+
+/* Number of timers pending */
+#define twheel_pending(wheel) ((wheel)->pending)
+
+/* Tick at which a timer fires */
+#define twheel_expires(timer) ((timer)->expires)
+
+#endif
@@ -0,0 +1,168 @@
+/* Header for Unrolled Linked List */
+#ifndef ULIST_H
+#define ULIST_H
+
+#include <stdlib.h>
+
+/* Purpose:
+     - A List (see list.h) spends one node, and so one likely cache miss, on every element
+     - An unrolled list stores a small array of data pointers in each node, so a scan touches one node per ULIST_SLOTS elements
+     - Nodes are split when an insert lands in a full node, and merged with their successor when a remove leaves them under half full
+*/
+
+
+/*
+********************************************
+        Element and List Definitions
+********************************************
+*/
+
+/* Number of data pointers per node -- With the header, a node is 128 bytes (two cache lines) on 64-bit targets */
+#define ULIST_SLOTS 14
+
+
+/* Struct representing node of an unrolled linked list */
+typedef struct UListNode_ {
+    struct UListNode_ *next;    /* Next node in list */
+    int count;                  /* Number of slots in use */
+    void *data[ULIST_SLOTS];    /* Data members, packed at the front of the array */
+} UListNode;
+
+
+/* Struct representing unrolled linked list */
+typedef struct UList_ {
+    int size;                       /* Number of elements */
+    int nodes;                      /* Number of nodes */
+
+    void (*destroy)(void *data);    /* Function that can be used for deallocation (e.g., free()) */
+
+    UListNode *head;                /* First node */
+    UListNode *tail;                /* Last node */
+} UList;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize an unrolled linked list
+    @param list     The allocated UList structure
+    @param destroy  Pointer to function that will be used for deallocation
+
+    Notes:
+      - Must call this function before list can be used
+      - If list contains data that should not be freed, set destroy to NULL
+      - Complexity: O(1)
+*/
+void ulist_init(UList *list, void (*destroy)(void *data));
+
+
+/* Destroy an unrolled linked list
+    @param list  The list to be destroyed
+
+    Notes:
+      - Calls the function passed as destroy to ulist_init() once for each element
+      - Complexity: O(n)
+*/
+void ulist_destroy(UList *list);
+
+
+/* Insert an element at the tail of the list
+    @param list  The UList structure
+    @param data  The data to be inserted
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - Appending fills the tail node completely before a new node is allocated
+      - Complexity: O(1)
+*/
+int ulist_append(UList *list, const void *data);
+
+
+/* Insert an element at the head of the list
+    @param list  The UList structure
+    @param data  The data to be inserted
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - Shifts at most ULIST_SLOTS pointers within the head node
+      - Complexity: O(1)
+*/
+int ulist_prepend(UList *list, const void *data);
+
+
+/* Insert an element at a given position
+    @param list      The UList structure
+    @param position  The position the new element will occupy (0 is the head, ulist_size(list) is the tail)
+    @param data      The data to be inserted
+
+    @return 0 if insertion successful, -1 otherwise
+
+    Notes:
+      - If the node holding position is full, it is split in half first
+      - Complexity: O(n / ULIST_SLOTS) to find the node
+*/
+int ulist_insert(UList *list, int position, const void *data);
+
+
+/* Remove the element at a given position
+    @param list      The UList structure
+    @param position  The position of the element to remove
+    @param data      The data of the removed element
+
+    @return 0 if removal successful, -1 otherwise
+
+    Notes:
+      - Upon return, data points to the data of the removed element
+      - A node left less than half full absorbs its successor when both fit in one node
+      - It is the responsibility of the caller to deal with the storage associated with the data
+      - Complexity: O(n / ULIST_SLOTS) to find the node
+*/
+int ulist_remove(UList *list, int position, void **data);
+
+
+/* Get the element at a given position
+    @param list      The UList structure
+    @param position  The position of the element
+
+    @return The data at position, or NULL if position is out of range
+
+    Notes:
+      - Complexity: O(n / ULIST_SLOTS)
+*/
+void *ulist_get(const UList *list, int position);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of elements in list */
+#define ulist_size(list) ((list)->size)
+
+/* Node at head of the list */
+#define ulist_head(list) ((list)->head)
+
+/* Node at tail of the list */
+#define ulist_tail(list) ((list)->tail)
+
+/* Node following specified node */
+#define ulist_next(node) ((node)->next)
+
+/* Number of elements stored in the node */
+#define ulist_count(node) ((node)->count)
+
+/* Data stored in slot i of the node (0 <= i < ulist_count(node)) */
+#define ulist_data(node, i) ((node)->data[(i)])
+
+#endif
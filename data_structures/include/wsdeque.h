@@ -0,0 +1,137 @@
+/* Header for Work-Stealing Deque */
+#ifndef WSDEQUE_H
+#define WSDEQUE_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Purpose:
+     - Chase-Lev deque for work-stealing schedulers, with the C11 orderings of Le, Pop, Cohen and Zappa Nardelli (PPoPP 2013)
+     - One owner thread pushes and pops at the bottom (LIFO), and needs no atomic read-modify-write on its fast path
+     - Any number of thief threads steal from the top (FIFO), each steal costing one CAS on top
+     - The ring grows by doubling when the owner finds it full -- Old rings stay allocated until wsdeque_destroy(),
+       since a thief may still be reading one (together they never use more than the current ring)
+*/
+
+
+/*
+********************************************
+        Ring and Deque Definitions
+********************************************
+*/
+
+/* Size of a cache line -- Used to keep the owner's and the thieves' indices apart */
+#define WSDEQUE_CACHE_LINE 64
+
+
+/* Struct representing the circular array behind a deque */
+typedef struct WSDequeRing_ {
+    long capacity;                  /* Number of slots (a power of two) */
+    struct WSDequeRing_ *retired;   /* Ring this one replaced, kept until the deque is destroyed */
+    _Atomic(void *) slots[];        /* Slots, indexed by position & (capacity - 1) */
+} WSDequeRing;
+
+
+/* Struct representing work-stealing deque */
+typedef struct WSDeque_ {
+    _Alignas(WSDEQUE_CACHE_LINE) atomic_long top;       /* Next position to steal -- Advanced by thieves (and the owner on the last element) */
+    _Alignas(WSDEQUE_CACHE_LINE) atomic_long bottom;    /* Next position to push -- Written only by the owner */
+    _Atomic(WSDequeRing *) ring;                        /* Current circular array */
+} WSDeque;
+
+
+
+
+/*
+*********************************
+        Interface Methods
+*********************************
+*/
+
+/* Initialize a work-stealing deque
+    @param deque     The allocated WSDeque structure
+    @param capacity  The initial number of slots
+
+    @return 0 if initialization successful, -1 otherwise
+
+    Notes:
+      - Must be called before the deque is shared between threads
+      - capacity is rounded up to a power of two
+      - Complexity: O(1)
+*/
+int wsdeque_init(WSDeque *deque, long capacity);
+
+
+/* Destroy a work-stealing deque
+    @param deque  The deque to be destroyed
+
+    Notes:
+      - Frees the current ring and every ring it replaced -- Elements still in the deque are not touched
+      - Must not be called while any thread may still use the deque
+      - Complexity: O(number of rings)
+*/
+void wsdeque_destroy(WSDeque *deque);
+
+
+/* Push an element at the bottom (owner thread only)
+    @param deque  The WSDeque structure
+    @param data   The data to be pushed
+
+    @return 0 if successful, -1 if the ring was full and could not grow
+
+    Notes:
+      - It is the responsibility of the caller to manage the storage associated with data
+      - Complexity: O(1) amortized
+*/
+int wsdeque_push(WSDeque *deque, const void *data);
+
+
+/* Pop the element at the bottom (owner thread only)
+    @param deque  The WSDeque structure
+    @param data   The data of the popped element
+
+    @return 0 if successful, -1 if the deque is empty
+
+    Notes:
+      - Only synchronizes with thieves (one CAS) when taking the last element
+      - Complexity: O(1)
+*/
+int wsdeque_pop(WSDeque *deque, void **data);
+
+
+/* Steal the element at the top (any thread)
+    @param deque  The WSDeque structure
+    @param data   The data of the stolen element
+
+    @return 0 if successful, -1 if the deque is empty, 1 if another thread won the race (the caller may retry)
+
+    Notes:
+      - Complexity: O(1)
+*/
+int wsdeque_steal(WSDeque *deque, void **data);
+
+
+/* Number of elements in the deque
+    @param deque  The WSDeque structure
+
+    @return The number of elements in the deque
+
+    Notes:
+      - Only a snapshot while other threads are running
+      - Complexity: O(1)
+*/
+long wsdeque_size(const WSDeque *deque);
+
+
+
+
+/*
+*****************************
+        Useful Macros
+*****************************
+*/
+
+/* Number of slots in the current ring */
+#define wsdeque_capacity(deque) (atomic_load_explicit(&(deque)->ring, memory_order_relaxed)->capacity)
+
+#endif
@@ -0,0 +1,238 @@
+/* Implementation of Blocking Queue */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "bqueue.h"
+
+
+/* Absolute CLOCK_MONOTONIC time timeout_ms from now */
+static void bqueue_deadline(struct timespec *deadline, int timeout_ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+
+    deadline->tv_sec += timeout_ms / 1000;
+    deadline->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if(deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+
+/* Sleep on cond until signaled or deadline (NULL for no deadline) -- Returns ETIMEDOUT once the deadline has passed */
+static int bqueue_wait(BQueue *queue, pthread_cond_t *cond, int *waiters, const struct timespec *deadline)
+{
+    int error;
+
+    (*waiters)++;
+    if(deadline == NULL)
+        error = pthread_cond_wait(cond, &queue->mutex);
+    else
+        error = pthread_cond_timedwait(cond, &queue->mutex, deadline);
+    (*waiters)--;
+
+    return error;
+}
+
+
+/* Wait (mutex held) until the queue has an element or is closed -- Returns 0 if an element is there, 1 on timeout, -1 if closed and empty */
+static int bqueue_wait_not_empty(BQueue *queue, int timeout_ms)
+{
+    struct timespec deadline;
+
+    if(timeout_ms > 0)
+        bqueue_deadline(&deadline, timeout_ms);
+
+    while(queue_size(&queue->queue) == 0)
+    {
+        if(queue->closed)
+            return -1;
+
+        if(timeout_ms == 0)
+            return 1;
+
+        if(bqueue_wait(queue, &queue->not_empty, &queue->pop_waiters, (timeout_ms > 0) ? &deadline : NULL) == ETIMEDOUT)
+        {
+            /* The element may have arrived along with the timeout */
+            if(queue_size(&queue->queue) > 0)
+                return 0;
+
+            return queue->closed ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/* Update the throttle after a pop (mutex held), releasing the producers once the queue drains to the low watermark */
+static void bqueue_popped(BQueue *queue)
+{
+    if(queue->throttled && queue_size(&queue->queue) <= queue->low_watermark)
+    {
+        queue->throttled = 0;
+        if(queue->push_waiters > 0)
+            pthread_cond_broadcast(&queue->not_full);
+    }
+}
+
+
+/* Initialize a blocking queue */
+int bqueue_init(BQueue *queue, int high_watermark, int low_watermark, void (*destroy)(void *data))
+{
+    pthread_condattr_t attr;
+
+    if(low_watermark < 0 || low_watermark >= high_watermark)
+        return -1;
+
+    /* Allocate the whole ring up front so a push never reallocates under the lock */
+    queue_init(&queue->queue, destroy);
+    if(queue_reserve(&queue->queue, high_watermark) != 0)
+        return -1;
+
+    queue->high_watermark = high_watermark;
+    queue->low_watermark = low_watermark;
+    queue->throttled = 0;
+    queue->closed = 0;
+    queue->pop_waiters = 0;
+    queue->push_waiters = 0;
+
+    /* Timed waits measure against the monotonic clock, so wall clock changes cannot stretch them */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->not_empty, &attr);
+    pthread_cond_init(&queue->not_full, &attr);
+
+    pthread_condattr_destroy(&attr);
+
+    return 0;
+}
+
+
+/* Destroy a blocking queue */
+void bqueue_destroy(BQueue *queue)
+{
+    queue_destroy(&queue->queue);
+
+    pthread_cond_destroy(&queue->not_full);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_mutex_destroy(&queue->mutex);
+
+    /* To be safe, clear the structure */
+    memset(queue, 0, sizeof(BQueue));
+}
+
+
+/* Push an element, blocking while the queue is throttled */
+int bqueue_push(BQueue *queue, const void *data, int timeout_ms)
+{
+    struct timespec deadline;
+    int retval = 0;
+
+    if(timeout_ms > 0)
+        bqueue_deadline(&deadline, timeout_ms);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while(queue->throttled && !queue->closed)
+    {
+        if(timeout_ms == 0 || bqueue_wait(queue, &queue->not_full, &queue->push_waiters, (timeout_ms > 0) ? &deadline : NULL) == ETIMEDOUT)
+        {
+            /* Give the throttle one last look, it may have lifted along with the timeout */
+            if(queue->throttled && !queue->closed)
+                retval = 1;
+            break;
+        }
+    }
+
+    if(retval == 0)
+    {
+        if(queue->closed)
+            retval = -1;
+        else if(queue_push(&queue->queue, data) != 0)
+            retval = -1;
+        else
+        {
+            if(queue_size(&queue->queue) >= queue->high_watermark)
+                queue->throttled = 1;
+
+            if(queue->pop_waiters > 0)
+                pthread_cond_signal(&queue->not_empty);
+        }
+    }
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return retval;
+}
+
+
+/* Pop an element, blocking while the queue is empty */
+int bqueue_pop(BQueue *queue, void **data, int timeout_ms)
+{
+    pthread_mutex_lock(&queue->mutex);
+
+    int retval = bqueue_wait_not_empty(queue, timeout_ms);
+    if(retval == 0)
+    {
+        queue_pop(&queue->queue, data);
+        bqueue_popped(queue);
+    }
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return retval;
+}
+
+
+/* Pop up to max_n elements under a single lock acquisition */
+int bqueue_pop_batch(BQueue *queue, void **data, int max_n, int timeout_ms)
+{
+    if(max_n <= 0)
+        return 0;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    int retval = bqueue_wait_not_empty(queue, timeout_ms);
+    if(retval == 0)
+    {
+        retval = queue_pop_n(&queue->queue, data, max_n);
+        bqueue_popped(queue);
+    }
+    else if(retval == 1)
+        retval = 0;
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return retval;
+}
+
+
+/* Close the queue */
+void bqueue_close(BQueue *queue)
+{
+    pthread_mutex_lock(&queue->mutex);
+
+    queue->closed = 1;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_cond_broadcast(&queue->not_full);
+
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+
+/* Number of elements in the queue */
+int bqueue_size(BQueue *queue)
+{
+    pthread_mutex_lock(&queue->mutex);
+    int size = queue_size(&queue->queue);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return size;
+}
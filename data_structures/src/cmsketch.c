@@ -0,0 +1,174 @@
+/* Implementation of Count-Min Sketch */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "cmsketch.h"
+
+#define CMSKETCH_MAX_DEPTH 32
+#define CMSKETCH_BLOCK 16
+
+
+/* Mix a key (splitmix64 finalizer) -- The halves seed the rows' hashes */
+static uint64_t cmsketch_hash(uint64_t key)
+{
+    key += 0x9e3779b97f4a7c15ULL;
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+
+    return key;
+}
+
+
+/* Counter offsets of a key, one per row -- Row i uses h1 + i * h2 (Kirsch and Mitzenmacher), h2 odd so rows differ */
+static void cmsketch_offsets(const CMSketch *sketch, uint64_t key, uint32_t *offsets)
+{
+    uint64_t hash = cmsketch_hash(key);
+    uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+    uint32_t mask = (uint32_t)sketch->width - 1;
+
+    for(int i = 0; i < sketch->depth; i++)
+        offsets[i] = (uint32_t)i * (uint32_t)sketch->width + ((h1 + (uint32_t)i * h2) & mask);
+}
+
+
+/* Raise a key's counters to at least its new estimate, and no further */
+static void cmsketch_update(CMSketch *sketch, const uint32_t *offsets, uint64_t count)
+{
+    uint32_t *counters = sketch->counters;
+    uint64_t smallest = UINT32_MAX;
+
+    for(int i = 0; i < sketch->depth; i++)
+        if(counters[offsets[i]] < smallest)
+            smallest = counters[offsets[i]];
+
+    uint64_t target = smallest + count;
+    if(target > UINT32_MAX)
+        target = UINT32_MAX;
+
+    for(int i = 0; i < sketch->depth; i++)
+        if(counters[offsets[i]] < target)
+            counters[offsets[i]] = (uint32_t)target;
+}
+
+
+/* Initialize a count-min sketch */
+int cmsketch_init(CMSketch *sketch, double epsilon, double delta)
+{
+    if(epsilon <= 0.0 || epsilon >= 1.0 || delta <= 0.0 || delta >= 1.0)
+        return -1;
+
+    /* Smallest power of two of at least e / epsilon */
+    double wanted = 2.718281828459045 / epsilon;
+    int width = 1;
+    while(width < wanted)
+    {
+        if(width >= (1 << 28))
+            return -1;
+        width <<= 1;
+    }
+
+    /* Smallest depth with e^-depth <= delta */
+    int depth = 1;
+    double bound = 1.0 / 2.718281828459045;
+    while(bound > delta && depth < CMSKETCH_MAX_DEPTH)
+    {
+        bound /= 2.718281828459045;
+        depth++;
+    }
+
+    sketch->width = width;
+    sketch->depth = depth;
+    sketch->total = 0;
+    sketch->counters = calloc((size_t)width * depth, sizeof(uint32_t));
+
+    if(sketch->counters == NULL)
+        return -1;
+
+    return 0;
+}
+
+
+/* Destroy a count-min sketch */
+void cmsketch_destroy(CMSketch *sketch)
+{
+    free(sketch->counters);
+
+    /* To be safe, clear the structure */
+    memset(sketch, 0, sizeof(CMSketch));
+}
+
+
+/* Count occurrences of a key (conservative update) */
+void cmsketch_add(CMSketch *sketch, uint64_t key, uint64_t count)
+{
+    uint32_t offsets[CMSKETCH_MAX_DEPTH];
+
+    cmsketch_offsets(sketch, key, offsets);
+    cmsketch_update(sketch, offsets, count);
+    sketch->total += count;
+}
+
+
+/* Count occurrences of an array of keys */
+void cmsketch_add_n(CMSketch *sketch, const uint64_t *keys, const uint64_t *counts, int n)
+{
+    uint32_t offsets[CMSKETCH_BLOCK][CMSKETCH_MAX_DEPTH];
+
+    for(int start = 0; start < n; start += CMSKETCH_BLOCK)
+    {
+        int block = (n - start < CMSKETCH_BLOCK) ? n - start : CMSKETCH_BLOCK;
+
+        /* Hash the whole block first, touching each counter it will need */
+        for(int j = 0; j < block; j++)
+        {
+            cmsketch_offsets(sketch, keys[start + j], offsets[j]);
+            for(int i = 0; i < sketch->depth; i++)
+                __builtin_prefetch(&sketch->counters[offsets[j][i]], 1);
+        }
+
+        for(int j = 0; j < block; j++)
+        {
+            uint64_t count = (counts != NULL) ? counts[start + j] : 1;
+            cmsketch_update(sketch, offsets[j], count);
+            sketch->total += count;
+        }
+    }
+}
+
+
+/* Estimate the occurrences of a key */
+uint64_t cmsketch_estimate(const CMSketch *sketch, uint64_t key)
+{
+    uint32_t offsets[CMSKETCH_MAX_DEPTH];
+    uint32_t smallest = UINT32_MAX;
+
+    cmsketch_offsets(sketch, key, offsets);
+    for(int i = 0; i < sketch->depth; i++)
+        if(sketch->counters[offsets[i]] < smallest)
+            smallest = sketch->counters[offsets[i]];
+
+    return smallest;
+}
+
+
+/* Merge another sketch into this one */
+int cmsketch_merge(CMSketch *sketch, const CMSketch *other)
+{
+    if(sketch->width != other->width || sketch->depth != other->depth)
+        return -1;
+
+    size_t size = (size_t)sketch->width * sketch->depth;
+    for(size_t i = 0; i < size; i++)
+    {
+        uint64_t sum = (uint64_t)sketch->counters[i] + other->counters[i];
+        sketch->counters[i] = (sum > UINT32_MAX) ? UINT32_MAX : (uint32_t)sum;
+    }
+
+    sketch->total += other->total;
+
+    return 0;
+}
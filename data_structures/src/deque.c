@@ -0,0 +1,226 @@
+/* Implementation of Deque */
+#include <stdlib.h>
+#include <string.h>
+
+#include "deque.h"
+
+/* Number of map entries of the first allocation */
+#define DEQUE_MIN_MAP 8
+
+
+/* Get a block, reusing the spare if there is one */
+static void **deque_block_new(Deque *deque)
+{
+    void **block = deque->spare;
+
+    if(block != NULL)
+    {
+        deque->spare = NULL;
+        return block;
+    }
+
+    return malloc(DEQUE_BLOCK * sizeof(void *));
+}
+
+
+/* Give back a block that no longer holds elements */
+static void deque_block_release(Deque *deque, void **block)
+{
+    if(deque->spare == NULL)
+        deque->spare = block;
+    else
+        free(block);
+}
+
+
+/* Make room in the map for one more block at either end, recentering the blocks in use or doubling the map */
+static int deque_remap(Deque *deque)
+{
+    int needed = deque->blocks + 1;
+
+    if(deque->map_capacity >= 2 * needed)
+    {
+        /* Plenty of room overall, it is just on the wrong side */
+        int first = (deque->map_capacity - deque->blocks) / 2;
+        memmove(&deque->map[first], &deque->map[deque->first], deque->blocks * sizeof(void **));
+        deque->first = first;
+        return 0;
+    }
+
+    int capacity = (deque->map_capacity > 0) ? 2 * deque->map_capacity : DEQUE_MIN_MAP;
+    while(capacity < 2 * needed)
+        capacity *= 2;
+
+    void ***map = malloc(capacity * sizeof(void **));
+    if(map == NULL)
+        return -1;
+
+    int first = (capacity - deque->blocks) / 2;
+    if(deque->blocks > 0)
+        memcpy(&map[first], &deque->map[deque->first], deque->blocks * sizeof(void **));
+
+    free(deque->map);
+    deque->map = map;
+    deque->map_capacity = capacity;
+    deque->first = first;
+
+    return 0;
+}
+
+
+/* Release the last block once the deque runs empty, and center the map for either end */
+static void deque_emptied(Deque *deque)
+{
+    deque_block_release(deque, deque->map[deque->first]);
+    deque->blocks = 0;
+    deque->head = 0;
+    deque->first = deque->map_capacity / 2;
+}
+
+
+/* Initialize a deque */
+void deque_init(Deque *deque, void (*destroy)(void *data))
+{
+    deque->size = 0;
+    deque->head = 0;
+    deque->destroy = destroy;
+    deque->map = NULL;
+    deque->map_capacity = 0;
+    deque->first = 0;
+    deque->blocks = 0;
+    deque->spare = NULL;
+}
+
+
+/* Destroy a deque */
+void deque_destroy(Deque *deque)
+{
+    /* If the user supplied a destroy function, apply it to each element from the front */
+    if(deque->destroy != NULL)
+    {
+        for(int i = 0; i < deque->size; i++)
+            deque->destroy(deque_item(deque, i));
+    }
+
+    for(int i = 0; i < deque->blocks; i++)
+        free(deque->map[deque->first + i]);
+
+    free(deque->spare);
+    free(deque->map);
+
+    /* To be safe, clear the structure */
+    memset(deque, 0, sizeof(Deque));
+}
+
+
+/* Push an element at the front of the deque */
+int deque_push_front(Deque *deque, const void *data)
+{
+    /* The first block is full up to its start -- Add a block before it */
+    if(deque->head == 0)
+    {
+        if( (deque->first == 0) && (deque_remap(deque) != 0) )
+            return -1;
+
+        void **block = deque_block_new(deque);
+        if(block == NULL)
+            return -1;
+
+        deque->map[--deque->first] = block;
+        deque->blocks++;
+        deque->head = DEQUE_BLOCK;
+    }
+
+    deque->map[deque->first][--deque->head] = (void *)data;
+    deque->size++;
+
+    return 0;
+}
+
+
+/* Push an element at the back of the deque */
+int deque_push_back(Deque *deque, const void *data)
+{
+    int position = deque->head + deque->size;
+
+    /* The last block is full -- Add a block after it */
+    if(position == deque->blocks * DEQUE_BLOCK)
+    {
+        if( (deque->first + deque->blocks >= deque->map_capacity) && (deque_remap(deque) != 0) )
+            return -1;
+
+        void **block = deque_block_new(deque);
+        if(block == NULL)
+            return -1;
+
+        deque->map[deque->first + deque->blocks] = block;
+        deque->blocks++;
+    }
+
+    deque->map[deque->first + (position >> DEQUE_BLOCK_SHIFT)][position & (DEQUE_BLOCK - 1)] = (void *)data;
+    deque->size++;
+
+    return 0;
+}
+
+
+/* Pop the element at the front of the deque */
+int deque_pop_front(Deque *deque, void **data)
+{
+    if(deque->size == 0)
+        return -1;
+
+    *data = deque->map[deque->first][deque->head];
+    deque->head++;
+    deque->size--;
+
+    if(deque->size == 0)
+        deque_emptied(deque);
+    else if(deque->head == DEQUE_BLOCK)
+    {
+        /* Walked off the end of the first block */
+        deque_block_release(deque, deque->map[deque->first]);
+        deque->first++;
+        deque->blocks--;
+        deque->head = 0;
+    }
+
+    return 0;
+}
+
+
+/* Pop the element at the back of the deque */
+int deque_pop_back(Deque *deque, void **data)
+{
+    if(deque->size == 0)
+        return -1;
+
+    deque->size--;
+    int position = deque->head + deque->size;
+    *data = deque->map[deque->first + (position >> DEQUE_BLOCK_SHIFT)][position & (DEQUE_BLOCK - 1)];
+
+    if(deque->size == 0)
+        deque_emptied(deque);
+    else if((position & (DEQUE_BLOCK - 1)) == 0)
+    {
+        /* Emptied the last block */
+        deque->blocks--;
+        deque_block_release(deque, deque->map[deque->first + deque->blocks]);
+    }
+
+    return 0;
+}
+
+
+/* Get a block of contiguous elements */
+int deque_block(const Deque *deque, int block, void ***data)
+{
+    int start = (block == 0) ? deque->head : 0;
+    int end = deque->head + deque->size - block * DEQUE_BLOCK;
+
+    if(end > DEQUE_BLOCK)
+        end = DEQUE_BLOCK;
+
+    *data = &deque->map[deque->first + block][start];
+    return end - start;
+}
@@ -175,3 +175,126 @@ int dlist_remove(DList *list, DListElement *element, void **data)
     /* If we get here, we are successful so return 0 */
     return 0;
 }
+
+
+/* Move every element of another list into this one */
+int dlist_splice(DList *list, DListElement *element, DList *other)
+{
+    if(list == other)
+        return -1;
+
+    /* Nothing to move */
+    if(dlist_size(other) == 0)
+        return 0;
+
+    /* Handle splice at head of the list (or into an empty list) */
+    if(element == NULL)
+    {
+        other->tail->next = list->head;
+
+        if(dlist_size(list) == 0)
+            list->tail = other->tail;
+        else
+            list->head->prev = other->tail;
+
+        list->head = other->head;
+    }
+    /* Handle splice elsewhere */
+    else
+    {
+        other->tail->next = element->next;
+        other->head->prev = element;
+
+        if(element->next == NULL)
+            list->tail = other->tail;
+        else
+            element->next->prev = other->tail;
+
+        element->next = other->head;
+    }
+
+    /* Update the sizes and leave other empty */
+    list->size += other->size;
+    other->size = 0;
+    other->head = NULL;
+    other->tail = NULL;
+
+    return 0;
+}
+
+
+/* Merge two sorted NULL-terminated chains through their next links -- Ties are taken from left, which holds the earlier elements */
+static DListElement *dlist_merge(DListElement *left, DListElement *right, int (*compare)(const void *key1, const void *key2))
+{
+    DListElement *head = NULL, **link = &head;
+
+    while( (left != NULL) && (right != NULL) )
+    {
+        if(compare(left->data, right->data) <= 0)
+        {
+            *link = left;
+            left = left->next;
+        }
+        else
+        {
+            *link = right;
+            right = right->next;
+        }
+        link = &(*link)->next;
+    }
+
+    *link = (left != NULL) ? left : right;
+    return head;
+}
+
+
+/* Sort the list in place */
+int dlist_sort(DList *list, int (*compare)(const void *key1, const void *key2))
+{
+    if(compare == NULL)
+        return -1;
+    if(dlist_size(list) < 2)
+        return 0;
+
+    /* bins[i] holds a sorted chain built from 2^i runs (as in a binary counter), so 32 bins cover any int-sized list */
+    DListElement *bins[32] = {NULL};
+    DListElement *element = list->head, *run, *merged;
+    int i;
+
+    while(element != NULL)
+    {
+        /* Cut the next natural ascending run off the front of the remaining elements */
+        run = element;
+        while( (element->next != NULL) && (compare(element->data, element->next->data) <= 0) )
+            element = element->next;
+        merged = run;
+        run = element->next;
+        element->next = NULL;
+        element = run;
+
+        /* Carry the run up through the occupied bins -- Bins hold earlier elements, so they go on the left */
+        for(i = 0; (i < 31) && (bins[i] != NULL); i++)
+        {
+            merged = dlist_merge(bins[i], merged, compare);
+            bins[i] = NULL;
+        }
+        bins[i] = (bins[i] == NULL) ? merged : dlist_merge(bins[i], merged, compare);
+    }
+
+    /* Merge the bins together -- Higher bins hold earlier elements */
+    merged = NULL;
+    for(i = 0; i < 32; i++)
+    {
+        if(bins[i] != NULL)
+            merged = (merged == NULL) ? bins[i] : dlist_merge(bins[i], merged, compare);
+    }
+
+    /* Relink the list, rebuilding the prev links and the tail */
+    list->head = merged;
+    merged->prev = NULL;
+    for(element = merged; element->next != NULL; element = element->next)
+        element->next->prev = element;
+    list->tail = element;
+
+    return 0;
+}
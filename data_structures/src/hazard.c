@@ -0,0 +1,194 @@
+/* Implementation of Hazard Pointers */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "hazard.h"
+
+
+/* Order pointers for qsort() and bsearch() */
+static int hazard_compare(const void *key1, const void *key2)
+{
+    uintptr_t a = (uintptr_t)*(void * const *)key1, b = (uintptr_t)*(void * const *)key2;
+    return (a > b) ? 1 : (a < b) ? -1 : 0;
+}
+
+
+/* Initialize a hazard pointer domain */
+void hazard_init(HazardDomain *domain, void (*reclaim)(void *ptr))
+{
+    atomic_init(&domain->records, NULL);
+    atomic_init(&domain->record_count, 0);
+    domain->reclaim = reclaim;
+}
+
+
+/* Destroy a hazard pointer domain */
+void hazard_destroy(HazardDomain *domain)
+{
+    HazardRecord *record = atomic_load(&domain->records), *next;
+
+    while(record != NULL)
+    {
+        /* No thread is running, so nothing is protected */
+        if(domain->reclaim != NULL)
+        {
+            for(int i = 0; i < record->retired_count; i++)
+                domain->reclaim(record->retired[i]);
+        }
+
+        next = record->next;
+        free(record->retired);
+        free(record);
+        record = next;
+    }
+
+    /* To be safe, clear the structure */
+    memset(domain, 0, sizeof(HazardDomain));
+}
+
+
+/* Acquire a record for the calling thread */
+HazardRecord *hazard_acquire(HazardDomain *domain)
+{
+    HazardRecord *record;
+
+    /* Reuse a released record if one can be claimed */
+    for(record = atomic_load(&domain->records); record != NULL; record = record->next)
+    {
+        int inactive = 0;
+        if( (atomic_load_explicit(&record->active, memory_order_relaxed) == 0) && atomic_compare_exchange_strong(&record->active, &inactive, 1) )
+            return record;
+    }
+
+    /* Otherwise allocate a new one and push it onto the domain's list */
+    if( (record = calloc(1, sizeof(HazardRecord))) == NULL )
+        return NULL;
+
+    for(int i = 0; i < HAZARD_SLOTS; i++)
+        atomic_init(&record->hazards[i], NULL);
+    atomic_init(&record->active, 1);
+    record->domain = domain;
+
+    HazardRecord *head = atomic_load(&domain->records);
+    do
+    {
+        record->next = head;
+    } while(!atomic_compare_exchange_weak(&domain->records, &head, record));
+    atomic_fetch_add(&domain->record_count, 1);
+
+    return record;
+}
+
+
+/* Release a record so another thread can acquire it */
+void hazard_release(HazardRecord *record)
+{
+    for(int i = 0; i < HAZARD_SLOTS; i++)
+        hazard_clear(record, i);
+
+    atomic_store_explicit(&record->active, 0, memory_order_release);
+}
+
+
+/* Load a shared pointer and protect it with a hazard slot */
+void *hazard_protect(HazardRecord *record, int slot, _Atomic(void *) *source)
+{
+    void *ptr = atomic_load_explicit(source, memory_order_relaxed), *check;
+
+    for(;;)
+    {
+        /* Publish, then make sure the pointer was still current after publishing -- seq_cst pairs with the scan */
+        atomic_store_explicit(&record->hazards[slot], ptr, memory_order_seq_cst);
+        check = atomic_load_explicit(source, memory_order_acquire);
+        if(check == ptr)
+            return ptr;
+        ptr = check;
+    }
+}
+
+
+/* Retire a pointer that has been unlinked from the shared structure */
+int hazard_retire(HazardRecord *record, void *ptr)
+{
+    /* Grow the retired list when full -- If that fails, a scan may still make room */
+    if(record->retired_count == record->retired_capacity)
+    {
+        int capacity = (record->retired_capacity > 0) ? 2 * record->retired_capacity : HAZARD_SCAN_MIN;
+        void **retired = realloc(record->retired, capacity * sizeof(void *));
+
+        if(retired != NULL)
+        {
+            record->retired = retired;
+            record->retired_capacity = capacity;
+        }
+        else if( (hazard_scan(record) == 0) && (record->retired_count == record->retired_capacity) )
+        {
+            return -1;
+        }
+    }
+
+    record->retired[record->retired_count++] = ptr;
+
+    /* Scan once enough pointers have piled up to make it worthwhile */
+    int threshold = 2 * HAZARD_SLOTS * atomic_load_explicit(&record->domain->record_count, memory_order_relaxed);
+    if(threshold < HAZARD_SCAN_MIN)
+        threshold = HAZARD_SCAN_MIN;
+    if(record->retired_count >= threshold)
+        hazard_scan(record);
+
+    return 0;
+}
+
+
+/* Reclaim every retired pointer of a record that no thread protects */
+int hazard_scan(HazardRecord *record)
+{
+    HazardDomain *domain = record->domain;
+    int capacity = 0, count = 0;
+
+    /* Records are never removed, so the list from one snapshot of its head stays valid -- Records pushed after
+       the snapshot belong to threads that started after our pointers were unlinked, so they cannot protect them */
+    atomic_thread_fence(memory_order_seq_cst);
+    HazardRecord *head = atomic_load(&domain->records);
+    for(HazardRecord *r = head; r != NULL; r = r->next)
+        capacity += HAZARD_SLOTS;
+
+    void **hazards = malloc(capacity * sizeof(void *));
+    if(hazards == NULL)
+        return 0;
+
+    /* Snapshot every published hazard */
+    for(HazardRecord *r = head; r != NULL; r = r->next)
+    {
+        for(int i = 0; i < HAZARD_SLOTS; i++)
+        {
+            void *ptr = atomic_load_explicit(&r->hazards[i], memory_order_seq_cst);
+            if(ptr != NULL)
+                hazards[count++] = ptr;
+        }
+    }
+    qsort(hazards, count, sizeof(void *), hazard_compare);
+
+    /* Reclaim what is not protected, and compact the rest to the front of the list */
+    int kept = 0, reclaimed = 0;
+    for(int i = 0; i < record->retired_count; i++)
+    {
+        void *ptr = record->retired[i];
+        if(bsearch(&ptr, hazards, count, sizeof(void *), hazard_compare) != NULL)
+        {
+            record->retired[kept++] = ptr;
+        }
+        else
+        {
+            if(domain->reclaim != NULL)
+                domain->reclaim(ptr);
+            reclaimed += 1;
+        }
+    }
+    record->retired_count = kept;
+
+    free(hazards);
+    return reclaimed;
+}
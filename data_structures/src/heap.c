@@ -19,6 +19,9 @@
 /* Get array index of right-child of node at index npos */
 #define heap_right(npos) (((npos) * 2) + 2)
 
+/* Number of slots of the first tree-array allocation */
+#define HEAP_MIN_CAPACITY 16
+
 
 
 
@@ -32,6 +35,7 @@
 void heap_init(Heap *heap, int (*compare)(const void *key1, const void *key2), void (*destroy)(void *data))
 {
     heap->size = 0;
+    heap->capacity = 0;
     heap->compare = compare;
     heap->destroy = destroy;
     heap->tree = NULL;
@@ -58,12 +62,17 @@ int heap_insert(Heap *heap, const void *data)
     /* Used as a temp pointer for allocation and swapping */
     void *temp;
     
-    /* Allocate storage for the new node and properly set the tree-array in heap */
-    temp = (void **)realloc(heap->tree, (heap_size(heap) + 1) * sizeof(void *));
-    if(temp == NULL)
-        return -1;
-    else
+    /* Grow the tree-array geometrically when it is full */
+    if(heap_size(heap) == heap->capacity)
+    {
+        int capacity = (heap->capacity > 0) ? heap->capacity * 2 : HEAP_MIN_CAPACITY;
+        temp = (void **)realloc(heap->tree, capacity * sizeof(void *));
+        if(temp == NULL)
+            return -1;
+
         heap->tree = temp;
+        heap->capacity = capacity;
+    }
 
     /* Insert the new node after the last node in the heap */
     heap->tree[heap_size(heap)] = (void *)data;
@@ -100,36 +109,19 @@ int heap_extract(Heap *heap, void **data)
     if(heap_size(heap) == 0)
         return -1;
 
-    /* Used as a temp pointer for allocation and swapping */
+    /* Used as a temp pointer for swapping */
     void *temp;
 
     /* Extract the node at the top of the heap (i.e., first element in tree-array) */
     *data = heap->tree[0];
 
-    /* Save the contents of the last node in the heap */
+    /* Save the contents of the last node in the heap -- The tree-array keeps its storage for later inserts */
     void *save = heap->tree[heap_size(heap) - 1];
+    heap->size -= 1;
 
-    /* Adjust the storage used by the heap */
-    if(heap_size(heap) - 1 > 0)
-    {
-        /* Reallocate the tree-array */
-        temp = (void **)realloc(heap->tree, (heap_size(heap) - 1) * sizeof(void *));
-        if(temp == NULL)
-            return -1;
-        else
-            heap->tree = temp;
-
-        /* Update the size */
-        heap->size -= 1;
-    }
     /* Handle the case when extracting the last (and only) node */
-    else
-    {
-        free(heap->tree);
-        heap->tree = NULL;
-        heap->size = 0;
+    if(heap_size(heap) == 0)
         return 0;
-    }
 
     /* Copy the saved node to the top of the heap */
     heap->tree[0] = save;
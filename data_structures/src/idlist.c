@@ -0,0 +1,129 @@
+/* Implementation of Intrusive Doubly Linked List */
+#include <stdlib.h>
+
+#include "idlist.h"
+
+/* Initialize an Intrusive Doubly Linked List */
+void idlist_init(IDList *list)
+{
+    list->size = 0;
+    list->head = NULL;
+    list->tail = NULL;
+}
+
+
+/* Link an element just after an existing element */
+int idlist_insert_next(IDList *list, IDListLink *element, IDListLink *link)
+{
+    /* If element is NULL and the list is not empty (or there is nothing to link), return an error */
+    if( (link == NULL) || ((element == NULL) && (idlist_size(list) != 0)) )
+        return -1;
+
+    /* Handle insertion when list is empty */
+    if(idlist_size(list) == 0)
+    {
+        link->prev = NULL;
+        link->next = NULL;
+        list->head = link;
+        list->tail = link;
+    }
+    /* Otherwise, handle insertion when list is nonempty */
+    else
+    {
+        link->next = element->next;
+        link->prev = element;
+
+        /* If element was the tail, the new tail is now link */
+        if(element->next == NULL)
+            list->tail = link;
+        /* Otherwise, need to update the prev pointer of the link now following the new one */
+        else
+            element->next->prev = link;
+
+        element->next = link;
+    }
+
+    /* Update the size of the list */
+    list->size += 1;
+
+    return 0;
+}
+
+
+/* Link an element just before an existing element */
+int idlist_insert_prev(IDList *list, IDListLink *element, IDListLink *link)
+{
+    /* If element is NULL and the list is not empty (or there is nothing to link), return an error */
+    if( (link == NULL) || ((element == NULL) && (idlist_size(list) != 0)) )
+        return -1;
+
+    /* Handle insertion when list is empty */
+    if(idlist_size(list) == 0)
+    {
+        link->prev = NULL;
+        link->next = NULL;
+        list->head = link;
+        list->tail = link;
+    }
+    /* Otherwise, handle insertion when list is nonempty */
+    else
+    {
+        link->next = element;
+        link->prev = element->prev;
+
+        /* If element was the head, the new head is now link */
+        if(element->prev == NULL)
+            list->head = link;
+        /* Otherwise, need to update the next pointer of the link now preceding the new one */
+        else
+            element->prev->next = link;
+
+        element->prev = link;
+    }
+
+    /* Update the size of the list */
+    list->size += 1;
+
+    return 0;
+}
+
+
+/* Unlink an element from the list */
+int idlist_remove(IDList *list, IDListLink *link)
+{
+    /* If supplied link is NULL or the list is empty, return an error */
+    if( (link == NULL) || (idlist_size(list) == 0) )
+        return -1;
+
+    /* Handle removal of the head */
+    if(link == list->head)
+    {
+        list->head = link->next;
+
+        /* If the list only had one element, it is now empty */
+        if(list->head == NULL)
+            list->tail = NULL;
+        else
+            link->next->prev = NULL;
+    }
+    /* Otherwise, handle removal of a link not at the head of the list */
+    else
+    {
+        link->prev->next = link->next;
+
+        /* If we removed the tail, update the tail of the list */
+        if(link->next == NULL)
+            list->tail = link->prev;
+        else
+            link->next->prev = link->prev;
+    }
+
+    /* The removed link no longer belongs to the list */
+    link->prev = NULL;
+    link->next = NULL;
+
+    /* Update the size of the list */
+    list->size -= 1;
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/* Implementation of Intrusive Linked List */
+#include <stdlib.h>
+
+#include "ilist.h"
+
+
+/* Initialize an Intrusive Linked List */
+void ilist_init(IList *list)
+{
+    list->size = 0;
+    list->head = NULL;
+    list->tail = NULL;
+}
+
+
+/* Link a new element into the list */
+int ilist_insert_next(IList *list, IListLink *element, IListLink *link)
+{
+    /* Nothing to link */
+    if(link == NULL)
+        return -1;
+
+    /* Handle insertion at head of the list */
+    if(element == NULL)
+    {
+        if(ilist_size(list) == 0)
+            list->tail = link;
+
+        link->next = list->head;
+        list->head = link;
+    }
+    /* Handle insertion elsewhere */
+    else
+    {
+        if(element->next == NULL)
+            list->tail = link;
+
+        link->next = element->next;
+        element->next = link;
+    }
+
+    /* Update the size of the list */
+    list->size += 1;
+
+    return 0;
+}
+
+
+/* Unlink an element from the list */
+int ilist_remove_next(IList *list, IListLink *element, IListLink **link)
+{
+    /* If list is empty, cannot remove anything */
+    if(ilist_size(list) == 0)
+        return -1;
+
+    /* Handle removal from head */
+    if(element == NULL)
+    {
+        *link = list->head;
+        list->head = list->head->next;
+
+        /* If the size of the list was 1, the list is now empty */
+        if(ilist_size(list) == 1)
+            list->tail = NULL;
+    }
+    /* Handle removal elsewhere */
+    else
+    {
+        /* Cannot remove something after the tail! */
+        if(element->next == NULL)
+            return -1;
+
+        *link = element->next;
+        element->next = element->next->next;
+
+        /* If we removed the tail, set the new tail */
+        if(element->next == NULL)
+            list->tail = element;
+    }
+
+    /* The removed link no longer belongs to the list */
+    (*link)->next = NULL;
+
+    /* Update the size of the list */
+    list->size -= 1;
+
+    return 0;
+}
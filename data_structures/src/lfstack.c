@@ -0,0 +1,88 @@
+/* Implementation of Lock-Free Stack */
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "hazard.h"
+#include "lfstack.h"
+
+
+/* Initialize a lock-free stack */
+void lfstack_init(LFStack *stack, void (*destroy)(void *data))
+{
+    atomic_init(&stack->top, NULL);
+    hazard_init(&stack->domain, free);
+    stack->destroy = destroy;
+}
+
+
+/* Destroy a lock-free stack */
+void lfstack_destroy(LFStack *stack)
+{
+    LFStackNode *node = atomic_load(&stack->top), *next;
+
+    /* No other thread is running, so the remaining nodes can be walked and freed directly */
+    while(node != NULL)
+    {
+        next = node->next;
+        if(stack->destroy != NULL)
+            stack->destroy(node->data);
+        free(node);
+        node = next;
+    }
+
+    /* Free the retired nodes */
+    hazard_destroy(&stack->domain);
+
+    /* To be safe, clear the structure */
+    memset(stack, 0, sizeof(LFStack));
+}
+
+
+/* Push an element onto the stack */
+int lfstack_push(LFStack *stack, const void *data)
+{
+    LFStackNode *node = malloc(sizeof(LFStackNode));
+    if(node == NULL)
+        return -1;
+    node->data = (void *)data;
+
+    /* The node is private until the CAS succeeds, so it needs no protection -- Release publishes its fields */
+    void *top = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    do
+    {
+        node->next = top;
+    } while(!atomic_compare_exchange_weak_explicit(&stack->top, &top, node, memory_order_release, memory_order_relaxed));
+
+    return 0;
+}
+
+
+/* Pop an element from the stack */
+int lfstack_pop(LFStack *stack, HazardRecord *record, void **data)
+{
+    LFStackNode *top;
+
+    for(;;)
+    {
+        /* Protect the top before reading its next pointer -- It cannot be freed (or reused) while protected */
+        if( (top = hazard_protect(record, 0, &stack->top)) == NULL )
+        {
+            hazard_clear(record, 0);
+            return -1;
+        }
+
+        void *expected = top;
+        if(atomic_compare_exchange_weak_explicit(&stack->top, &expected, top->next, memory_order_acquire, memory_order_relaxed))
+            break;
+    }
+
+    hazard_clear(record, 0);
+    *data = top->data;
+
+    /* Other threads may still be reading the node, so hand it to the domain rather than freeing it -- If the
+       retired list cannot grow, fall back to keeping the node (a small leak is better than a use-after-free) */
+    hazard_retire(record, top);
+
+    return 0;
+}
@@ -123,3 +123,202 @@ int list_remove_next(List *list, ListElement *element, void **data)
     /* If we get here, we are successful */
     return 0;
 }
+
+
+/* Move every element of another list into this one */
+int list_splice(List *list, ListElement *element, List *other)
+{
+    if(list == other)
+        return -1;
+
+    /* Nothing to move */
+    if(list_size(other) == 0)
+        return 0;
+
+    /* Handle splice at head of the list */
+    if(element == NULL)
+    {
+        if(list_size(list) == 0)
+            list->tail = other->tail;
+
+        other->tail->next = list->head;
+        list->head = other->head;
+    }
+    /* Handle splice elsewhere */
+    else
+    {
+        if(element->next == NULL)
+            list->tail = other->tail;
+
+        other->tail->next = element->next;
+        element->next = other->head;
+    }
+
+    /* Update the sizes and leave other empty */
+    list->size += other->size;
+    other->size = 0;
+    other->head = NULL;
+    other->tail = NULL;
+
+    return 0;
+}
+
+
+/* Insert an array of data at the tail of the list */
+int list_append_array(List *list, void **data, int count)
+{
+    if(count < 0)
+        return -1;
+    if(count == 0)
+        return 0;
+
+    /* Build the chain on the side so a failed allocation leaves the list untouched */
+    ListElement *head = NULL, *tail = NULL, *new_element;
+    for(int i = 0; i < count; i++)
+    {
+        if( (new_element = malloc(sizeof(ListElement))) == NULL )
+        {
+            while(head != NULL)
+            {
+                new_element = head->next;
+                free(head);
+                head = new_element;
+            }
+            return -1;
+        }
+
+        new_element->data = data[i];
+        new_element->next = NULL;
+
+        if(tail == NULL)
+            head = new_element;
+        else
+            tail->next = new_element;
+        tail = new_element;
+    }
+
+    /* Link the chain in after the current tail */
+    if(list_size(list) == 0)
+        list->head = head;
+    else
+        list->tail->next = head;
+    list->tail = tail;
+    list->size += count;
+
+    return 0;
+}
+
+
+/* Remove every element whose data satisfies a predicate */
+int list_remove_if(List *list, int (*predicate)(const void *data, void *arg), void *arg)
+{
+    ListElement *prev = NULL, *element = list->head, *next;
+    int removed = 0;
+
+    while(element != NULL)
+    {
+        next = element->next;
+
+        if(predicate(element->data, arg))
+        {
+            /* Unlink the element */
+            if(prev == NULL)
+                list->head = next;
+            else
+                prev->next = next;
+
+            if(list->destroy != NULL)
+                list->destroy(element->data);
+            free(element);
+            removed += 1;
+        }
+        else
+        {
+            prev = element;
+        }
+
+        element = next;
+    }
+
+    /* The last kept element is the new tail */
+    list->tail = prev;
+    list->size -= removed;
+
+    return removed;
+}
+
+
+/* Merge two sorted NULL-terminated chains -- Ties are taken from left, which holds the earlier elements */
+static ListElement *list_merge(ListElement *left, ListElement *right, int (*compare)(const void *key1, const void *key2))
+{
+    ListElement *head = NULL, **link = &head;
+
+    while( (left != NULL) && (right != NULL) )
+    {
+        if(compare(left->data, right->data) <= 0)
+        {
+            *link = left;
+            left = left->next;
+        }
+        else
+        {
+            *link = right;
+            right = right->next;
+        }
+        link = &(*link)->next;
+    }
+
+    *link = (left != NULL) ? left : right;
+    return head;
+}
+
+
+/* Sort the list in place */
+int list_sort(List *list, int (*compare)(const void *key1, const void *key2))
+{
+    if(compare == NULL)
+        return -1;
+    if(list_size(list) < 2)
+        return 0;
+
+    /* bins[i] holds a sorted chain built from 2^i runs (as in a binary counter), so 32 bins cover any int-sized list */
+    ListElement *bins[32] = {NULL};
+    ListElement *element = list->head, *run, *merged;
+    int i;
+
+    while(element != NULL)
+    {
+        /* Cut the next natural ascending run off the front of the remaining elements */
+        run = element;
+        while( (element->next != NULL) && (compare(element->data, element->next->data) <= 0) )
+            element = element->next;
+        merged = run;
+        run = element->next;
+        element->next = NULL;
+        element = run;
+
+        /* Carry the run up through the occupied bins -- Bins hold earlier elements, so they go on the left */
+        for(i = 0; (i < 31) && (bins[i] != NULL); i++)
+        {
+            merged = list_merge(bins[i], merged, compare);
+            bins[i] = NULL;
+        }
+        bins[i] = (bins[i] == NULL) ? merged : list_merge(bins[i], merged, compare);
+    }
+
+    /* Merge the bins together -- Higher bins hold earlier elements */
+    merged = NULL;
+    for(i = 0; i < 32; i++)
+    {
+        if(bins[i] != NULL)
+            merged = (merged == NULL) ? bins[i] : list_merge(bins[i], merged, compare);
+    }
+
+    /* Relink the list and find the new tail */
+    list->head = merged;
+    for(element = merged; element->next != NULL; element = element->next)
+        ;
+    list->tail = element;
+
+    return 0;
+}
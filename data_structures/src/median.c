@@ -0,0 +1,405 @@
+/* Implementation of Running Median */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "heap.h"
+#include "median.h"
+
+
+/* Order doubles so the largest is on top of a Heap */
+static int median_larger(const void *key1, const void *key2)
+{
+    double a = *(const double *)key1, b = *(const double *)key2;
+    return (a > b) ? 1 : (a < b) ? -1 : 0;
+}
+
+
+/* Order doubles so the smallest is on top of a Heap */
+static int median_smaller(const void *key1, const void *key2)
+{
+    return median_larger(key2, key1);
+}
+
+
+/* Sort doubles in place -- Quicksort on the larger side's loop, insertion sort for short runs, and no calls through a
+   comparison function, which is where qsort() spends most of a merge */
+static void qsketch_sort(double *values, int count)
+{
+    while(count > 16)
+    {
+        /* Median of three as the pivot */
+        double a = values[0], b = values[count / 2], c = values[count - 1];
+        double pivot = (a < b) ? ((b < c) ? b : (a < c) ? c : a) : ((a < c) ? a : (b < c) ? c : b);
+
+        int i = 0, j = count - 1;
+        while(i <= j)
+        {
+            while(values[i] < pivot)
+                i++;
+            while(values[j] > pivot)
+                j--;
+            if(i <= j)
+            {
+                double tmp = values[i];
+                values[i++] = values[j];
+                values[j--] = tmp;
+            }
+        }
+
+        /* Recurse into the smaller part, loop on the larger, so the stack stays O(log count) */
+        if(j + 1 < count - i)
+        {
+            qsketch_sort(values, j + 1);
+            values += i;
+            count -= i;
+        }
+        else
+        {
+            qsketch_sort(values + i, count - i);
+            count = j + 1;
+        }
+    }
+
+    for(int i = 1; i < count; i++)
+    {
+        double value = values[i];
+        int j = i - 1;
+        while(j >= 0 && values[j] > value)
+        {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = value;
+    }
+}
+
+
+/* Merge the sorted buffer into the centroids, combining neighbours while the size bound allows */
+static void qsketch_merge(QSketch *sketch)
+{
+    if(sketch->buffered == 0)
+        return;
+
+    qsketch_sort(sketch->buffer, sketch->buffered);
+
+    double *out_means = sketch->scratch, *out_weights = sketch->scratch + sketch->capacity + sketch->buffer_capacity;
+    double total = (double)sketch->count, before = 0.0, floor = 1.0 / QSKETCH_TAIL;
+    int c = 0, b = 0, out = 0;
+
+    /* Walk centroids and buffered samples together in order of value */
+    double mean, weight;
+    int have = 0;
+    while(c < sketch->centroids || b < sketch->buffered)
+    {
+        double next_mean, next_weight;
+        if( (b == sketch->buffered) || ((c < sketch->centroids) && (sketch->means[c] <= sketch->buffer[b])) )
+        {
+            next_mean = sketch->means[c];
+            next_weight = sketch->weights[c++];
+        }
+        else
+        {
+            next_mean = sketch->buffer[b++];
+            next_weight = 1.0;
+        }
+
+        if(!have)
+        {
+            mean = next_mean;
+            weight = next_weight;
+            have = 1;
+            continue;
+        }
+
+        /* Size bound at the quantile the combined centroid would sit at */
+        double combined = weight + next_weight;
+        double q = (before + combined / 2.0) / total;
+        double bound = 4.0 * q * (1.0 - q);
+        if(bound < floor)
+            bound = floor;
+
+        if(combined <= total * bound / sketch->compression)
+        {
+            mean += (next_mean - mean) * next_weight / combined;
+            weight = combined;
+        }
+        else
+        {
+            out_means[out] = mean;
+            out_weights[out++] = weight;
+            before += weight;
+            mean = next_mean;
+            weight = next_weight;
+        }
+    }
+    out_means[out] = mean;
+    out_weights[out++] = weight;
+
+    memcpy(sketch->means, out_means, out * sizeof(double));
+    memcpy(sketch->weights, out_weights, out * sizeof(double));
+    sketch->centroids = out;
+    sketch->buffered = 0;
+}
+
+
+/* Initialize a quantile sketch */
+int qsketch_init(QSketch *sketch, double compression)
+{
+    if(compression < 1.0)
+        return -1;
+
+    memset(sketch, 0, sizeof(QSketch));
+    sketch->compression = compression;
+
+    /* Any two neighbouring centroids hold more than n / (compression * QSKETCH_TAIL) samples between them */
+    sketch->capacity = 2 * (int)(compression * QSKETCH_TAIL) + 2;
+    sketch->buffer_capacity = (int)(compression * QSKETCH_BUFFER);
+
+    int merge = sketch->capacity + sketch->buffer_capacity;
+    sketch->means = malloc(sketch->capacity * sizeof(double));
+    sketch->weights = malloc(sketch->capacity * sizeof(double));
+    sketch->buffer = malloc(sketch->buffer_capacity * sizeof(double));
+    sketch->scratch = malloc(2 * merge * sizeof(double));
+
+    if(sketch->means == NULL || sketch->weights == NULL || sketch->buffer == NULL || sketch->scratch == NULL)
+    {
+        qsketch_destroy(sketch);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/* Destroy a quantile sketch */
+void qsketch_destroy(QSketch *sketch)
+{
+    free(sketch->means);
+    free(sketch->weights);
+    free(sketch->buffer);
+    free(sketch->scratch);
+
+    /* To be safe, clear the structure */
+    memset(sketch, 0, sizeof(QSketch));
+}
+
+
+/* Add a sample to a quantile sketch */
+void qsketch_add(QSketch *sketch, double value)
+{
+    if(sketch->count == 0 || value < sketch->min)
+        sketch->min = value;
+    if(sketch->count == 0 || value > sketch->max)
+        sketch->max = value;
+
+    sketch->buffer[sketch->buffered++] = value;
+    sketch->count++;
+
+    if(sketch->buffered == sketch->buffer_capacity)
+        qsketch_merge(sketch);
+}
+
+
+/* Add an array of samples to a quantile sketch */
+void qsketch_add_n(QSketch *sketch, const double *values, int count)
+{
+    while(count > 0)
+    {
+        int room = sketch->buffer_capacity - sketch->buffered;
+        int take = (count < room) ? count : room;
+
+        for(int i = 0; i < take; i++)
+        {
+            if(sketch->count == 0 || values[i] < sketch->min)
+                sketch->min = values[i];
+            if(sketch->count == 0 || values[i] > sketch->max)
+                sketch->max = values[i];
+            sketch->count++;
+        }
+
+        memcpy(&sketch->buffer[sketch->buffered], values, take * sizeof(double));
+        sketch->buffered += take;
+        values += take;
+        count -= take;
+
+        if(sketch->buffered == sketch->buffer_capacity)
+            qsketch_merge(sketch);
+    }
+}
+
+
+/* Estimate a quantile */
+int qsketch_quantile(QSketch *sketch, double q, double *value)
+{
+    if(sketch->count == 0)
+        return -1;
+
+    qsketch_merge(sketch);
+
+    if(q <= 0.0)
+    {
+        *value = sketch->min;
+        return 0;
+    }
+    if(q >= 1.0)
+    {
+        *value = sketch->max;
+        return 0;
+    }
+
+    /* Each centroid stands for its samples spread evenly around its mean -- Interpolate between centers */
+    double target = q * (double)sketch->count, before = 0.0;
+    double previous_center = 0.0, previous_mean = sketch->min;
+
+    for(int i = 0; i < sketch->centroids; i++)
+    {
+        double center = before + sketch->weights[i] / 2.0;
+        if(target <= center)
+        {
+            double span = center - previous_center;
+            *value = previous_mean + (sketch->means[i] - previous_mean) * ((span > 0.0) ? (target - previous_center) / span : 1.0);
+            return 0;
+        }
+
+        previous_center = center;
+        previous_mean = sketch->means[i];
+        before += sketch->weights[i];
+    }
+
+    /* Past the last center, head for the maximum */
+    double span = (double)sketch->count - previous_center;
+    *value = previous_mean + (sketch->max - previous_mean) * ((span > 0.0) ? (target - previous_center) / span : 1.0);
+
+    return 0;
+}
+
+
+/* Initialize a running median */
+int median_init(Median *median, int mode)
+{
+    memset(median, 0, sizeof(Median));
+    median->mode = mode;
+
+    if(mode == MEDIAN_APPROX)
+        return qsketch_init(&median->sketch, MEDIAN_COMPRESSION);
+
+    if(mode != MEDIAN_EXACT)
+        return -1;
+
+    heap_init(&median->lower, median_larger, NULL);
+    heap_init(&median->upper, median_smaller, NULL);
+
+    return 0;
+}
+
+
+/* Destroy a running median */
+void median_destroy(Median *median)
+{
+    if(median->mode == MEDIAN_APPROX)
+        qsketch_destroy(&median->sketch);
+    else
+    {
+        heap_destroy(&median->lower);
+        heap_destroy(&median->upper);
+
+        MedianChunk *chunk = median->chunks, *next;
+        while(chunk != NULL)
+        {
+            next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+    }
+
+    /* To be safe, clear the structure */
+    memset(median, 0, sizeof(Median));
+}
+
+
+/* Add a sample */
+int median_add(Median *median, double value)
+{
+    if(median->mode == MEDIAN_APPROX)
+    {
+        qsketch_add(&median->sketch, value);
+        return 0;
+    }
+
+    /* Store the sample where the heaps can point to it */
+    if(median->chunks == NULL || median->chunks->used == MEDIAN_CHUNK)
+    {
+        MedianChunk *chunk = malloc(sizeof(MedianChunk));
+        if(chunk == NULL)
+            return -1;
+
+        chunk->next = median->chunks;
+        chunk->used = 0;
+        median->chunks = chunk;
+    }
+
+    double *sample = &median->chunks->values[median->chunks->used];
+    *sample = value;
+
+    /* Put it in the half it belongs to, then move one top across if the halves are out of balance */
+    Heap *into = (heap_size(&median->lower) == 0 || value <= *(double *)heap_peek(&median->lower)) ? &median->lower : &median->upper;
+    if(heap_insert(into, sample) != 0)
+        return -1;
+    median->chunks->used++;
+
+    Heap *from = NULL, *to = NULL;
+    if(heap_size(&median->lower) > heap_size(&median->upper) + 1)
+    {
+        from = &median->lower;
+        to = &median->upper;
+    }
+    else if(heap_size(&median->upper) > heap_size(&median->lower))
+    {
+        from = &median->upper;
+        to = &median->lower;
+    }
+
+    if(from != NULL)
+    {
+        void *top;
+        heap_extract(from, &top);
+        if(heap_insert(to, top) != 0)
+        {
+            /* The heap just gave up this slot, so putting the top back cannot fail */
+            heap_insert(from, top);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/* Get the median of the samples so far */
+int median_get(Median *median, double *value)
+{
+    if(median->mode == MEDIAN_APPROX)
+        return qsketch_quantile(&median->sketch, 0.5, value);
+
+    if(heap_size(&median->lower) == 0)
+        return -1;
+
+    double low = *(double *)heap_peek(&median->lower);
+    if(heap_size(&median->lower) > heap_size(&median->upper))
+        *value = low;
+    else
+        *value = low + (*(double *)heap_peek(&median->upper) - low) / 2.0;
+
+    return 0;
+}
+
+
+/* Estimate any quantile of the samples so far */
+int median_quantile(Median *median, double q, double *value)
+{
+    if(median->mode != MEDIAN_APPROX)
+        return -1;
+
+    return qsketch_quantile(&median->sketch, q, value);
+}
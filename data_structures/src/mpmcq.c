@@ -0,0 +1,249 @@
+/* Implementation of Multi-Producer/Multi-Consumer Queue */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "mpmcq.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <sched.h>
+
+/* Failed attempts a blocking call retries at once, then after yielding the CPU, before it goes to sleep */
+#define MPMCQ_SPINS 16
+#define MPMCQ_YIELDS 32
+
+
+/* Sleep until word no longer holds value (or a spurious wakeup) */
+static void mpmcq_wait(atomic_uint *word, unsigned int value)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)value;
+    sched_yield();
+#endif
+}
+
+
+/* Change word and wake one thread sleeping on it, if any thread announced it is waiting */
+static void mpmcq_wake(atomic_uint *word, atomic_int *waiters)
+{
+    /* Pairs with the fence in the waiting thread -- Either it sees our element or we see it waiting */
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(waiters, memory_order_relaxed) == 0)
+        return;
+
+    atomic_fetch_add_explicit(word, 1, memory_order_seq_cst);
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+
+/* Claim a position and write data into it -- Returns -1 if the queue is full */
+static int mpmcq_enqueue(MPMCQueue *queue, const void *data)
+{
+    size_t pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    MPMCSlot *slot;
+
+    for(;;)
+    {
+        slot = &queue->slots[pos & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        /* The slot is free for this position -- Try to claim it (on failure pos is reloaded) */
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&queue->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        /* The slot still holds the element from one lap ago, so the queue is full */
+        else if(diff < 0)
+        {
+            return -1;
+        }
+        /* Another producer already took this position */
+        else
+        {
+            pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+
+    /* Write the data, then hand the slot to the consumer of this position */
+    slot->data = (void *)data;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+
+    return 0;
+}
+
+
+/* Claim a position and read data from it -- Returns -1 if the queue is empty */
+static int mpmcq_dequeue(MPMCQueue *queue, void **data)
+{
+    size_t pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    MPMCSlot *slot;
+
+    for(;;)
+    {
+        slot = &queue->slots[pos & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+        /* The slot holds the element for this position -- Try to claim it (on failure pos is reloaded) */
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&queue->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        /* The producer of this position has not finished, so the queue is empty */
+        else if(diff < 0)
+        {
+            return -1;
+        }
+        /* Another consumer already took this position */
+        else
+        {
+            pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+
+    /* Read the data, then hand the slot to the producer one lap ahead */
+    *data = slot->data;
+    atomic_store_explicit(&slot->sequence, pos + queue->mask + 1, memory_order_release);
+
+    return 0;
+}
+
+
+/* Initialize a multi-producer/multi-consumer queue */
+int mpmcq_init(MPMCQueue *queue, size_t capacity)
+{
+    /* Round up to a power of two -- The sequence scheme needs at least two slots */
+    size_t slots = 2;
+    while(slots < capacity)
+        slots <<= 1;
+
+    if( (queue->slots = malloc(slots * sizeof(MPMCSlot))) == NULL )
+        return -1;
+
+    /* Slot i is ready for the push of position i */
+    for(size_t i = 0; i < slots; i++)
+    {
+        atomic_init(&queue->slots[i].sequence, i);
+        queue->slots[i].data = NULL;
+    }
+
+    queue->capacity = slots;
+    queue->mask = slots - 1;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->not_empty, 0);
+    atomic_init(&queue->not_full, 0);
+    atomic_init(&queue->pop_waiters, 0);
+    atomic_init(&queue->push_waiters, 0);
+
+    return 0;
+}
+
+
+/* Destroy a multi-producer/multi-consumer queue */
+void mpmcq_destroy(MPMCQueue *queue)
+{
+    free(queue->slots);
+
+    /* To be safe, clear the structure */
+    memset(queue, 0, sizeof(MPMCQueue));
+}
+
+
+/* Try to push an element onto the queue */
+int mpmcq_try_push(MPMCQueue *queue, const void *data)
+{
+    if(mpmcq_enqueue(queue, data) != 0)
+        return -1;
+
+    mpmcq_wake(&queue->not_empty, &queue->pop_waiters);
+    return 0;
+}
+
+
+/* Try to pop an element from the queue */
+int mpmcq_try_pop(MPMCQueue *queue, void **data)
+{
+    if(mpmcq_dequeue(queue, data) != 0)
+        return -1;
+
+    mpmcq_wake(&queue->not_full, &queue->push_waiters);
+    return 0;
+}
+
+
+/* Push an element, sleeping while the queue is full */
+int mpmcq_push(MPMCQueue *queue, const void *data)
+{
+    for(int spins = 0; ; spins++)
+    {
+        if(mpmcq_try_push(queue, data) == 0)
+            return 0;
+        if(spins < MPMCQ_SPINS)
+            continue;
+        if(spins < MPMCQ_SPINS + MPMCQ_YIELDS)
+        {
+            sched_yield();
+            continue;
+        }
+
+        /* Announce the wait, then check once more before sleeping -- A pop in between changes not_full */
+        unsigned int value = atomic_load_explicit(&queue->not_full, memory_order_seq_cst);
+        atomic_fetch_add_explicit(&queue->push_waiters, 1, memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if(mpmcq_try_push(queue, data) == 0)
+        {
+            atomic_fetch_sub_explicit(&queue->push_waiters, 1, memory_order_relaxed);
+            return 0;
+        }
+
+        mpmcq_wait(&queue->not_full, value);
+        atomic_fetch_sub_explicit(&queue->push_waiters, 1, memory_order_relaxed);
+    }
+}
+
+
+/* Pop an element, sleeping while the queue is empty */
+int mpmcq_pop(MPMCQueue *queue, void **data)
+{
+    for(int spins = 0; ; spins++)
+    {
+        if(mpmcq_try_pop(queue, data) == 0)
+            return 0;
+        if(spins < MPMCQ_SPINS)
+            continue;
+        if(spins < MPMCQ_SPINS + MPMCQ_YIELDS)
+        {
+            sched_yield();
+            continue;
+        }
+
+        /* Announce the wait, then check once more before sleeping -- A push in between changes not_empty */
+        unsigned int value = atomic_load_explicit(&queue->not_empty, memory_order_seq_cst);
+        atomic_fetch_add_explicit(&queue->pop_waiters, 1, memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if(mpmcq_try_pop(queue, data) == 0)
+        {
+            atomic_fetch_sub_explicit(&queue->pop_waiters, 1, memory_order_relaxed);
+            return 0;
+        }
+
+        mpmcq_wait(&queue->not_empty, value);
+        atomic_fetch_sub_explicit(&queue->pop_waiters, 1, memory_order_relaxed);
+    }
+}
@@ -137,6 +137,10 @@ int ohtbl_lookup(const OHTbl *htbl, void **data)
         if(htbl->table[position] == NULL)
             return -1;
 
+        /* If the position is marked as vacated, search beyond it (it holds no element to match against) */
+        if(htbl->table[position] == htbl->vacated)
+            continue;
+
         /* If there is a match, pass back the data from the table */
         if(htbl->match(htbl->table[position], *data))
         {
@@ -1,37 +1,144 @@
 /* Implementation for Queue */
 #include <stdlib.h>
+#include <string.h>
 
-#include "list.h"
 #include "queue.h"
 
+/* Capacity of the first allocation */
+#define QUEUE_MIN_CAPACITY 16
+
+
+/* Copy count elements out of the ring starting at slot start, unwrapping them into data */
+static void queue_copy_out(const Queue *queue, int start, void **data, int count)
+{
+    int first = queue->capacity - start;
+    if(first > count)
+        first = count;
+
+    memcpy(data, &queue->data[start], first * sizeof(void *));
+    memcpy(&data[first], queue->data, (count - first) * sizeof(void *));
+}
+
 
 /* Initialize a queue */
 void queue_init(Queue *queue, void (*destroy)(void *data))
 {
-    /* Use list initialization to implement queue as a linked list */
-    list_init(queue, destroy);
+    queue->size = 0;
+    queue->capacity = 0;
+    queue->head = 0;
+    queue->destroy = destroy;
+    queue->data = NULL;
 }
 
 
 /* Destroy a queue */
 void queue_destroy(Queue *queue)
 {
-    /* Use list destruction since the queue is just a linked list */
-    list_destroy(queue);
+    /* If the user supplied a destroy function, apply it to each element from the front */
+    if(queue->destroy != NULL)
+    {
+        for(int i = 0; i < queue->size; i++)
+            queue->destroy(queue_item(queue, i));
+    }
+
+    free(queue->data);
+
+    /* To be safe, clear the structure */
+    memset(queue, 0, sizeof(Queue));
+}
+
+
+/* Make room for at least capacity elements */
+int queue_reserve(Queue *queue, int capacity)
+{
+    if(capacity <= queue->capacity)
+        return 0;
+
+    /* Round up to a power of two */
+    int new_capacity = (queue->capacity > 0) ? queue->capacity : QUEUE_MIN_CAPACITY;
+    while(new_capacity < capacity)
+        new_capacity *= 2;
+
+    void **data = malloc(new_capacity * sizeof(void *));
+    if(data == NULL)
+        return -1;
+
+    /* Unwrap the elements to the start of the new buffer so they keep their order */
+    if(queue->size > 0)
+        queue_copy_out(queue, queue->head, data, queue->size);
+
+    free(queue->data);
+    queue->data = data;
+    queue->capacity = new_capacity;
+    queue->head = 0;
+
+    return 0;
 }
 
 
 /* Push data onto the queue */
 int queue_push(Queue *queue, const void *data)
 {
-    /* Use list insertion to insert the data at the tail of the list (i.e., end of the queue) */
-    return list_insert_next(queue, list_tail(queue), data);
+    if( (queue->size == queue->capacity) && (queue_reserve(queue, queue->size + 1) != 0) )
+        return -1;
+
+    queue->data[(queue->head + queue->size) & (queue->capacity - 1)] = (void *)data;
+    queue->size += 1;
+
+    return 0;
 }
 
 
 /* Pop data from the queue */
 int queue_pop(Queue *queue, void **data)
 {
-    /* Use list removal to remove the data at the head of the list (i.e., front of the queue) */
-    return list_remove_next(queue, NULL, data);
+    if(queue_size(queue) == 0)
+        return -1;
+
+    *data = queue->data[queue->head];
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    queue->size -= 1;
+
+    return 0;
+}
+
+
+/* Push several elements onto the queue */
+int queue_push_n(Queue *queue, void **data, int count)
+{
+    if(count < 0)
+        return -1;
+    if(count == 0)
+        return 0;
+
+    if( (queue->size + count > queue->capacity) && (queue_reserve(queue, queue->size + count) != 0) )
+        return -1;
+
+    /* Copy up to the end of the buffer, then wrap around to the start */
+    int tail = (queue->head + queue->size) & (queue->capacity - 1);
+    int first = queue->capacity - tail;
+    if(first > count)
+        first = count;
+
+    memcpy(&queue->data[tail], data, first * sizeof(void *));
+    memcpy(queue->data, &data[first], (count - first) * sizeof(void *));
+    queue->size += count;
+
+    return 0;
+}
+
+
+/* Pop several elements from the queue */
+int queue_pop_n(Queue *queue, void **data, int count)
+{
+    if(count <= 0)
+        return 0;
+    if(count > queue->size)
+        count = queue->size;
+
+    queue_copy_out(queue, queue->head, data, count);
+    queue->head = (queue->head + count) & (queue->capacity - 1);
+    queue->size -= count;
+
+    return count;
 }
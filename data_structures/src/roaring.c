@@ -0,0 +1,1231 @@
+/* Implementation of Roaring Bitmaps */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "roaring.h"
+
+/*
+*************************************
+        Private Useful Macros
+*************************************
+*/
+
+/* Get the high 16 bits (i.e., container key) of a value */
+#define roaring_high(value) ((uint16_t)((value) >> 16))
+
+/* Get the low 16 bits (i.e., position within the container) of a value */
+#define roaring_low(value) ((uint16_t)((value) & 0xFFFF))
+
+/* Number of values covered by one container */
+#define ROARING_CHUNK 65536
+
+/* Number of bytes in the serialized header and in each serialized container header */
+#define ROARING_HEADER_BYTES 4
+#define ROARING_CONTAINER_HEADER_BYTES 7
+
+
+
+
+/*
+*****************************************
+        Private Bitmap Word Helpers
+*****************************************
+*/
+
+/* Set the bits for the values start..end (inclusive) */
+static void words_set_range(uint64_t *words, int start, int end)
+{
+    int first = start >> 6, last = end >> 6;
+    uint64_t first_mask = ~(uint64_t)0 << (start & 63);
+    uint64_t last_mask = ~(uint64_t)0 >> (63 - (end & 63));
+
+    if(first == last)
+    {
+        words[first] |= first_mask & last_mask;
+        return;
+    }
+
+    words[first] |= first_mask;
+    for(int i = first + 1; i < last; i++)
+        words[i] = ~(uint64_t)0;
+    words[last] |= last_mask;
+}
+
+
+/* Clear the bits for the values start..end (inclusive) */
+static void words_clear_range(uint64_t *words, int start, int end)
+{
+    int first = start >> 6, last = end >> 6;
+    uint64_t first_mask = ~(uint64_t)0 << (start & 63);
+    uint64_t last_mask = ~(uint64_t)0 >> (63 - (end & 63));
+
+    if(first == last)
+    {
+        words[first] &= ~(first_mask & last_mask);
+        return;
+    }
+
+    words[first] &= ~first_mask;
+    for(int i = first + 1; i < last; i++)
+        words[i] = 0;
+    words[last] &= ~last_mask;
+}
+
+
+/* Count the bits set in a bitmap container's words */
+static int words_cardinality(const uint64_t *words)
+{
+    int card = 0;
+    for(int i = 0; i < ROARING_BITMAP_WORDS; i++)
+        card += __builtin_popcountll(words[i]);
+    return card;
+}
+
+
+/* Find the first set (or clear, if set is 0) bit at or after pos, or ROARING_CHUNK if there is none */
+static int words_next(const uint64_t *words, int pos, int set)
+{
+    while(pos < ROARING_CHUNK)
+    {
+        uint64_t word = set ? words[pos >> 6] : ~words[pos >> 6];
+        word >>= (pos & 63);
+        if(word != 0)
+            return pos + __builtin_ctzll(word);
+        pos = (pos | 63) + 1;
+    }
+    return ROARING_CHUNK;
+}
+
+
+
+
+/*
+****************************************
+        Private Container Helpers
+****************************************
+*/
+
+/* Find the position of the first array value >= low */
+static int container_array_search(const uint16_t *values, int count, uint16_t low)
+{
+    int lo = 0, hi = count;
+    while(lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if(values[mid] < low)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+
+/* Find the index of the last run starting at or before low, or -1 if there is none */
+static int container_run_search(const uint16_t *runs, int count, uint16_t low)
+{
+    int lo = 0, hi = count;
+    while(lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if(runs[2 * mid] <= low)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - 1;
+}
+
+
+/* Determine whether a container holds the given low 16 bits */
+static int container_contains(const RoaringContainer *c, uint16_t low)
+{
+    switch(c->type)
+    {
+        case ROARING_ARRAY:
+        {
+            const uint16_t *values = c->data;
+            int pos = container_array_search(values, c->count, low);
+            return (pos < c->count && values[pos] == low) ? 1 : 0;
+        }
+        case ROARING_BITMAP:
+        {
+            const uint64_t *words = c->data;
+            return (int)((words[low >> 6] >> (low & 63)) & 1);
+        }
+        default:
+        {
+            const uint16_t *runs = c->data;
+            int i = container_run_search(runs, c->count, low);
+            return (i >= 0 && low <= runs[2 * i] + runs[2 * i + 1]) ? 1 : 0;
+        }
+    }
+}
+
+
+/* OR the values of a container into a bitmap container's words */
+static void container_fill_words(const RoaringContainer *c, uint64_t *words)
+{
+    switch(c->type)
+    {
+        case ROARING_ARRAY:
+        {
+            const uint16_t *values = c->data;
+            for(int i = 0; i < c->count; i++)
+                words[values[i] >> 6] |= (uint64_t)1 << (values[i] & 63);
+            break;
+        }
+        case ROARING_BITMAP:
+        {
+            const uint64_t *src = c->data;
+            for(int i = 0; i < ROARING_BITMAP_WORDS; i++)
+                words[i] |= src[i];
+            break;
+        }
+        default:
+        {
+            const uint16_t *runs = c->data;
+            for(int i = 0; i < c->count; i++)
+                words_set_range(words, runs[2 * i], runs[2 * i] + runs[2 * i + 1]);
+            break;
+        }
+    }
+}
+
+
+/* Make c an array or bitmap container (whichever suits card) holding the values set in words
+     - On success, c owns words (or words has been freed); on failure, words is left to the caller
+*/
+static int container_from_words(RoaringContainer *c, uint64_t *words, int card)
+{
+    /* Dense containers keep the words as they are */
+    if(card > ROARING_ARRAY_MAX)
+    {
+        c->type = ROARING_BITMAP;
+        c->cardinality = card;
+        c->count = ROARING_BITMAP_WORDS;
+        c->capacity = ROARING_BITMAP_WORDS;
+        c->data = words;
+        return 0;
+    }
+
+    /* Sparse containers extract the set bits into a sorted array */
+    uint16_t *values = malloc((card > 0 ? card : 1) * sizeof(uint16_t));
+    if(values == NULL)
+        return -1;
+
+    int k = 0;
+    for(int i = 0; i < ROARING_BITMAP_WORDS; i++)
+    {
+        uint64_t word = words[i];
+        while(word)
+        {
+            values[k++] = (uint16_t)(i * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+    free(words);
+
+    c->type = ROARING_ARRAY;
+    c->cardinality = card;
+    c->count = card;
+    c->capacity = (card > 0 ? card : 1);
+    c->data = values;
+    return 0;
+}
+
+
+/* Convert a container to bitmap form regardless of its cardinality */
+static int container_to_bitmap(RoaringContainer *c)
+{
+    uint64_t *words = calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if(words == NULL)
+        return -1;
+
+    container_fill_words(c, words);
+    free(c->data);
+
+    c->type = ROARING_BITMAP;
+    c->count = ROARING_BITMAP_WORDS;
+    c->capacity = ROARING_BITMAP_WORDS;
+    c->data = words;
+    return 0;
+}
+
+
+/* Convert a run container back to an array or bitmap container */
+static int container_unrun(RoaringContainer *c)
+{
+    uint64_t *words = calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if(words == NULL)
+        return -1;
+
+    container_fill_words(c, words);
+
+    void *old = c->data;
+    if(container_from_words(c, words, c->cardinality) != 0)
+    {
+        free(words);
+        return -1;
+    }
+    free(old);
+
+    return 0;
+}
+
+
+/* Add the given low 16 bits to a container (0 if added, 1 if already present, -1 on error) */
+static int container_add(RoaringContainer *c, uint16_t low)
+{
+    if(container_contains(c, low))
+        return 1;
+
+    /* Run containers are only built by roaring_optimize(), so fall back to the general forms to modify them */
+    if(c->type == ROARING_RUN && container_unrun(c) != 0)
+        return -1;
+
+    /* A full array container becomes a bitmap container */
+    if(c->type == ROARING_ARRAY && c->count == ROARING_ARRAY_MAX && container_to_bitmap(c) != 0)
+        return -1;
+
+    if(c->type == ROARING_ARRAY)
+    {
+        /* Grow the array geometrically (but never past the largest array container) */
+        if(c->count == c->capacity)
+        {
+            int capacity = c->capacity * 2;
+            if(capacity > ROARING_ARRAY_MAX)
+                capacity = ROARING_ARRAY_MAX;
+
+            uint16_t *temp = realloc(c->data, capacity * sizeof(uint16_t));
+            if(temp == NULL)
+                return -1;
+
+            c->data = temp;
+            c->capacity = capacity;
+        }
+
+        /* Shift the larger values up and store the new one */
+        uint16_t *values = c->data;
+        int pos = container_array_search(values, c->count, low);
+        memmove(&values[pos + 1], &values[pos], (c->count - pos) * sizeof(uint16_t));
+        values[pos] = low;
+        c->count += 1;
+    }
+    else
+    {
+        uint64_t *words = c->data;
+        words[low >> 6] |= (uint64_t)1 << (low & 63);
+    }
+
+    c->cardinality += 1;
+    return 0;
+}
+
+
+/* Remove the given low 16 bits from a container (0 if removed, -1 otherwise) */
+static int container_delete(RoaringContainer *c, uint16_t low)
+{
+    if(!container_contains(c, low))
+        return -1;
+
+    if(c->type == ROARING_RUN && container_unrun(c) != 0)
+        return -1;
+
+    if(c->type == ROARING_ARRAY)
+    {
+        /* Shift the larger values down */
+        uint16_t *values = c->data;
+        int pos = container_array_search(values, c->count, low);
+        memmove(&values[pos], &values[pos + 1], (c->count - pos - 1) * sizeof(uint16_t));
+        c->count -= 1;
+        c->cardinality -= 1;
+    }
+    else
+    {
+        uint64_t *words = c->data;
+        words[low >> 6] &= ~((uint64_t)1 << (low & 63));
+        c->cardinality -= 1;
+
+        /* A sparse bitmap container becomes an array container (if that fails, the bitmap is still valid) */
+        if(c->cardinality <= ROARING_ARRAY_MAX && container_from_words(c, words, c->cardinality) != 0)
+            c->data = words;
+    }
+
+    return 0;
+}
+
+
+/* Make a deep copy of a container */
+static int container_copy(const RoaringContainer *src, RoaringContainer *dst)
+{
+    size_t bytes;
+    if(src->type == ROARING_ARRAY)
+        bytes = src->count * sizeof(uint16_t);
+    else if(src->type == ROARING_BITMAP)
+        bytes = ROARING_BITMAP_WORDS * sizeof(uint64_t);
+    else
+        bytes = src->count * 2 * sizeof(uint16_t);
+
+    *dst = *src;
+    dst->capacity = src->count;
+    dst->data = malloc(bytes > 0 ? bytes : 1);
+    if(dst->data == NULL)
+        return -1;
+
+    memcpy(dst->data, src->data, bytes);
+    return 0;
+}
+
+
+/* Start an empty array container for the result of an operation */
+static int container_new_array(RoaringContainer *c, uint16_t key, int capacity)
+{
+    c->key = key;
+    c->type = ROARING_ARRAY;
+    c->cardinality = 0;
+    c->count = 0;
+    c->capacity = (capacity > 0 ? capacity : 1);
+    c->data = malloc(c->capacity * sizeof(uint16_t));
+    return (c->data == NULL) ? -1 : 0;
+}
+
+
+/* Finish the result of an operation computed into bitmap words */
+static int container_finish_words(RoaringContainer *c, uint16_t key, uint64_t *words)
+{
+    c->key = key;
+    if(container_from_words(c, words, words_cardinality(words)) != 0)
+    {
+        free(words);
+        return -1;
+    }
+    return 0;
+}
+
+
+/* Compute the union of two containers with the same key */
+static int container_union(const RoaringContainer *a, const RoaringContainer *b, RoaringContainer *out)
+{
+    /* Two small arrays are merged */
+    if(a->type == ROARING_ARRAY && b->type == ROARING_ARRAY && a->cardinality + b->cardinality <= ROARING_ARRAY_MAX)
+    {
+        if(container_new_array(out, a->key, a->count + b->count) != 0)
+            return -1;
+
+        const uint16_t *va = a->data, *vb = b->data;
+        uint16_t *vo = out->data;
+        int i = 0, j = 0, k = 0;
+        while(i < a->count && j < b->count)
+        {
+            if(va[i] < vb[j])
+                vo[k++] = va[i++];
+            else if(vb[j] < va[i])
+                vo[k++] = vb[j++];
+            else
+            {
+                vo[k++] = va[i++];
+                j++;
+            }
+        }
+        while(i < a->count)
+            vo[k++] = va[i++];
+        while(j < b->count)
+            vo[k++] = vb[j++];
+
+        out->count = k;
+        out->cardinality = k;
+        return 0;
+    }
+
+    /* Everything else is ORed together in bitmap form */
+    uint64_t *words = calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if(words == NULL)
+        return -1;
+
+    container_fill_words(a, words);
+    container_fill_words(b, words);
+
+    return container_finish_words(out, a->key, words);
+}
+
+
+/* Compute the intersection of two containers with the same key */
+static int container_intersection(const RoaringContainer *a, const RoaringContainer *b, RoaringContainer *out)
+{
+    /* Two arrays are merged */
+    if(a->type == ROARING_ARRAY && b->type == ROARING_ARRAY)
+    {
+        if(container_new_array(out, a->key, (a->count < b->count) ? a->count : b->count) != 0)
+            return -1;
+
+        const uint16_t *va = a->data, *vb = b->data;
+        uint16_t *vo = out->data;
+        int i = 0, j = 0, k = 0;
+        while(i < a->count && j < b->count)
+        {
+            if(va[i] < vb[j])
+                i++;
+            else if(vb[j] < va[i])
+                j++;
+            else
+            {
+                vo[k++] = va[i++];
+                j++;
+            }
+        }
+
+        out->count = k;
+        out->cardinality = k;
+        return 0;
+    }
+
+    /* An array and anything else -- Probe the other container with each value of the array */
+    if(a->type == ROARING_ARRAY || b->type == ROARING_ARRAY)
+    {
+        const RoaringContainer *array = (a->type == ROARING_ARRAY) ? a : b;
+        const RoaringContainer *other = (a->type == ROARING_ARRAY) ? b : a;
+
+        if(container_new_array(out, a->key, array->count) != 0)
+            return -1;
+
+        const uint16_t *va = array->data;
+        uint16_t *vo = out->data;
+        int k = 0;
+        for(int i = 0; i < array->count; i++)
+            if(container_contains(other, va[i]))
+                vo[k++] = va[i];
+
+        out->count = k;
+        out->cardinality = k;
+        return 0;
+    }
+
+    /* Bitmaps and runs are ANDed together in bitmap form */
+    uint64_t *words = calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if(words == NULL)
+        return -1;
+    container_fill_words(a, words);
+
+    if(b->type == ROARING_BITMAP)
+    {
+        const uint64_t *wb = b->data;
+        for(int i = 0; i < ROARING_BITMAP_WORDS; i++)
+            words[i] &= wb[i];
+    }
+    else
+    {
+        /* Clear the gaps between the runs of b */
+        const uint16_t *runs = b->data;
+        int next = 0;
+        for(int i = 0; i < b->count; i++)
+        {
+            if(runs[2 * i] > next)
+                words_clear_range(words, next, runs[2 * i] - 1);
+            next = runs[2 * i] + runs[2 * i + 1] + 1;
+        }
+        if(next < ROARING_CHUNK)
+            words_clear_range(words, next, ROARING_CHUNK - 1);
+    }
+
+    return container_finish_words(out, a->key, words);
+}
+
+
+/* Compute the difference of two containers with the same key (a - b) */
+static int container_difference(const RoaringContainer *a, const RoaringContainer *b, RoaringContainer *out)
+{
+    /* An array keeps the values the other container does not hold */
+    if(a->type == ROARING_ARRAY)
+    {
+        if(container_new_array(out, a->key, a->count) != 0)
+            return -1;
+
+        const uint16_t *va = a->data;
+        uint16_t *vo = out->data;
+        int k = 0;
+        for(int i = 0; i < a->count; i++)
+            if(!container_contains(b, va[i]))
+                vo[k++] = va[i];
+
+        out->count = k;
+        out->cardinality = k;
+        return 0;
+    }
+
+    /* Everything else clears the bits of b from a in bitmap form */
+    uint64_t *words = calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if(words == NULL)
+        return -1;
+    container_fill_words(a, words);
+
+    if(b->type == ROARING_ARRAY)
+    {
+        const uint16_t *vb = b->data;
+        for(int i = 0; i < b->count; i++)
+            words[vb[i] >> 6] &= ~((uint64_t)1 << (vb[i] & 63));
+    }
+    else if(b->type == ROARING_BITMAP)
+    {
+        const uint64_t *wb = b->data;
+        for(int i = 0; i < ROARING_BITMAP_WORDS; i++)
+            words[i] &= ~wb[i];
+    }
+    else
+    {
+        const uint16_t *runs = b->data;
+        for(int i = 0; i < b->count; i++)
+            words_clear_range(words, runs[2 * i], runs[2 * i] + runs[2 * i + 1]);
+    }
+
+    return container_finish_words(out, a->key, words);
+}
+
+
+
+
+/*
+*************************************
+        Private Bitmap Helpers
+*************************************
+*/
+
+/* Find the position of the first container with key >= key */
+static int roaring_find(const Roaring *bitmap, uint16_t key)
+{
+    int lo = 0, hi = bitmap->size;
+    while(lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if(bitmap->containers[mid].key < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+
+/* Make sure the bitmap has room for at least capacity containers */
+static int roaring_reserve(Roaring *bitmap, int capacity)
+{
+    if(capacity <= bitmap->capacity)
+        return 0;
+
+    int new_capacity = (bitmap->capacity > 0) ? bitmap->capacity : 4;
+    while(new_capacity < capacity)
+        new_capacity *= 2;
+
+    RoaringContainer *temp = realloc(bitmap->containers, new_capacity * sizeof(RoaringContainer));
+    if(temp == NULL)
+        return -1;
+
+    bitmap->containers = temp;
+    bitmap->capacity = new_capacity;
+    return 0;
+}
+
+
+/* Append a container (in key order) to the result of an operation, dropping it if it is empty */
+static int roaring_append(Roaring *bitmap, RoaringContainer *c)
+{
+    if(c->cardinality == 0)
+    {
+        free(c->data);
+        return 0;
+    }
+
+    if(roaring_reserve(bitmap, bitmap->size + 1) != 0)
+    {
+        free(c->data);
+        return -1;
+    }
+
+    bitmap->containers[bitmap->size] = *c;
+    bitmap->size += 1;
+    return 0;
+}
+
+
+/* Append a copy of a container to the result of an operation */
+static int roaring_append_copy(Roaring *bitmap, const RoaringContainer *src)
+{
+    RoaringContainer c;
+    if(container_copy(src, &c) != 0)
+        return -1;
+    return roaring_append(bitmap, &c);
+}
+
+
+/* Write and read little-endian integers */
+static void put_u16(unsigned char *buf, uint16_t v)
+{
+    buf[0] = (unsigned char)v;
+    buf[1] = (unsigned char)(v >> 8);
+}
+
+static void put_u32(unsigned char *buf, uint32_t v)
+{
+    put_u16(buf, (uint16_t)v);
+    put_u16(buf + 2, (uint16_t)(v >> 16));
+}
+
+static void put_u64(unsigned char *buf, uint64_t v)
+{
+    put_u32(buf, (uint32_t)v);
+    put_u32(buf + 4, (uint32_t)(v >> 32));
+}
+
+static uint16_t get_u16(const unsigned char *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static uint32_t get_u32(const unsigned char *buf)
+{
+    return (uint32_t)get_u16(buf) | ((uint32_t)get_u16(buf + 2) << 16);
+}
+
+static uint64_t get_u64(const unsigned char *buf)
+{
+    return (uint64_t)get_u32(buf) | ((uint64_t)get_u32(buf + 4) << 32);
+}
+
+
+/* Number of payload bytes a container takes when serialized */
+static size_t container_serialized_size(const RoaringContainer *c)
+{
+    if(c->type == ROARING_ARRAY)
+        return c->count * 2;
+    else if(c->type == ROARING_BITMAP)
+        return ROARING_BITMAP_WORDS * 8;
+    else
+        return c->count * 4;
+}
+
+
+
+
+/*
+************************************************
+        Interface Method Implementations
+************************************************
+*/
+
+/* Initialize a roaring bitmap */
+void roaring_init(Roaring *bitmap)
+{
+    bitmap->size = 0;
+    bitmap->capacity = 0;
+    bitmap->containers = NULL;
+}
+
+
+/* Destroy a roaring bitmap */
+void roaring_destroy(Roaring *bitmap)
+{
+    /* Free each container, then the container array, and clear the structure to be safe */
+    for(int i = 0; i < bitmap->size; i++)
+        free(bitmap->containers[i].data);
+
+    free(bitmap->containers);
+    memset(bitmap, 0, sizeof(Roaring));
+}
+
+
+/* Insert a value into a roaring bitmap */
+int roaring_insert(Roaring *bitmap, uint32_t value)
+{
+    uint16_t key = roaring_high(value);
+    int pos = roaring_find(bitmap, key);
+
+    /* Add to the existing container for this chunk */
+    if(pos < bitmap->size && bitmap->containers[pos].key == key)
+        return container_add(&bitmap->containers[pos], roaring_low(value));
+
+    /* Otherwise, create a new array container and slot it in by key */
+    if(roaring_reserve(bitmap, bitmap->size + 1) != 0)
+        return -1;
+
+    RoaringContainer c;
+    if(container_new_array(&c, key, 4) != 0)
+        return -1;
+    ((uint16_t *)c.data)[0] = roaring_low(value);
+    c.count = 1;
+    c.cardinality = 1;
+
+    memmove(&bitmap->containers[pos + 1], &bitmap->containers[pos], (bitmap->size - pos) * sizeof(RoaringContainer));
+    bitmap->containers[pos] = c;
+    bitmap->size += 1;
+
+    return 0;
+}
+
+
+/* Remove a value from a roaring bitmap */
+int roaring_remove(Roaring *bitmap, uint32_t value)
+{
+    uint16_t key = roaring_high(value);
+    int pos = roaring_find(bitmap, key);
+
+    /* Cannot remove from a chunk with no container */
+    if(pos == bitmap->size || bitmap->containers[pos].key != key)
+        return -1;
+
+    RoaringContainer *c = &bitmap->containers[pos];
+    if(container_delete(c, roaring_low(value)) != 0)
+        return -1;
+
+    /* Drop containers that become empty */
+    if(c->cardinality == 0)
+    {
+        free(c->data);
+        memmove(&bitmap->containers[pos], &bitmap->containers[pos + 1], (bitmap->size - pos - 1) * sizeof(RoaringContainer));
+        bitmap->size -= 1;
+    }
+
+    return 0;
+}
+
+
+/* Determine whether a value is in a roaring bitmap */
+int roaring_is_element(const Roaring *bitmap, uint32_t value)
+{
+    uint16_t key = roaring_high(value);
+    int pos = roaring_find(bitmap, key);
+
+    if(pos == bitmap->size || bitmap->containers[pos].key != key)
+        return 0;
+
+    return container_contains(&bitmap->containers[pos], roaring_low(value));
+}
+
+
+/* Compute the union of two roaring bitmaps */
+int roaring_union(Roaring *bitmapr, const Roaring *bitmap1, const Roaring *bitmap2)
+{
+    roaring_init(bitmapr);
+
+    /* Merge the containers by key -- Containers in only one bitmap are copied */
+    int i = 0, j = 0, retval = 0;
+    while(retval == 0 && (i < bitmap1->size || j < bitmap2->size))
+    {
+        const RoaringContainer *a = (i < bitmap1->size) ? &bitmap1->containers[i] : NULL;
+        const RoaringContainer *b = (j < bitmap2->size) ? &bitmap2->containers[j] : NULL;
+
+        if(b == NULL || (a != NULL && a->key < b->key))
+        {
+            retval = roaring_append_copy(bitmapr, a);
+            i++;
+        }
+        else if(a == NULL || b->key < a->key)
+        {
+            retval = roaring_append_copy(bitmapr, b);
+            j++;
+        }
+        else
+        {
+            RoaringContainer c;
+            retval = container_union(a, b, &c);
+            if(retval == 0)
+                retval = roaring_append(bitmapr, &c);
+            i++;
+            j++;
+        }
+    }
+
+    /* Destroy the partial result if anything failed */
+    if(retval != 0)
+    {
+        roaring_destroy(bitmapr);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/* Compute the intersection of two roaring bitmaps */
+int roaring_intersection(Roaring *bitmapr, const Roaring *bitmap1, const Roaring *bitmap2)
+{
+    roaring_init(bitmapr);
+
+    /* Only containers with a key in both bitmaps can contribute */
+    int i = 0, j = 0, retval = 0;
+    while(retval == 0 && i < bitmap1->size && j < bitmap2->size)
+    {
+        const RoaringContainer *a = &bitmap1->containers[i];
+        const RoaringContainer *b = &bitmap2->containers[j];
+
+        if(a->key < b->key)
+            i++;
+        else if(b->key < a->key)
+            j++;
+        else
+        {
+            RoaringContainer c;
+            retval = container_intersection(a, b, &c);
+            if(retval == 0)
+                retval = roaring_append(bitmapr, &c);
+            i++;
+            j++;
+        }
+    }
+
+    /* Destroy the partial result if anything failed */
+    if(retval != 0)
+    {
+        roaring_destroy(bitmapr);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/* Compute the difference of two roaring bitmaps (bitmap1 - bitmap2) */
+int roaring_difference(Roaring *bitmapr, const Roaring *bitmap1, const Roaring *bitmap2)
+{
+    roaring_init(bitmapr);
+
+    /* Containers of bitmap1 with no counterpart in bitmap2 are copied */
+    int i = 0, j = 0, retval = 0;
+    while(retval == 0 && i < bitmap1->size)
+    {
+        const RoaringContainer *a = &bitmap1->containers[i];
+
+        /* Skip the containers of bitmap2 that come before this key */
+        while(j < bitmap2->size && bitmap2->containers[j].key < a->key)
+            j++;
+
+        if(j < bitmap2->size && bitmap2->containers[j].key == a->key)
+        {
+            RoaringContainer c;
+            retval = container_difference(a, &bitmap2->containers[j], &c);
+            if(retval == 0)
+                retval = roaring_append(bitmapr, &c);
+        }
+        else
+            retval = roaring_append_copy(bitmapr, a);
+
+        i++;
+    }
+
+    /* Destroy the partial result if anything failed */
+    if(retval != 0)
+    {
+        roaring_destroy(bitmapr);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/* Count the values in a roaring bitmap */
+uint64_t roaring_cardinality(const Roaring *bitmap)
+{
+    uint64_t card = 0;
+    for(int i = 0; i < bitmap->size; i++)
+        card += bitmap->containers[i].cardinality;
+    return card;
+}
+
+
+/* Convert each container to its smallest form */
+int roaring_optimize(Roaring *bitmap)
+{
+    for(int i = 0; i < bitmap->size; i++)
+    {
+        RoaringContainer *c = &bitmap->containers[i];
+
+        /* Work from the bitmap form of the container */
+        uint64_t *words = calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+        if(words == NULL)
+            return -1;
+        container_fill_words(c, words);
+
+        /* Count the runs -- A run starts at each set bit whose lower neighbour is clear */
+        int runs = 0;
+        uint64_t carry = 0;
+        for(int w = 0; w < ROARING_BITMAP_WORDS; w++)
+        {
+            runs += __builtin_popcountll(words[w] & ~((words[w] << 1) | carry));
+            carry = words[w] >> 63;
+        }
+
+        /* Compare the sizes of each form (ties go to the array and bitmap forms) */
+        size_t run_bytes = (size_t)runs * 4;
+        size_t other_bytes = (c->cardinality <= ROARING_ARRAY_MAX) ? (size_t)c->cardinality * 2 : ROARING_BITMAP_WORDS * 8;
+
+        if(run_bytes < other_bytes)
+        {
+            if(c->type == ROARING_RUN)
+            {
+                free(words);
+                continue;
+            }
+
+            uint16_t *pairs = malloc(run_bytes);
+            if(pairs == NULL)
+            {
+                free(words);
+                return -1;
+            }
+
+            /* Walk from each run start to the following clear bit */
+            int k = 0, pos = words_next(words, 0, 1);
+            while(pos < ROARING_CHUNK)
+            {
+                int end = words_next(words, pos, 0);
+                pairs[2 * k] = (uint16_t)pos;
+                pairs[2 * k + 1] = (uint16_t)(end - pos - 1);
+                k++;
+                pos = (end < ROARING_CHUNK) ? words_next(words, end, 1) : ROARING_CHUNK;
+            }
+            free(words);
+
+            free(c->data);
+            c->type = ROARING_RUN;
+            c->count = runs;
+            c->capacity = runs;
+            c->data = pairs;
+        }
+        else if(c->type == ROARING_RUN || (c->type == ROARING_ARRAY) != (c->cardinality <= ROARING_ARRAY_MAX))
+        {
+            void *old = c->data;
+            if(container_from_words(c, words, c->cardinality) != 0)
+            {
+                free(words);
+                return -1;
+            }
+            free(old);
+        }
+        else
+            free(words);
+    }
+
+    return 0;
+}
+
+
+/* Begin iterating over the values of a roaring bitmap */
+void roaring_iter_init(RoaringIter *iter, const Roaring *bitmap)
+{
+    iter->bitmap = bitmap;
+    iter->container = 0;
+    iter->pos = 0;
+    iter->run = 0;
+}
+
+
+/* Get the next value of an iteration */
+int roaring_iter_next(RoaringIter *iter, uint32_t *value)
+{
+    while(iter->container < iter->bitmap->size)
+    {
+        const RoaringContainer *c = &iter->bitmap->containers[iter->container];
+        uint32_t base = (uint32_t)c->key << 16;
+
+        if(c->type == ROARING_ARRAY)
+        {
+            if(iter->pos < c->count)
+            {
+                *value = base | ((const uint16_t *)c->data)[iter->pos++];
+                return 1;
+            }
+        }
+        else if(c->type == ROARING_BITMAP)
+        {
+            int pos = words_next(c->data, iter->pos, 1);
+            if(pos < ROARING_CHUNK)
+            {
+                *value = base | (uint32_t)pos;
+                iter->pos = pos + 1;
+                return 1;
+            }
+        }
+        else if(iter->run < c->count)
+        {
+            const uint16_t *runs = c->data;
+            *value = base | (uint32_t)(runs[2 * iter->run] + iter->pos);
+
+            /* Move to the next run once this one is used up */
+            if(iter->pos == runs[2 * iter->run + 1])
+            {
+                iter->run += 1;
+                iter->pos = 0;
+            }
+            else
+                iter->pos += 1;
+            return 1;
+        }
+
+        /* This container is used up, so move to the next */
+        iter->container += 1;
+        iter->pos = 0;
+        iter->run = 0;
+    }
+
+    return 0;
+}
+
+
+/* Get the number of bytes needed to serialize a roaring bitmap */
+size_t roaring_serialized_size(const Roaring *bitmap)
+{
+    size_t bytes = ROARING_HEADER_BYTES;
+    for(int i = 0; i < bitmap->size; i++)
+        bytes += ROARING_CONTAINER_HEADER_BYTES + container_serialized_size(&bitmap->containers[i]);
+    return bytes;
+}
+
+
+/* Serialize a roaring bitmap */
+size_t roaring_serialize(const Roaring *bitmap, unsigned char *buf)
+{
+    unsigned char *p = buf;
+
+    put_u32(p, (uint32_t)bitmap->size);
+    p += ROARING_HEADER_BYTES;
+
+    for(int i = 0; i < bitmap->size; i++)
+    {
+        const RoaringContainer *c = &bitmap->containers[i];
+
+        /* Container header -- Bitmap containers store their cardinality as their count */
+        put_u16(p, c->key);
+        p[2] = (unsigned char)c->type;
+        put_u32(p + 3, (uint32_t)((c->type == ROARING_BITMAP) ? c->cardinality : c->count));
+        p += ROARING_CONTAINER_HEADER_BYTES;
+
+        /* Container payload */
+        if(c->type == ROARING_BITMAP)
+        {
+            const uint64_t *words = c->data;
+            for(int w = 0; w < ROARING_BITMAP_WORDS; w++, p += 8)
+                put_u64(p, words[w]);
+        }
+        else
+        {
+            const uint16_t *values = c->data;
+            int n = (c->type == ROARING_ARRAY) ? c->count : 2 * c->count;
+            for(int v = 0; v < n; v++, p += 2)
+                put_u16(p, values[v]);
+        }
+    }
+
+    return (size_t)(p - buf);
+}
+
+
+/* Deserialize a roaring bitmap */
+int roaring_deserialize(Roaring *bitmap, const unsigned char *buf, size_t len)
+{
+    roaring_init(bitmap);
+
+    if(len < ROARING_HEADER_BYTES)
+        return -1;
+
+    /* Make sure the container count is plausible before allocating for it */
+    uint32_t n = get_u32(buf);
+    if(n > ROARING_CHUNK || (size_t)n * ROARING_CONTAINER_HEADER_BYTES > len - ROARING_HEADER_BYTES)
+        return -1;
+    if(roaring_reserve(bitmap, (int)n) != 0)
+        return -1;
+
+    const unsigned char *p = buf + ROARING_HEADER_BYTES, *end = buf + len;
+    for(uint32_t i = 0; i < n; i++)
+    {
+        if((size_t)(end - p) < ROARING_CONTAINER_HEADER_BYTES)
+            goto malformed;
+
+        RoaringContainer c;
+        c.key = get_u16(p);
+        c.type = p[2];
+        uint32_t count = get_u32(p + 3);
+        p += ROARING_CONTAINER_HEADER_BYTES;
+
+        /* Keys must be strictly increasing */
+        if(i > 0 && c.key <= bitmap->containers[i - 1].key)
+            goto malformed;
+
+        /* Check the count before trusting the payload size */
+        size_t bytes;
+        if(c.type == ROARING_ARRAY && count >= 1 && count <= ROARING_ARRAY_MAX)
+            bytes = count * 2;
+        else if(c.type == ROARING_BITMAP && count >= 1 && count <= ROARING_CHUNK)
+            bytes = ROARING_BITMAP_WORDS * 8;
+        else if(c.type == ROARING_RUN && count >= 1 && count <= ROARING_CHUNK / 2)
+            bytes = count * 4;
+        else
+            goto malformed;
+
+        if((size_t)(end - p) < bytes)
+            goto malformed;
+
+        c.data = malloc(bytes);
+        if(c.data == NULL)
+        {
+            roaring_destroy(bitmap);
+            return -1;
+        }
+
+        int valid = 1;
+        if(c.type == ROARING_BITMAP)
+        {
+            /* The stored cardinality must match the bits */
+            uint64_t *words = c.data;
+            for(int w = 0; w < ROARING_BITMAP_WORDS; w++)
+                words[w] = get_u64(p + 8 * w);
+            c.count = ROARING_BITMAP_WORDS;
+            c.cardinality = words_cardinality(words);
+            valid = ((uint32_t)c.cardinality == count);
+        }
+        else if(c.type == ROARING_ARRAY)
+        {
+            /* Values must be strictly increasing */
+            uint16_t *values = c.data;
+            for(uint32_t v = 0; v < count; v++)
+            {
+                values[v] = get_u16(p + 2 * v);
+                if(v > 0 && values[v] <= values[v - 1])
+                    valid = 0;
+            }
+            c.count = (int)count;
+            c.cardinality = (int)count;
+        }
+        else
+        {
+            /* Runs must stay within the chunk and must not overlap */
+            uint16_t *runs = c.data;
+            int next = 0;
+            c.cardinality = 0;
+            for(uint32_t r = 0; r < count; r++)
+            {
+                runs[2 * r] = get_u16(p + 4 * r);
+                runs[2 * r + 1] = get_u16(p + 4 * r + 2);
+                if(runs[2 * r] < next || runs[2 * r] + runs[2 * r + 1] >= ROARING_CHUNK)
+                    valid = 0;
+                next = runs[2 * r] + runs[2 * r + 1] + 1;
+                c.cardinality += runs[2 * r + 1] + 1;
+            }
+            c.count = (int)count;
+        }
+        c.capacity = c.count;
+        p += bytes;
+
+        /* Keep the container even if it is invalid so roaring_destroy() frees it */
+        bitmap->containers[i] = c;
+        bitmap->size += 1;
+        if(!valid)
+            goto malformed;
+    }
+
+    return 0;
+
+malformed:
+    roaring_destroy(bitmap);
+    return -1;
+}
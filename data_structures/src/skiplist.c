@@ -0,0 +1,191 @@
+/* Implementation of Skip List */
+#include <stdlib.h>
+#include <string.h>
+
+#include "skiplist.h"
+
+
+/* Allocate a node with its forward pointers in the same block */
+static SkipListNode *skiplist_node_new(const void *data, int level)
+{
+    SkipListNode *node = malloc(sizeof(SkipListNode) + level * sizeof(SkipListNode *));
+    if(node == NULL)
+        return NULL;
+
+    node->data = (void *)data;
+    node->level = level;
+    for(int i = 0; i < level; i++)
+        node->forward[i] = NULL;
+
+    return node;
+}
+
+
+/* Draw a level -- Each extra level is kept with probability 1/4 (two zero bits of an xorshift value) */
+static int skiplist_random_level(SkipList *list)
+{
+    unsigned int x = list->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->seed = x;
+
+    int level = 1;
+    while( ((x & 3) == 0) && (level < SKIPLIST_MAX_LEVEL) )
+    {
+        level += 1;
+        x >>= 2;
+    }
+    return level;
+}
+
+
+/* Find the last node before key on every level in use -- Fills update[] and returns the level-0 successor */
+static SkipListNode *skiplist_search(const SkipList *list, const void *key, SkipListNode **update)
+{
+    SkipListNode *node = list->head;
+
+    for(int i = list->level - 1; i >= 0; i--)
+    {
+        while( (node->forward[i] != NULL) && (list->compare(node->forward[i]->data, key) < 0) )
+            node = node->forward[i];
+
+        if(update != NULL)
+            update[i] = node;
+    }
+
+    return node->forward[0];
+}
+
+
+/* Initialize a Skip List */
+int skiplist_init(SkipList *list, int (*compare)(const void *key1, const void *key2), void (*destroy)(void *data))
+{
+    if( (list->head = skiplist_node_new(NULL, SKIPLIST_MAX_LEVEL)) == NULL )
+        return -1;
+
+    list->size = 0;
+    list->level = 1;
+    list->seed = 2463534242u;
+    list->compare = compare;
+    list->destroy = destroy;
+
+    return 0;
+}
+
+
+/* Destroy a Skip List */
+void skiplist_destroy(SkipList *list)
+{
+    SkipListNode *node = list->head->forward[0], *next;
+
+    /* Walk level 0, which links every node */
+    while(node != NULL)
+    {
+        next = node->forward[0];
+        if(list->destroy != NULL)
+            list->destroy(node->data);
+        free(node);
+        node = next;
+    }
+
+    free(list->head);
+
+    /* To be safe, clear the structure */
+    memset(list, 0, sizeof(SkipList));
+}
+
+
+/* Insert an element into a Skip List */
+int skiplist_insert(SkipList *list, const void *data)
+{
+    SkipListNode *update[SKIPLIST_MAX_LEVEL];
+    SkipListNode *node = skiplist_search(list, data, update);
+
+    /* Do not allow duplicates */
+    if( (node != NULL) && (list->compare(node->data, data) == 0) )
+        return 1;
+
+    int level = skiplist_random_level(list);
+    if( (node = skiplist_node_new(data, level)) == NULL )
+        return -1;
+
+    /* New levels start from the header */
+    for(int i = list->level; i < level; i++)
+        update[i] = list->head;
+    if(level > list->level)
+        list->level = level;
+
+    /* Link the node in on each of its levels */
+    for(int i = 0; i < level; i++)
+    {
+        node->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = node;
+    }
+
+    list->size += 1;
+    return 0;
+}
+
+
+/* Remove an element from a Skip List */
+int skiplist_remove(SkipList *list, void **data)
+{
+    SkipListNode *update[SKIPLIST_MAX_LEVEL];
+    SkipListNode *node = skiplist_search(list, *data, update);
+
+    if( (node == NULL) || (list->compare(node->data, *data) != 0) )
+        return -1;
+
+    /* Unlink the node from each of its levels */
+    for(int i = 0; i < node->level; i++)
+        update[i]->forward[i] = node->forward[i];
+
+    /* Drop levels that are now empty */
+    while( (list->level > 1) && (list->head->forward[list->level - 1] == NULL) )
+        list->level -= 1;
+
+    *data = node->data;
+    free(node);
+    list->size -= 1;
+
+    return 0;
+}
+
+
+/* Find an element in a Skip List */
+int skiplist_lookup(const SkipList *list, void **data)
+{
+    SkipListNode *node = skiplist_search(list, *data, NULL);
+
+    if( (node == NULL) || (list->compare(node->data, *data) != 0) )
+        return -1;
+
+    *data = node->data;
+    return 0;
+}
+
+
+/* Find the first element not less than a key */
+SkipListNode *skiplist_lower_bound(const SkipList *list, const void *key)
+{
+    return skiplist_search(list, key, NULL);
+}
+
+
+/* Visit every element in a half-open key range */
+int skiplist_range(const SkipList *list, const void *low, const void *high, int (*callback)(const void *data, void *arg), void *arg)
+{
+    SkipListNode *node = (low == NULL) ? list->head->forward[0] : skiplist_search(list, low, NULL);
+    int visited = 0;
+
+    while( (node != NULL) && ((high == NULL) || (list->compare(node->data, high) < 0)) )
+    {
+        visited += 1;
+        if(callback(node->data, arg) != 0)
+            break;
+        node = node->forward[0];
+    }
+
+    return visited;
+}
@@ -0,0 +1,304 @@
+/* Implementation of Space-Saving Heavy Hitters */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "spacesaving.h"
+
+
+/* Spread a key over the index (splitmix64 finalizer) */
+static uint64_t spacesaving_hash(uint64_t key)
+{
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+
+    return key;
+}
+
+
+/* Index slot holding a key's counter, or the free slot where it would go */
+static int spacesaving_slot(const SpaceSaving *summary, uint64_t key)
+{
+    int slot = (int)(spacesaving_hash(key) & summary->index_mask);
+
+    while(summary->index[slot] >= 0 && summary->counters[summary->index[slot]].key != key)
+        slot = (slot + 1) & summary->index_mask;
+
+    return slot;
+}
+
+
+/* Remove a key from the index, shifting later entries of its probe run back so lookups never stop short */
+static void spacesaving_unindex(SpaceSaving *summary, uint64_t key)
+{
+    int hole = spacesaving_slot(summary, key), slot = hole;
+    summary->index[hole] = -1;
+
+    while(1)
+    {
+        slot = (slot + 1) & summary->index_mask;
+        if(summary->index[slot] < 0)
+            return;
+
+        /* An entry may fill the hole only if its home slot is not between the hole and where it sits */
+        int home = (int)(spacesaving_hash(summary->counters[summary->index[slot]].key) & summary->index_mask);
+        if( ((slot - home) & summary->index_mask) >= ((slot - hole) & summary->index_mask) )
+        {
+            summary->index[hole] = summary->index[slot];
+            summary->index[slot] = -1;
+            hole = slot;
+        }
+    }
+}
+
+
+/* Swap two heap slots, keeping the counters' positions in step */
+static void spacesaving_swap(SpaceSaving *summary, int a, int b)
+{
+    int counter = summary->heap[a];
+    summary->heap[a] = summary->heap[b];
+    summary->heap[b] = counter;
+
+    summary->counters[summary->heap[a]].position = a;
+    summary->counters[summary->heap[b]].position = b;
+}
+
+
+/* Move a heap slot up while it is smaller than its parent */
+static void spacesaving_sift_up(SpaceSaving *summary, int position)
+{
+    while(position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if(summary->counters[summary->heap[parent]].count <= summary->counters[summary->heap[position]].count)
+            return;
+
+        spacesaving_swap(summary, parent, position);
+        position = parent;
+    }
+}
+
+
+/* Move a heap slot down while it is larger than a child -- Counts only grow, so this is all an update needs */
+static void spacesaving_sift_down(SpaceSaving *summary, int position)
+{
+    while(1)
+    {
+        int left = 2 * position + 1, right = left + 1, smallest = position;
+
+        if(left < summary->size && summary->counters[summary->heap[left]].count < summary->counters[summary->heap[smallest]].count)
+            smallest = left;
+        if(right < summary->size && summary->counters[summary->heap[right]].count < summary->counters[summary->heap[smallest]].count)
+            smallest = right;
+
+        if(smallest == position)
+            return;
+
+        spacesaving_swap(summary, position, smallest);
+        position = smallest;
+    }
+}
+
+
+/* Start tracking a key in the next free counter */
+static void spacesaving_track(SpaceSaving *summary, int slot, uint64_t key, uint64_t count, uint64_t error)
+{
+    int counter = summary->size++;
+
+    summary->counters[counter].key = key;
+    summary->counters[counter].count = count;
+    summary->counters[counter].error = error;
+    summary->counters[counter].position = counter;
+    summary->heap[counter] = counter;
+    summary->index[slot] = counter;
+
+    spacesaving_sift_up(summary, counter);
+}
+
+
+/* Order counters by decreasing count for qsort() */
+static int spacesaving_compare(const void *key1, const void *key2)
+{
+    uint64_t a = ((const SSCounter *)key1)->count, b = ((const SSCounter *)key2)->count;
+    return (a < b) ? 1 : (a > b) ? -1 : 0;
+}
+
+
+/* Initialize a space-saving summary */
+int spacesaving_init(SpaceSaving *summary, int capacity)
+{
+    if(capacity < 1 || capacity > (1 << 28))
+        return -1;
+
+    int slots = 1;
+    while(slots < 2 * capacity)
+        slots <<= 1;
+
+    summary->capacity = capacity;
+    summary->size = 0;
+    summary->total = 0;
+    summary->index_mask = slots - 1;
+
+    summary->counters = malloc(capacity * sizeof(SSCounter));
+    summary->heap = malloc(capacity * sizeof(int));
+    summary->index = malloc(slots * sizeof(int));
+
+    if(summary->counters == NULL || summary->heap == NULL || summary->index == NULL)
+    {
+        spacesaving_destroy(summary);
+        return -1;
+    }
+
+    memset(summary->index, -1, slots * sizeof(int));
+
+    return 0;
+}
+
+
+/* Destroy a space-saving summary */
+void spacesaving_destroy(SpaceSaving *summary)
+{
+    free(summary->counters);
+    free(summary->heap);
+    free(summary->index);
+
+    /* To be safe, clear the structure */
+    memset(summary, 0, sizeof(SpaceSaving));
+}
+
+
+/* Count occurrences of a key */
+void spacesaving_add(SpaceSaving *summary, uint64_t key, uint64_t count)
+{
+    int slot = spacesaving_slot(summary, key);
+    summary->total += count;
+
+    /* Tracked -- Its count grows, so it can only sink in the min-heap */
+    if(summary->index[slot] >= 0)
+    {
+        SSCounter *counter = &summary->counters[summary->index[slot]];
+        counter->count += count;
+        spacesaving_sift_down(summary, counter->position);
+        return;
+    }
+
+    if(summary->size < summary->capacity)
+    {
+        spacesaving_track(summary, slot, key, count, 0);
+        return;
+    }
+
+    /* Full -- The key takes over the smallest counter, whose count becomes its error */
+    int smallest = summary->heap[0];
+    SSCounter *counter = &summary->counters[smallest];
+
+    spacesaving_unindex(summary, counter->key);
+    counter->key = key;
+    counter->error = counter->count;
+    counter->count += count;
+    summary->index[spacesaving_slot(summary, key)] = smallest;
+
+    spacesaving_sift_down(summary, 0);
+}
+
+
+/* Count occurrences of an array of keys */
+void spacesaving_add_n(SpaceSaving *summary, const uint64_t *keys, const uint64_t *counts, int n)
+{
+    for(int i = 0; i < n; i++)
+        spacesaving_add(summary, keys[i], (counts != NULL) ? counts[i] : 1);
+}
+
+
+/* Look up the estimate for a key */
+int spacesaving_lookup(const SpaceSaving *summary, uint64_t key, SSCounter *counter)
+{
+    int slot = spacesaving_slot(summary, key);
+    if(summary->index[slot] < 0)
+        return -1;
+
+    *counter = summary->counters[summary->index[slot]];
+    return 0;
+}
+
+
+/* Get the most frequent keys */
+int spacesaving_top(const SpaceSaving *summary, SSCounter *top, int n)
+{
+    SSCounter *sorted = malloc(summary->size * sizeof(SSCounter) + 1);
+    if(sorted == NULL)
+        return 0;
+
+    memcpy(sorted, summary->counters, summary->size * sizeof(SSCounter));
+    qsort(sorted, summary->size, sizeof(SSCounter), spacesaving_compare);
+
+    if(n > summary->size)
+        n = summary->size;
+    memcpy(top, sorted, n * sizeof(SSCounter));
+
+    free(sorted);
+    return n;
+}
+
+
+/* Merge another summary into this one */
+int spacesaving_merge(SpaceSaving *summary, const SpaceSaving *other)
+{
+    int size = summary->size + other->size;
+    SSCounter *merged = malloc(size * sizeof(SSCounter) + 1);
+    if(merged == NULL)
+        return -1;
+
+    /* What a key missing from a summary may have had there */
+    uint64_t own_min = spacesaving_min(summary), other_min = spacesaving_min(other);
+
+    /* Keys of this summary, plus their count in the other (or the other's bound) */
+    int n = 0;
+    for(int i = 0; i < summary->size; i++)
+    {
+        SSCounter counter = summary->counters[i], found;
+        if(spacesaving_lookup(other, counter.key, &found) == 0)
+        {
+            counter.count += found.count;
+            counter.error += found.error;
+        }
+        else
+        {
+            counter.count += other_min;
+            counter.error += other_min;
+        }
+        merged[n++] = counter;
+    }
+
+    /* Keys only the other summary has */
+    for(int i = 0; i < other->size; i++)
+    {
+        SSCounter counter = other->counters[i], found;
+        if(spacesaving_lookup(summary, counter.key, &found) == 0)
+            continue;
+
+        counter.count += own_min;
+        counter.error += own_min;
+        merged[n++] = counter;
+    }
+
+    /* Keep the largest counters of the union */
+    qsort(merged, n, sizeof(SSCounter), spacesaving_compare);
+    if(n > summary->capacity)
+        n = summary->capacity;
+
+    uint64_t total = summary->total + other->total;
+    summary->size = 0;
+    memset(summary->index, -1, (summary->index_mask + 1) * sizeof(int));
+
+    for(int i = 0; i < n; i++)
+        spacesaving_track(summary, spacesaving_slot(summary, merged[i].key), merged[i].key, merged[i].count, merged[i].error);
+
+    summary->total = total;
+    free(merged);
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/* Implementation of Single-Producer/Single-Consumer Queue */
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "spscq.h"
+
+
+/* Initialize a single-producer/single-consumer queue */
+int spscq_init(SPSCQueue *queue, size_t capacity)
+{
+    /* Round up to a power of two so positions wrap with a mask */
+    size_t slots = 1;
+    while(slots < capacity)
+        slots <<= 1;
+
+    if( (queue->slots = calloc(slots, sizeof(void *))) == NULL )
+        return -1;
+
+    queue->capacity = slots;
+    queue->mask = slots - 1;
+    queue->head_cache = 0;
+    queue->tail_cache = 0;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+
+    return 0;
+}
+
+
+/* Destroy a single-producer/single-consumer queue */
+void spscq_destroy(SPSCQueue *queue)
+{
+    free(queue->slots);
+
+    /* To be safe, clear the structure */
+    memset(queue, 0, sizeof(SPSCQueue));
+}
+
+
+/* Push an element onto the queue */
+int spscq_push(SPSCQueue *queue, const void *data)
+{
+    /* tail is ours, so a relaxed load suffices */
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    /* Only reread the consumer's head when the cached copy says the queue is full */
+    if(tail - queue->head_cache == queue->capacity)
+    {
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if(tail - queue->head_cache == queue->capacity)
+            return -1;
+    }
+
+    /* Write the slot, then publish it -- The release store orders the slot write before the new tail */
+    queue->slots[tail & queue->mask] = (void *)data;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+    return 0;
+}
+
+
+/* Pop an element from the queue */
+int spscq_pop(SPSCQueue *queue, void **data)
+{
+    /* head is ours, so a relaxed load suffices */
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    /* Only reread the producer's tail when the cached copy says the queue is empty */
+    if(head == queue->tail_cache)
+    {
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if(head == queue->tail_cache)
+            return -1;
+    }
+
+    /* Read the slot, then hand it back to the producer */
+    *data = queue->slots[head & queue->mask];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+    return 0;
+}
+
+
+/* Push as many elements of an array as fit */
+size_t spscq_push_n(SPSCQueue *queue, void **data, size_t count)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t room = queue->capacity - (tail - queue->head_cache);
+
+    /* Refresh the cached head only if it cannot satisfy the whole batch */
+    if(room < count)
+    {
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        room = queue->capacity - (tail - queue->head_cache);
+    }
+    if(count > room)
+        count = room;
+
+    for(size_t i = 0; i < count; i++)
+        queue->slots[(tail + i) & queue->mask] = data[i];
+
+    /* One release store publishes the whole batch */
+    if(count > 0)
+        atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+
+    return count;
+}
+
+
+/* Pop up to count elements */
+size_t spscq_pop_n(SPSCQueue *queue, void **data, size_t count)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t available = queue->tail_cache - head;
+
+    /* Refresh the cached tail only if it cannot satisfy the whole batch */
+    if(available < count)
+    {
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->tail_cache - head;
+    }
+    if(count > available)
+        count = available;
+
+    for(size_t i = 0; i < count; i++)
+        data[i] = queue->slots[(head + i) & queue->mask];
+
+    /* One release store hands the whole batch back to the producer */
+    if(count > 0)
+        atomic_store_explicit(&queue->head, head + count, memory_order_release);
+
+    return count;
+}
+
+
+/* Number of elements in the queue */
+size_t spscq_size(const SPSCQueue *queue)
+{
+    /* Load head first -- tail can only have moved further since, so the difference never underflows */
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    size_t size = tail - head;
+
+    return (size > queue->capacity) ? queue->capacity : size;
+}
@@ -0,0 +1,532 @@
+/* Implementation of Sorted-Array Sets */
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "sset.h"
+
+/*
+*************************************
+        Private Useful Macros
+*************************************
+*/
+
+/* Intersect by galloping once the larger set has this many times more members than the smaller one */
+#define SSET_GALLOP_RATIO 32
+
+
+
+
+/*
+*************************************
+        Private Helper Functions
+*************************************
+*/
+
+/* Make sure the set has room for at least capacity members */
+static int sset_reserve(SSet *set, int capacity)
+{
+    /* Nothing to do if there is already enough room */
+    if(capacity <= set->capacity)
+        return 0;
+
+    /* Grow geometrically so repeated appends are amortized O(1) */
+    int new_capacity = (set->capacity > 0) ? set->capacity : 8;
+    while(new_capacity < capacity)
+        new_capacity *= 2;
+
+    unsigned int *temp = realloc(set->members, new_capacity * sizeof(unsigned int));
+    if(temp == NULL)
+        return -1;
+
+    set->members = temp;
+    set->capacity = new_capacity;
+
+    return 0;
+}
+
+
+/* Find the position of the first member >= data (i.e., where data is or would be inserted) */
+static int sset_lower_bound(const unsigned int *members, int lo, int hi, unsigned int data)
+{
+    /* Standard binary search over [lo, hi) */
+    while(lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if(members[mid] < data)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+
+/* Find the position of the first member >= data, starting at lo and doubling the step until data is passed */
+static int sset_gallop(const unsigned int *members, int lo, int n, unsigned int data)
+{
+    /* Quick test -- Most of the time the next member is already large enough */
+    if(lo >= n || members[lo] >= data)
+        return lo;
+
+    /* Gallop forward until members[lo + step] >= data (or we run off the end) */
+    int step = 1;
+    while(lo + step < n && members[lo + step] < data)
+    {
+        lo += step;
+        step *= 2;
+    }
+
+    /* The answer now lies in (lo, lo + step], so finish with a binary search */
+    int hi = (lo + step < n) ? lo + step + 1 : n;
+    return sset_lower_bound(members, lo + 1, hi, data);
+}
+
+
+/* Intersect the tails of two sorted arrays with a scalar merge, returning the number of members written to out */
+static int sset_intersect_scalar(const unsigned int *a, int i, int m, const unsigned int *b, int j, int n, unsigned int *out, int k)
+{
+    while(i < m && j < n)
+    {
+        if(a[i] < b[j])
+            i++;
+        else if(b[j] < a[i])
+            j++;
+        else
+        {
+            out[k++] = a[i];
+            i++;
+            j++;
+        }
+    }
+
+    return k;
+}
+
+
+/* Intersect by looking up each member of the small array in the large array with galloping */
+static int sset_intersect_gallop(const unsigned int *small, int m, const unsigned int *large, int n, unsigned int *out)
+{
+    int k = 0, pos = 0;
+
+    for(int i = 0; i < m && pos < n; i++)
+    {
+        pos = sset_gallop(large, pos, n, small[i]);
+        if(pos < n && large[pos] == small[i])
+            out[k++] = small[i];
+    }
+
+    return k;
+}
+
+
+/* Intersect two arrays of similar size, comparing whole blocks of members at once when SIMD is available
+     - Each step compares a block of a against every rotation of a block of b, so one movemask tells which members of a occur in b
+     - Whichever block ends with the smaller member cannot match anything further and is advanced (both on a tie)
+*/
+static int sset_intersect_merge(const unsigned int *a, int m, const unsigned int *b, int n, unsigned int *out)
+{
+    int i = 0, j = 0, k = 0;
+
+#if defined(__AVX2__)
+    /* Compare 8x8 members per step */
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while(i + 8 <= m && j + 8 <= n)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+        __m256i cmp = _mm256_cmpeq_epi32(va, vb);
+
+        for(int r = 1; r < 8; r++)
+        {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, vb));
+        }
+
+        /* Copy the matching members of a to the output */
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(cmp));
+        while(mask)
+        {
+            out[k++] = a[i + __builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+
+        unsigned int amax = a[i + 7], bmax = b[j + 7];
+        if(amax <= bmax)
+            i += 8;
+        if(bmax <= amax)
+            j += 8;
+    }
+#elif defined(__SSE2__)
+    /* Compare 4x4 members per step */
+    while(i + 4 <= m && j + 4 <= n)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        __m128i cmp = _mm_cmpeq_epi32(va, vb);
+
+        vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        cmp = _mm_or_si128(cmp, _mm_cmpeq_epi32(va, vb));
+        vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        cmp = _mm_or_si128(cmp, _mm_cmpeq_epi32(va, vb));
+        vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        cmp = _mm_or_si128(cmp, _mm_cmpeq_epi32(va, vb));
+
+        /* Copy the matching members of a to the output */
+        unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(cmp));
+        while(mask)
+        {
+            out[k++] = a[i + __builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+
+        unsigned int amax = a[i + 3], bmax = b[j + 3];
+        if(amax <= bmax)
+            i += 4;
+        if(bmax <= amax)
+            j += 4;
+    }
+#endif
+
+    /* Finish whatever is left (or everything, without SIMD) with a scalar merge */
+    return sset_intersect_scalar(a, i, m, b, j, n, out, k);
+}
+
+
+
+
+/*
+************************************************
+        Interface Method Implementations
+************************************************
+*/
+
+/* Initialize a sorted-array set */
+void sset_init(SSet *set)
+{
+    set->size = 0;
+    set->capacity = 0;
+    set->members = NULL;
+}
+
+
+/* Destroy a sorted-array set */
+void sset_destroy(SSet *set)
+{
+    /* Free the array of members and clear the structure to be safe */
+    free(set->members);
+    memset(set, 0, sizeof(SSet));
+}
+
+
+/* Insert a new member into the set */
+int sset_insert(SSet *set, unsigned int data)
+{
+    /* Find where the member belongs -- Appending in ascending order skips the search entirely */
+    int pos;
+    if(sset_size(set) == 0 || set->members[sset_size(set) - 1] < data)
+        pos = sset_size(set);
+    else
+    {
+        pos = sset_lower_bound(set->members, 0, sset_size(set), data);
+
+        /* Only allow unique members in the set */
+        if(set->members[pos] == data)
+            return -1;
+    }
+
+    /* Make room for the new member */
+    if(sset_reserve(set, sset_size(set) + 1) != 0)
+        return -1;
+
+    /* Shift the larger members up by one and store the new member */
+    memmove(&set->members[pos + 1], &set->members[pos], (sset_size(set) - pos) * sizeof(unsigned int));
+    set->members[pos] = data;
+    set->size += 1;
+
+    return 0;
+}
+
+
+/* Remove a member from the set */
+int sset_remove(SSet *set, unsigned int data)
+{
+    /* Find the member */
+    int pos = sset_lower_bound(set->members, 0, sset_size(set), data);
+    if(pos == sset_size(set) || set->members[pos] != data)
+        return -1;
+
+    /* Shift the larger members down by one */
+    memmove(&set->members[pos], &set->members[pos + 1], (sset_size(set) - pos - 1) * sizeof(unsigned int));
+    set->size -= 1;
+
+    return 0;
+}
+
+
+/* Compute the union of two sets */
+int sset_union(SSet *setu, const SSet *set1, const SSet *set2)
+{
+    /* Initialize the set for the union and allocate room for the worst case (i.e., disjoint sets) */
+    sset_init(setu);
+    if(sset_reserve(setu, sset_size(set1) + sset_size(set2)) != 0)
+        return -1;
+
+    const unsigned int *a = set1->members, *b = set2->members;
+    int m = sset_size(set1), n = sset_size(set2);
+    int i = 0, j = 0, k = 0;
+
+    /* Merge the two sorted arrays, keeping one copy of members present in both */
+    while(i < m && j < n)
+    {
+        if(a[i] < b[j])
+            setu->members[k++] = a[i++];
+        else if(b[j] < a[i])
+            setu->members[k++] = b[j++];
+        else
+        {
+            setu->members[k++] = a[i++];
+            j++;
+        }
+    }
+
+    /* Copy whichever tail is left */
+    while(i < m)
+        setu->members[k++] = a[i++];
+    while(j < n)
+        setu->members[k++] = b[j++];
+
+    setu->size = k;
+
+    return 0;
+}
+
+
+/* Compute the intersection of two sets */
+int sset_intersection(SSet *seti, const SSet *set1, const SSet *set2)
+{
+    /* Make set1 the smaller set (intersection is symmetric) */
+    if(sset_size(set1) > sset_size(set2))
+    {
+        const SSet *temp = set1;
+        set1 = set2;
+        set2 = temp;
+    }
+
+    /* Initialize the set for the intersection -- It can be no larger than the smaller set */
+    sset_init(seti);
+    if(sset_size(set1) == 0)
+        return 0;
+    if(sset_reserve(seti, sset_size(set1)) != 0)
+        return -1;
+
+    /* Gallop when the sizes are very skewed, otherwise merge */
+    if((long)sset_size(set1) * SSET_GALLOP_RATIO < (long)sset_size(set2))
+        seti->size = sset_intersect_gallop(set1->members, sset_size(set1), set2->members, sset_size(set2), seti->members);
+    else
+        seti->size = sset_intersect_merge(set1->members, sset_size(set1), set2->members, sset_size(set2), seti->members);
+
+    return 0;
+}
+
+
+/* Callback used by sset_intersection_multi() to store each member of the intersection */
+static int sset_append_member(unsigned int member, void *arg)
+{
+    /* Members arrive in ascending order and room for them was reserved up front */
+    SSet *set = (SSet *)arg;
+    set->members[set->size++] = member;
+    return 0;
+}
+
+
+/* Compute the intersection of several sets */
+int sset_intersection_multi(SSet *seti, const SSet **sets, int count)
+{
+    sset_init(seti);
+    if(count <= 0)
+        return -1;
+
+    /* The intersection can be no larger than the smallest set */
+    int smallest = sset_size(sets[0]);
+    for(int k = 1; k < count; k++)
+        if(sset_size(sets[k]) < smallest)
+            smallest = sset_size(sets[k]);
+
+    if(smallest == 0)
+        return 0;
+    if(sset_reserve(seti, smallest) != 0)
+        return -1;
+
+    /* Stream the members straight into the result */
+    if(sset_intersection_stream(sets, count, sset_append_member, seti) != 0)
+    {
+        sset_destroy(seti);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/* Visit each member of the intersection of several sets */
+int sset_intersection_stream(const SSet **sets, int count, int (*callback)(unsigned int member, void *arg), void *arg)
+{
+    if(count <= 0)
+        return -1;
+
+    /* Keep our own copy of the set pointers (ordered by size) and a search position for each set */
+    const SSet **order = malloc(count * sizeof(SSet *));
+    int *pos = calloc(count, sizeof(int));
+    if(order == NULL || pos == NULL)
+    {
+        free(order);
+        free(pos);
+        return -1;
+    }
+
+    /* Order the sets from smallest to largest with insertion sort (count is small) */
+    for(int k = 0; k < count; k++)
+    {
+        int j = k;
+        while(j > 0 && sset_size(order[j - 1]) > sset_size(sets[k]))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = sets[k];
+    }
+
+    /* Each member of the smallest set is a candidate */
+    const unsigned int *base = sset_members(order[0]);
+    int n0 = sset_size(order[0]);
+    int i = 0;
+
+    while(i < n0)
+    {
+        unsigned int candidate = base[i];
+        int k = 1;
+
+        /* Look for the candidate in each of the other sets */
+        while(k < count)
+        {
+            int n = sset_size(order[k]);
+            pos[k] = sset_gallop(sset_members(order[k]), pos[k], n, candidate);
+
+            /* Once any set is exhausted, nothing else can be in the intersection */
+            if(pos[k] == n)
+                goto done;
+
+            unsigned int found = sset_member(order[k], pos[k]);
+            if(found != candidate)
+            {
+                /* Skip straight to the first candidate that could match what this set holds, and start checking again */
+                i = sset_gallop(base, i + 1, n0, found);
+                if(i == n0)
+                    goto done;
+                candidate = base[i];
+                k = 1;
+                continue;
+            }
+
+            k++;
+        }
+
+        /* The candidate is in every set */
+        if(callback(candidate, arg) != 0)
+            break;
+        i++;
+    }
+
+done:
+    free(order);
+    free(pos);
+    return 0;
+}
+
+
+/* Compute the difference of two sets (set1 - set2) */
+int sset_difference(SSet *setd, const SSet *set1, const SSet *set2)
+{
+    /* Initialize the set for the difference -- It can be no larger than set1 */
+    sset_init(setd);
+    if(sset_size(set1) == 0)
+        return 0;
+    if(sset_reserve(setd, sset_size(set1)) != 0)
+        return -1;
+
+    const unsigned int *a = set1->members, *b = set2->members;
+    int m = sset_size(set1), n = sset_size(set2);
+    int i = 0, j = 0, k = 0;
+
+    /* Keep the members of set1 that the merge does not find in set2 */
+    while(i < m && j < n)
+    {
+        if(a[i] < b[j])
+            setd->members[k++] = a[i++];
+        else if(b[j] < a[i])
+            j++;
+        else
+        {
+            i++;
+            j++;
+        }
+    }
+
+    /* Everything left in set1 is past the end of set2 */
+    while(i < m)
+        setd->members[k++] = a[i++];
+
+    setd->size = k;
+
+    return 0;
+}
+
+
+/* Determine whether a value is a member of the set */
+int sset_is_element(const SSet *set, unsigned int data)
+{
+    int pos = sset_lower_bound(set->members, 0, sset_size(set), data);
+    return (pos < sset_size(set) && set->members[pos] == data) ? 1 : 0;
+}
+
+
+/* Determine whether set1 is a subset of set2 */
+int sset_is_subset(const SSet *set1, const SSet *set2)
+{
+    /* Quick test -- If set1 has more members, it cannot be a subset */
+    if(sset_size(set1) > sset_size(set2))
+        return 0;
+
+    /* Walk set2 alongside set1 -- Every member of set1 must be found before set2 runs out */
+    int j = 0;
+    for(int i = 0; i < sset_size(set1); i++)
+    {
+        j = sset_gallop(set2->members, j, sset_size(set2), set1->members[i]);
+        if(j == sset_size(set2) || set2->members[j] != set1->members[i])
+            return 0;
+    }
+
+    /* If we get here, all the members of set1 were in set2 */
+    return 1;
+}
+
+
+/* Determine whether two sets are equal */
+int sset_is_equal(const SSet *set1, const SSet *set2)
+{
+    /* Quick test -- The sets must be the same size */
+    if(sset_size(set1) != sset_size(set2))
+        return 0;
+
+    /* Sorted arrays of the same size are equal iff their contents are identical */
+    if(sset_size(set1) == 0)
+        return 1;
+    return memcmp(set1->members, set2->members, sset_size(set1) * sizeof(unsigned int)) == 0 ? 1 : 0;
+}
@@ -1,37 +1,120 @@
 /* Implementation for Stack */
 #include <stdlib.h>
+#include <string.h>
 
-#include "list.h"
 #include "stack.h"
 
+/* Capacity of the first allocation */
+#define STACK_MIN_CAPACITY 16
+
+
+/* Grow the array geometrically until it holds at least needed elements */
+static int stack_grow(Stack *stack, int needed)
+{
+    int capacity = (stack->capacity > 0) ? stack->capacity : STACK_MIN_CAPACITY;
+    while(capacity < needed)
+        capacity *= 2;
+
+    return stack_reserve(stack, capacity);
+}
+
 
 /* Initialize a stack */
 void stack_init(Stack *stack, void (*destroy)(void *data))
 {
-    /* Use list initialization to implement stack as a linked list */
-    list_init(stack, destroy);
+    stack->size = 0;
+    stack->capacity = 0;
+    stack->destroy = destroy;
+    stack->data = NULL;
 }
 
 
 /* Destroy a stack */
 void stack_destroy(Stack *stack)
 {
-    /* Use list destruction since the stack is just a linked list */
-    list_destroy(stack);
+    /* If the user supplied a destroy function, apply it to each element from the top down */
+    if(stack->destroy != NULL)
+    {
+        for(int i = stack->size - 1; i >= 0; i--)
+            stack->destroy(stack->data[i]);
+    }
+
+    free(stack->data);
+
+    /* To be safe, clear the structure */
+    memset(stack, 0, sizeof(Stack));
+}
+
+
+/* Make room for at least capacity elements */
+int stack_reserve(Stack *stack, int capacity)
+{
+    if(capacity <= stack->capacity)
+        return 0;
+
+    void **data = realloc(stack->data, capacity * sizeof(void *));
+    if(data == NULL)
+        return -1;
+
+    stack->data = data;
+    stack->capacity = capacity;
+
+    return 0;
 }
 
 
 /* Push data onto the stack */
 int stack_push(Stack *stack, const void *data)
 {
-    /* Use list insertion to insert the data at the head of the list (i.e., top of the stack) */
-    return list_insert_next(stack, NULL, data);
+    if( (stack->size == stack->capacity) && (stack_grow(stack, stack->size + 1) != 0) )
+        return -1;
+
+    stack->data[stack->size++] = (void *)data;
+
+    return 0;
 }
 
 
 /* Pop data from the stack */
 int stack_pop(Stack *stack, void **data)
 {
-    /* Use list removal to remove the data at the head of the list (i.e., top of the stack) */
-    return list_remove_next(stack, NULL, data);
+    if(stack_size(stack) == 0)
+        return -1;
+
+    *data = stack->data[--stack->size];
+
+    return 0;
+}
+
+
+/* Push several elements onto the stack */
+int stack_push_n(Stack *stack, void **data, int count)
+{
+    if(count < 0)
+        return -1;
+
+    if( (stack->size + count > stack->capacity) && (stack_grow(stack, stack->size + count) != 0) )
+        return -1;
+
+    memcpy(&stack->data[stack->size], data, count * sizeof(void *));
+    stack->size += count;
+
+    return 0;
+}
+
+
+/* Pop several elements from the stack */
+int stack_pop_n(Stack *stack, void **data, int count)
+{
+    if(count <= 0)
+        return 0;
+    if(count > stack->size)
+        count = stack->size;
+
+    /* The top of the stack is the end of the array, so copy in reverse */
+    for(int i = 0; i < count; i++)
+        data[i] = stack->data[stack->size - 1 - i];
+    stack->size -= count;
+
+    return count;
 }
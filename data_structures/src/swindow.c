@@ -0,0 +1,253 @@
+/* Implementation of Sliding Window */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "swindow.h"
+
+/* Capacity of the first allocation of a ring */
+#define SWINDOW_MIN_CAPACITY 16
+
+
+/* Sample at position i of a ring, counting from the front */
+#define swindow_ring_at(ring, i) ((ring)->slots[((ring)->head + (i)) & ((ring)->capacity - 1)])
+
+
+/* Make room for at least capacity samples, keeping their order */
+static int swindow_ring_reserve(SWindowRing *ring, int capacity)
+{
+    if(capacity <= ring->capacity)
+        return 0;
+
+    int new_capacity = (ring->capacity > 0) ? ring->capacity : SWINDOW_MIN_CAPACITY;
+    while(new_capacity < capacity)
+        new_capacity *= 2;
+
+    SWindowSample *slots = malloc(new_capacity * sizeof(SWindowSample));
+    if(slots == NULL)
+        return -1;
+
+    for(int i = 0; i < ring->size; i++)
+        slots[i] = swindow_ring_at(ring, i);
+
+    free(ring->slots);
+    ring->slots = slots;
+    ring->capacity = new_capacity;
+    ring->head = 0;
+
+    return 0;
+}
+
+
+/* Push a sample at the back of a ring */
+static int swindow_ring_push(SWindowRing *ring, const SWindowSample *sample)
+{
+    if( (ring->size == ring->capacity) && (swindow_ring_reserve(ring, ring->size + 1) != 0) )
+        return -1;
+
+    swindow_ring_at(ring, ring->size) = *sample;
+    ring->size++;
+
+    return 0;
+}
+
+
+/* Drop the sample at the front of a ring */
+static void swindow_ring_pop_front(SWindowRing *ring)
+{
+    ring->head = (ring->head + 1) & (ring->capacity - 1);
+    ring->size--;
+}
+
+
+/* Add x to the running sum, keeping the rounding error in the compensation (Neumaier) */
+static void swindow_accumulate(SWindow *window, double x)
+{
+    double sum = window->sum, total = sum + x;
+
+    if( (sum < 0 ? -sum : sum) >= (x < 0 ? -x : x) )
+        window->compensation += (sum - total) + x;
+    else
+        window->compensation += (x - total) + sum;
+
+    window->sum = total;
+}
+
+
+/* Remove the oldest sample from the window */
+static void swindow_evict(SWindow *window)
+{
+    const SWindowSample *oldest = &swindow_ring_at(&window->samples, 0);
+
+    /* The oldest sample is at the front of a monotonic deque only if nothing newer beat it */
+    if(window->min.size > 0 && swindow_ring_at(&window->min, 0).seq == oldest->seq)
+        swindow_ring_pop_front(&window->min);
+    if(window->max.size > 0 && swindow_ring_at(&window->max, 0).seq == oldest->seq)
+        swindow_ring_pop_front(&window->max);
+
+    swindow_accumulate(window, -oldest->value);
+    swindow_ring_pop_front(&window->samples);
+
+    /* An empty window restarts the sum, shedding any residual rounding */
+    if(window->samples.size == 0)
+    {
+        window->sum = 0.0;
+        window->compensation = 0.0;
+    }
+}
+
+
+/* Initialize a sliding window */
+int swindow_init(SWindow *window, int kind, uint64_t span)
+{
+    if( (kind != SWINDOW_COUNT && kind != SWINDOW_TIME) || (span == 0) )
+        return -1;
+
+    if( (kind == SWINDOW_COUNT) && (span > (1 << 30)) )
+        return -1;
+
+    window->kind = kind;
+    window->span = span;
+    window->seq = 0;
+    window->sum = 0.0;
+    window->compensation = 0.0;
+
+    memset(&window->samples, 0, sizeof(SWindowRing));
+    memset(&window->min, 0, sizeof(SWindowRing));
+    memset(&window->max, 0, sizeof(SWindowRing));
+
+    /* A count window never holds more than span samples, so no push ever reallocates */
+    if(kind == SWINDOW_COUNT)
+    {
+        if( (swindow_ring_reserve(&window->samples, (int)span) != 0) ||
+            (swindow_ring_reserve(&window->min, (int)span) != 0) ||
+            (swindow_ring_reserve(&window->max, (int)span) != 0) )
+        {
+            swindow_destroy(window);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/* Destroy a sliding window */
+void swindow_destroy(SWindow *window)
+{
+    free(window->samples.slots);
+    free(window->min.slots);
+    free(window->max.slots);
+
+    /* To be safe, clear the structure */
+    memset(window, 0, sizeof(SWindow));
+}
+
+
+/* Add a sample, evicting the samples that fall out of the window */
+int swindow_add(SWindow *window, uint64_t stamp, double value)
+{
+    SWindowSample sample = {value, stamp, window->seq};
+
+    /* Evict first, so a count window never needs more than the span of slots it started with */
+    if(window->kind == SWINDOW_COUNT)
+    {
+        if((uint64_t)window->samples.size == window->span)
+            swindow_evict(window);
+    }
+    else
+    {
+        swindow_expire(window, stamp);
+
+        /* Grow every ring before touching any, so a failed add leaves the window as it was */
+        if( (swindow_ring_reserve(&window->samples, window->samples.size + 1) != 0) ||
+            (swindow_ring_reserve(&window->min, window->min.size + 1) != 0) ||
+            (swindow_ring_reserve(&window->max, window->max.size + 1) != 0) )
+            return -1;
+    }
+
+    /* Older samples the new one beats can never be the answer again */
+    while(window->min.size > 0 && swindow_ring_at(&window->min, window->min.size - 1).value >= value)
+        window->min.size--;
+    while(window->max.size > 0 && swindow_ring_at(&window->max, window->max.size - 1).value <= value)
+        window->max.size--;
+
+    swindow_ring_push(&window->samples, &sample);
+    swindow_ring_push(&window->min, &sample);
+    swindow_ring_push(&window->max, &sample);
+    swindow_accumulate(window, value);
+    window->seq++;
+
+    return 0;
+}
+
+
+/* Add an array of samples */
+int swindow_add_n(SWindow *window, const uint64_t *stamps, const double *values, int count)
+{
+    int start = 0;
+
+    /* Only the last span samples of a long batch can survive it */
+    if( (window->kind == SWINDOW_COUNT) && ((uint64_t)count >= window->span) )
+    {
+        while(window->samples.size > 0)
+            swindow_evict(window);
+
+        start = count - (int)window->span;
+        window->seq += start;
+    }
+    else if( (window->kind == SWINDOW_TIME) && (stamps == NULL) )
+        return -1;
+
+    for(int i = start; i < count; i++)
+    {
+        if(swindow_add(window, (stamps != NULL) ? stamps[i] : 0, values[i]) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
+/* Evict the samples of a time window that are too old at a given time */
+void swindow_expire(SWindow *window, uint64_t now)
+{
+    if(window->kind != SWINDOW_TIME)
+        return;
+
+    while(window->samples.size > 0 && now - swindow_ring_at(&window->samples, 0).stamp >= window->span)
+        swindow_evict(window);
+}
+
+
+/* Minimum of the window */
+int swindow_min(const SWindow *window, double *min)
+{
+    if(window->min.size == 0)
+        return -1;
+
+    *min = swindow_ring_at(&window->min, 0).value;
+    return 0;
+}
+
+
+/* Maximum of the window */
+int swindow_max(const SWindow *window, double *max)
+{
+    if(window->max.size == 0)
+        return -1;
+
+    *max = swindow_ring_at(&window->max, 0).value;
+    return 0;
+}
+
+
+/* Mean of the window */
+int swindow_mean(const SWindow *window, double *mean)
+{
+    if(window->samples.size == 0)
+        return -1;
+
+    *mean = swindow_sum(window) / window->samples.size;
+    return 0;
+}
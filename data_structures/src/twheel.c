@@ -0,0 +1,259 @@
+/* Implementation of Timer Wheel */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "twheel.h"
+
+/* Number of ticks the levels cover together */
+#define TWHEEL_RANGE ((uint64_t)1 << (TWHEEL_BITS * TWHEEL_LEVELS))
+
+
+/* Make a bucket list empty */
+static void twheel_list_init(TWheelLink *sentinel)
+{
+    sentinel->prev = sentinel;
+    sentinel->next = sentinel;
+}
+
+
+/* Link a node at the end of a bucket list */
+static void twheel_list_append(TWheelLink *sentinel, TWheelLink *link)
+{
+    link->prev = sentinel->prev;
+    link->next = sentinel;
+    sentinel->prev->next = link;
+    sentinel->prev = link;
+}
+
+
+/* Unlink a node from whichever list holds it */
+static void twheel_list_remove(TWheelLink *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+}
+
+
+/* Move every node of a bucket onto an empty local list, leaving the bucket empty */
+static void twheel_list_take(TWheelLink *sentinel, TWheelLink *local)
+{
+    if(sentinel->next == sentinel)
+    {
+        twheel_list_init(local);
+        return;
+    }
+
+    local->next = sentinel->next;
+    local->prev = sentinel->prev;
+    local->next->prev = local;
+    local->prev->next = local;
+    twheel_list_init(sentinel);
+}
+
+
+/* Take a node from the pool, growing it by a chunk when it is empty */
+static TWheelTimer *twheel_node_new(TWheel *wheel)
+{
+    if(wheel->free == NULL)
+    {
+        TWheelChunk *chunk = malloc(sizeof(TWheelChunk));
+        if(chunk == NULL)
+            return NULL;
+
+        chunk->next = wheel->chunks;
+        wheel->chunks = chunk;
+
+        for(int i = TWHEEL_POOL_CHUNK - 1; i >= 0; i--)
+        {
+            chunk->timers[i].link.next = (TWheelLink *)wheel->free;
+            wheel->free = &chunk->timers[i];
+        }
+    }
+
+    TWheelTimer *timer = wheel->free;
+    wheel->free = (TWheelTimer *)timer->link.next;
+
+    return timer;
+}
+
+
+/* Return a node to the pool */
+static void twheel_node_free(TWheel *wheel, TWheelTimer *timer)
+{
+    timer->link.next = (TWheelLink *)wheel->free;
+    wheel->free = timer;
+}
+
+
+/* Link a timer into the bucket its expiry falls in, relative to the current tick */
+static void twheel_place(TWheel *wheel, TWheelTimer *timer)
+{
+    uint64_t expires = timer->expires, delta = expires - wheel->now;
+    int level = 0;
+
+    /* Too far out for the top level -- Park it in the furthest bucket until it cascades */
+    if(delta >= TWHEEL_RANGE)
+    {
+        expires = wheel->now + TWHEEL_RANGE - 1;
+        delta = TWHEEL_RANGE - 1;
+    }
+
+    while(delta >= ((uint64_t)1 << (TWHEEL_BITS * (level + 1))))
+        level++;
+
+    int slot = (expires >> (TWHEEL_BITS * level)) & (TWHEEL_SLOTS - 1);
+    twheel_list_append(&wheel->buckets[level][slot], &timer->link);
+    timer->level = level;
+    wheel->counts[level]++;
+}
+
+
+/* Unlink a timer from its bucket */
+static void twheel_unplace(TWheel *wheel, TWheelTimer *timer)
+{
+    twheel_list_remove(&timer->link);
+    wheel->counts[timer->level]--;
+}
+
+
+/* Move the timers of the bucket that a level's index has just reached down the wheel */
+static void twheel_cascade(TWheel *wheel, int level)
+{
+    int slot = (wheel->now >> (TWHEEL_BITS * level)) & (TWHEEL_SLOTS - 1);
+    TWheelLink local;
+
+    twheel_list_take(&wheel->buckets[level][slot], &local);
+    while(local.next != &local)
+    {
+        TWheelTimer *timer = (TWheelTimer *)local.next;
+        twheel_unplace(wheel, timer);
+        twheel_place(wheel, timer);
+    }
+}
+
+
+/* Initialize a timer wheel */
+void twheel_init(TWheel *wheel, uint64_t now)
+{
+    wheel->now = now;
+    wheel->pending = 0;
+
+    for(int level = 0; level < TWHEEL_LEVELS; level++)
+    {
+        wheel->counts[level] = 0;
+        for(int slot = 0; slot < TWHEEL_SLOTS; slot++)
+            twheel_list_init(&wheel->buckets[level][slot]);
+    }
+
+    wheel->chunks = NULL;
+    wheel->free = NULL;
+}
+
+
+/* Destroy a timer wheel */
+void twheel_destroy(TWheel *wheel)
+{
+    TWheelChunk *chunk = wheel->chunks, *next;
+
+    while(chunk != NULL)
+    {
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    /* To be safe, clear the structure */
+    memset(wheel, 0, sizeof(TWheel));
+}
+
+
+/* Schedule a timer */
+TWheelTimer *twheel_schedule(TWheel *wheel, uint64_t delay, void (*expire)(void *arg), void *arg)
+{
+    TWheelTimer *timer = twheel_node_new(wheel);
+    if(timer == NULL)
+        return NULL;
+
+    /* The current tick has already been processed */
+    timer->expires = wheel->now + (delay > 0 ? delay : 1);
+    timer->expire = expire;
+    timer->arg = arg;
+
+    twheel_place(wheel, timer);
+    wheel->pending++;
+
+    return timer;
+}
+
+
+/* Cancel a pending timer */
+void twheel_cancel(TWheel *wheel, TWheelTimer *timer)
+{
+    twheel_unplace(wheel, timer);
+    twheel_node_free(wheel, timer);
+    wheel->pending--;
+}
+
+
+/* Advance the wheel, firing every timer that comes due */
+int twheel_advance(TWheel *wheel, uint64_t ticks)
+{
+    int fired = 0;
+
+    for(uint64_t t = 0; t < ticks; t++)
+    {
+        /* With the lowest empty levels, nothing can happen before the next tick that cascades into them */
+        int empty = 0;
+        while(empty < TWHEEL_LEVELS && wheel->counts[empty] == 0)
+            empty++;
+
+        if(empty > 0)
+        {
+            uint64_t skip = ticks - t;
+            if(empty < TWHEEL_LEVELS)
+            {
+                uint64_t span = (uint64_t)1 << (TWHEEL_BITS * empty);
+                uint64_t until = span - 1 - (wheel->now & (span - 1));
+                if(until < skip)
+                    skip = until;
+            }
+
+            wheel->now += skip;
+            t += skip;
+            if(t == ticks)
+                break;
+        }
+
+        wheel->now++;
+
+        /* Each level whose lower neighbour wrapped around pulls its current bucket down */
+        for(int level = 1; level < TWHEEL_LEVELS; level++)
+        {
+            if((wheel->now & (((uint64_t)1 << (TWHEEL_BITS * level)) - 1)) != 0)
+                break;
+            twheel_cascade(wheel, level);
+        }
+
+        /* Detach the due bucket first, so timers scheduled from expire land in later buckets */
+        TWheelLink local;
+        twheel_list_take(&wheel->buckets[0][wheel->now & (TWHEEL_SLOTS - 1)], &local);
+
+        while(local.next != &local)
+        {
+            TWheelTimer *timer = (TWheelTimer *)local.next;
+            void (*expire)(void *arg) = timer->expire;
+            void *arg = timer->arg;
+
+            /* Recycle the node before calling out, so expire may reuse it for a new timer */
+            twheel_unplace(wheel, timer);
+            twheel_node_free(wheel, timer);
+            wheel->pending--;
+            fired++;
+
+            expire(arg);
+        }
+    }
+
+    return fired;
+}
@@ -0,0 +1,228 @@
+/* Implementation of Unrolled Linked List */
+#include <stdlib.h>
+#include <string.h>
+
+#include "ulist.h"
+
+
+/* Allocate an empty node and link it after node (NULL means at the head) */
+static UListNode *ulist_node_new(UList *list, UListNode *node)
+{
+    UListNode *new_node = malloc(sizeof(UListNode));
+    if(new_node == NULL)
+        return NULL;
+    new_node->count = 0;
+
+    if(node == NULL)
+    {
+        new_node->next = list->head;
+        list->head = new_node;
+    }
+    else
+    {
+        new_node->next = node->next;
+        node->next = new_node;
+    }
+
+    if(new_node->next == NULL)
+        list->tail = new_node;
+
+    list->nodes += 1;
+    return new_node;
+}
+
+
+/* Unlink the node following prev (NULL means the head) and free it */
+static void ulist_node_free(UList *list, UListNode *prev)
+{
+    UListNode *old_node = (prev == NULL) ? list->head : prev->next;
+
+    if(prev == NULL)
+        list->head = old_node->next;
+    else
+        prev->next = old_node->next;
+
+    if(old_node->next == NULL)
+        list->tail = prev;
+
+    free(old_node);
+    list->nodes -= 1;
+}
+
+
+/* Find the node holding position (0 <= position < size) -- Sets the offset within the node and the preceding node */
+static UListNode *ulist_find(const UList *list, int position, int *offset, UListNode **prev)
+{
+    UListNode *node = list->head;
+    *prev = NULL;
+
+    while(position >= node->count)
+    {
+        position -= node->count;
+        *prev = node;
+        node = node->next;
+    }
+
+    *offset = position;
+    return node;
+}
+
+
+/* Initialize an Unrolled Linked List */
+void ulist_init(UList *list, void (*destroy)(void *data))
+{
+    list->size = 0;
+    list->nodes = 0;
+    list->destroy = destroy;
+    list->head = NULL;
+    list->tail = NULL;
+}
+
+
+/* Destroy an Unrolled Linked List */
+void ulist_destroy(UList *list)
+{
+    UListNode *node = list->head, *next;
+
+    while(node != NULL)
+    {
+        /* If the user supplied a destroy function, apply it to the data of each slot */
+        if(list->destroy != NULL)
+        {
+            for(int i = 0; i < node->count; i++)
+                list->destroy(node->data[i]);
+        }
+
+        next = node->next;
+        free(node);
+        node = next;
+    }
+
+    /* To be safe, clear the structure */
+    memset(list, 0, sizeof(UList));
+}
+
+
+/* Insert an element at the tail of the list */
+int ulist_append(UList *list, const void *data)
+{
+    UListNode *node = list->tail;
+
+    /* Start a new node when the tail is full */
+    if( (node == NULL) || (node->count == ULIST_SLOTS) )
+    {
+        if( (node = ulist_node_new(list, node)) == NULL )
+            return -1;
+    }
+
+    node->data[node->count++] = (void *)data;
+    list->size += 1;
+
+    return 0;
+}
+
+
+/* Insert an element at the head of the list */
+int ulist_prepend(UList *list, const void *data)
+{
+    UListNode *node = list->head;
+
+    /* Start a new node when the head is full */
+    if( (node == NULL) || (node->count == ULIST_SLOTS) )
+    {
+        if( (node = ulist_node_new(list, NULL)) == NULL )
+            return -1;
+    }
+
+    memmove(&node->data[1], &node->data[0], node->count * sizeof(void *));
+    node->data[0] = (void *)data;
+    node->count += 1;
+    list->size += 1;
+
+    return 0;
+}
+
+
+/* Insert an element at a given position */
+int ulist_insert(UList *list, int position, const void *data)
+{
+    if( (position < 0) || (position > ulist_size(list)) )
+        return -1;
+
+    /* Inserting past the last element is an append */
+    if(position == ulist_size(list))
+        return ulist_append(list, data);
+
+    int offset;
+    UListNode *prev, *node = ulist_find(list, position, &offset, &prev);
+
+    /* Split a full node in half -- The upper half moves to a new node just after it */
+    if(node->count == ULIST_SLOTS)
+    {
+        UListNode *new_node = ulist_node_new(list, node);
+        if(new_node == NULL)
+            return -1;
+
+        int half = ULIST_SLOTS / 2;
+        memcpy(new_node->data, &node->data[half], (ULIST_SLOTS - half) * sizeof(void *));
+        new_node->count = ULIST_SLOTS - half;
+        node->count = half;
+
+        if(offset > half)
+        {
+            node = new_node;
+            offset -= half;
+        }
+    }
+
+    memmove(&node->data[offset + 1], &node->data[offset], (node->count - offset) * sizeof(void *));
+    node->data[offset] = (void *)data;
+    node->count += 1;
+    list->size += 1;
+
+    return 0;
+}
+
+
+/* Remove the element at a given position */
+int ulist_remove(UList *list, int position, void **data)
+{
+    if( (position < 0) || (position >= ulist_size(list)) )
+        return -1;
+
+    int offset;
+    UListNode *prev, *node = ulist_find(list, position, &offset, &prev);
+
+    *data = node->data[offset];
+    memmove(&node->data[offset], &node->data[offset + 1], (node->count - offset - 1) * sizeof(void *));
+    node->count -= 1;
+    list->size -= 1;
+
+    /* An empty node is released */
+    if(node->count == 0)
+    {
+        ulist_node_free(list, prev);
+    }
+    /* A node under half full absorbs its successor when both fit */
+    else if( (node->count < ULIST_SLOTS / 2) && (node->next != NULL) && (node->count + node->next->count <= ULIST_SLOTS) )
+    {
+        memcpy(&node->data[node->count], node->next->data, node->next->count * sizeof(void *));
+        node->count += node->next->count;
+        ulist_node_free(list, node);
+    }
+
+    return 0;
+}
+
+
+/* Get the element at a given position */
+void *ulist_get(const UList *list, int position)
+{
+    if( (position < 0) || (position >= ulist_size(list)) )
+        return NULL;
+
+    int offset;
+    UListNode *prev, *node = ulist_find(list, position, &offset, &prev);
+
+    return node->data[offset];
+}
@@ -0,0 +1,167 @@
+/* Implementation of Work-Stealing Deque */
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "wsdeque.h"
+
+
+/* Allocate a ring with the given (power of two) capacity */
+static WSDequeRing *wsdeque_ring_new(long capacity)
+{
+    WSDequeRing *ring = malloc(sizeof(WSDequeRing) + capacity * sizeof(_Atomic(void *)));
+    if(ring == NULL)
+        return NULL;
+
+    ring->capacity = capacity;
+    ring->retired = NULL;
+    for(long i = 0; i < capacity; i++)
+        atomic_init(&ring->slots[i], NULL);
+
+    return ring;
+}
+
+
+/* Slot holding a position */
+static _Atomic(void *) *wsdeque_slot(WSDequeRing *ring, long position)
+{
+    return &ring->slots[position & (ring->capacity - 1)];
+}
+
+
+/* Replace a full ring with one twice its size, copying positions top..bottom-1 (owner only) */
+static WSDequeRing *wsdeque_grow(WSDeque *deque, WSDequeRing *ring, long top, long bottom)
+{
+    WSDequeRing *bigger = wsdeque_ring_new(ring->capacity * 2);
+    if(bigger == NULL)
+        return NULL;
+
+    for(long i = top; i < bottom; i++)
+        atomic_store_explicit(wsdeque_slot(bigger, i), atomic_load_explicit(wsdeque_slot(ring, i), memory_order_relaxed), memory_order_relaxed);
+
+    /* Thieves may still be reading the old ring, so it is only retired */
+    bigger->retired = ring;
+    atomic_store_explicit(&deque->ring, bigger, memory_order_release);
+
+    return bigger;
+}
+
+
+/* Initialize a work-stealing deque */
+int wsdeque_init(WSDeque *deque, long capacity)
+{
+    long slots = 1;
+    while(slots < capacity)
+        slots <<= 1;
+
+    WSDequeRing *ring = wsdeque_ring_new(slots);
+    if(ring == NULL)
+        return -1;
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->ring, ring);
+
+    return 0;
+}
+
+
+/* Destroy a work-stealing deque */
+void wsdeque_destroy(WSDeque *deque)
+{
+    WSDequeRing *ring = atomic_load_explicit(&deque->ring, memory_order_relaxed), *retired;
+
+    while(ring != NULL)
+    {
+        retired = ring->retired;
+        free(ring);
+        ring = retired;
+    }
+
+    /* To be safe, clear the structure */
+    memset(deque, 0, sizeof(WSDeque));
+}
+
+
+/* Push an element at the bottom */
+int wsdeque_push(WSDeque *deque, const void *data)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    WSDequeRing *ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+
+    if( (bottom - top > ring->capacity - 1) && ((ring = wsdeque_grow(deque, ring, top, bottom)) == NULL) )
+        return -1;
+
+    atomic_store_explicit(wsdeque_slot(ring, bottom), (void *)data, memory_order_relaxed);
+
+    /* The slot must be visible before a thief can see the new bottom */
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return 0;
+}
+
+
+/* Pop the element at the bottom */
+int wsdeque_pop(WSDeque *deque, void **data)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    WSDequeRing *ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+
+    /* Reserve the bottom element before looking at top -- The fence orders this store before the load of top */
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    /* Empty -- Undo the reservation */
+    if(top > bottom)
+    {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return -1;
+    }
+
+    *data = atomic_load_explicit(wsdeque_slot(ring, bottom), memory_order_relaxed);
+
+    /* More than one element left, so no thief can reach this one */
+    if(top < bottom)
+        return 0;
+
+    /* Last element -- Race the thieves for it by advancing top ourselves */
+    int won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return won ? 0 : -1;
+}
+
+
+/* Steal the element at the top */
+int wsdeque_steal(WSDeque *deque, void **data)
+{
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if(top >= bottom)
+        return -1;
+
+    /* Read the element before claiming it -- If the CAS fails, the value is simply discarded */
+    WSDequeRing *ring = atomic_load_explicit(&deque->ring, memory_order_acquire);
+    void *element = atomic_load_explicit(wsdeque_slot(ring, top), memory_order_relaxed);
+
+    if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+        return 1;
+
+    *data = element;
+    return 0;
+}
+
+
+/* Number of elements in the deque */
+long wsdeque_size(const WSDeque *deque)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    return (bottom > top) ? bottom - top : 0;
+}
@@ -0,0 +1,181 @@
+/* Testing Blocking Queue Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "bqueue.h"
+
+#define PRODUCERS 4
+#define PER_PRODUCER 100000
+#define BATCH 32
+
+void *producer(void *arg);
+void *consumer(void *arg);
+void *blocked_push(void *arg);
+
+/* Queue and outcome of a push made from another thread */
+typedef struct PushArg_ {
+    BQueue *queue;
+    void *data;
+    int result;
+} PushArg;
+
+/* Shared by the producer/consumer threads */
+BQueue pipeline;
+long consumed_sum = 0;
+int consumed_count = 0;
+pthread_mutex_t totals = PTHREAD_MUTEX_INITIALIZER;
+
+/* Test the methods and macros of a blocking queue
+    Methods:
+      - bqueue_init()
+      - bqueue_destroy()
+      - bqueue_push()
+      - bqueue_pop()
+      - bqueue_pop_batch()
+      - bqueue_close()
+      - bqueue_size()
+    Macros:
+      - bqueue_capacity()
+*/
+int main()
+{
+    BQueue queue;
+    int values[16], *data;
+    void *batch[16];
+    for(int i = 0; i < 16; i++)
+        values[i] = i;
+
+    printf("--- Single thread ---\n");
+    printf("Init with low >= high fails? : %s\n", bqueue_init(&queue, 4, 4, NULL) == -1 ? "yes" : "no");
+    if(bqueue_init(&queue, 8, 2, NULL) != 0)
+        return -1;
+    printf("Capacity: %d\n", bqueue_capacity(&queue));
+
+    printf("Pop from empty queue times out? : %s\n", bqueue_pop(&queue, (void **)&data, 0) == 1 ? "yes" : "no");
+    printf("Batch pop waiting 20 ms times out? : %s\n", bqueue_pop_batch(&queue, batch, 4, 20) == 0 ? "yes" : "no");
+
+    /* Fill to the high watermark -- The next push is throttled */
+    for(int i = 0; i < 8; i++)
+        bqueue_push(&queue, &values[i], BQUEUE_FOREVER);
+    printf("Push at high watermark times out? : %s\n", bqueue_push(&queue, &values[8], 10) == 1 ? "yes" : "no");
+
+    /* Draining to 4 is not enough, the throttle holds until the low watermark */
+    int popped = bqueue_pop_batch(&queue, batch, 4, 0), order = 1;
+    for(int i = 0; i < popped; i++)
+        order = order && (*(int *)batch[i] == i);
+    printf("Batch pop returned %d in order? : %s\n", popped, order ? "yes" : "no");
+    printf("Push still throttled above low watermark? : %s\n", bqueue_push(&queue, &values[8], 0) == 1 ? "yes" : "no");
+
+    bqueue_pop(&queue, (void **)&data, 0);
+    bqueue_pop(&queue, (void **)&data, 0);
+    printf("Push accepted after draining to low watermark? : %s\n", bqueue_push(&queue, &values[8], 0) == 0 ? "yes" : "no");
+    printf("Size: %d\n", bqueue_size(&queue));
+
+    /* A blocked producer is released by consumers draining the queue */
+    while(bqueue_push(&queue, &values[9], 0) == 0)
+        ;
+    pthread_t thread;
+    PushArg push = {&queue, &values[10], -2};
+    pthread_create(&thread, NULL, blocked_push, &push);
+    usleep(20000);
+    bqueue_pop_batch(&queue, batch, 16, 0);
+    pthread_join(thread, NULL);
+    printf("Blocked producer released by draining? : %s\n", push.result == 0 ? "yes" : "no");
+
+    /* Close: pushes fail, the released producer's element still drains, then pops fail */
+    bqueue_close(&queue);
+    printf("Push after close fails? : %s\n", bqueue_push(&queue, &values[0], BQUEUE_FOREVER) == -1 ? "yes" : "no");
+    printf("Pop after close still drains? : %s\n", bqueue_pop(&queue, (void **)&data, BQUEUE_FOREVER) == 0 && *data == 10 ? "yes" : "no");
+    printf("Pop from closed, empty queue fails? : %s\n", bqueue_pop(&queue, (void **)&data, BQUEUE_FOREVER) == -1 ? "yes" : "no");
+    printf("Batch pop from closed, empty queue fails? : %s\n", bqueue_pop_batch(&queue, batch, 4, BQUEUE_FOREVER) == -1 ? "yes" : "no");
+    bqueue_destroy(&queue);
+
+    /* Closing wakes a producer blocked on the throttle */
+    bqueue_init(&queue, 2, 0, NULL);
+    bqueue_push(&queue, &values[0], 0);
+    bqueue_push(&queue, &values[1], 0);
+    push.result = -2;
+    pthread_create(&thread, NULL, blocked_push, &push);
+    usleep(20000);
+    bqueue_close(&queue);
+    pthread_join(thread, NULL);
+    printf("Close releases blocked producer with -1? : %s\n", push.result == -1 ? "yes" : "no");
+    bqueue_destroy(&queue);
+
+    /* Several producers, two batch consumers, stopped by close */
+    printf("\n--- %d producers, 2 consumers ---\n", PRODUCERS);
+    if(bqueue_init(&pipeline, 256, 64, NULL) != 0)
+        return -1;
+
+    pthread_t producers[PRODUCERS], consumers[2];
+    long ids[PRODUCERS];
+    for(int i = 0; i < 2; i++)
+        pthread_create(&consumers[i], NULL, consumer, NULL);
+    for(int i = 0; i < PRODUCERS; i++)
+    {
+        ids[i] = i;
+        pthread_create(&producers[i], NULL, producer, &ids[i]);
+    }
+    for(int i = 0; i < PRODUCERS; i++)
+        pthread_join(producers[i], NULL);
+    bqueue_close(&pipeline);
+    for(int i = 0; i < 2; i++)
+        pthread_join(consumers[i], NULL);
+
+    long n = (long)PRODUCERS * PER_PRODUCER;
+    printf("Consumed every element once? : %s\n", (consumed_count == n && consumed_sum == n * (n + 1) / 2) ? "yes" : "no");
+    bqueue_destroy(&pipeline);
+
+    return 0;
+}
+
+
+/* Push one element, waiting without limit, and record the result */
+void *blocked_push(void *arg)
+{
+    PushArg *push = arg;
+
+    push->result = bqueue_push(push->queue, push->data, BQUEUE_FOREVER);
+    return NULL;
+}
+
+
+/* Push the values id * PER_PRODUCER + 1 .. (id + 1) * PER_PRODUCER */
+void *producer(void *arg)
+{
+    long base = *(long *)arg * PER_PRODUCER;
+
+    for(long i = 1; i <= PER_PRODUCER; i++)
+    {
+        if(bqueue_push(&pipeline, (void *)(base + i), BQUEUE_FOREVER) != 0)
+            return NULL;
+    }
+
+    return NULL;
+}
+
+
+/* Drain the queue in batches until it is closed and empty */
+void *consumer(void *arg)
+{
+    void *batch[BATCH];
+    long sum = 0;
+    int count = 0, popped;
+    (void)arg;
+
+    while((popped = bqueue_pop_batch(&pipeline, batch, BATCH, BQUEUE_FOREVER)) > 0)
+    {
+        for(int i = 0; i < popped; i++)
+            sum += (long)batch[i];
+        count += popped;
+    }
+
+    pthread_mutex_lock(&totals);
+    consumed_sum += sum;
+    consumed_count += count;
+    pthread_mutex_unlock(&totals);
+
+    return NULL;
+}
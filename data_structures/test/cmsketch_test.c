@@ -0,0 +1,160 @@
+/* Testing Count-Min Sketch Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "cmsketch.h"
+
+#define KEYS 100000
+#define STREAM 1000000
+#define THREADS 4
+#define EPSILON 0.001
+#define DELTA 0.01
+
+void *count_part(void *arg);
+uint64_t skewed_key(uint64_t *state);
+
+/* Each thread sketches its own slice of the stream */
+typedef struct Part_ {
+    const uint64_t *keys;
+    int n;
+    CMSketch sketch;
+} Part;
+
+/* Test the methods and macros of a count-min sketch
+    Methods:
+      - cmsketch_init()
+      - cmsketch_destroy()
+      - cmsketch_add()
+      - cmsketch_add_n()
+      - cmsketch_estimate()
+      - cmsketch_merge()
+    Macros:
+      - cmsketch_total()
+      - cmsketch_bytes()
+*/
+int main()
+{
+    CMSketch sketch;
+
+    printf("--- Dimensions ---\n");
+    printf("Init with epsilon 0 fails? : %s\n", cmsketch_init(&sketch, 0.0, DELTA) == -1 ? "yes" : "no");
+    printf("Init with delta 1 fails? : %s\n", cmsketch_init(&sketch, EPSILON, 1.0) == -1 ? "yes" : "no");
+    cmsketch_init(&sketch, EPSILON, DELTA);
+    printf("Width %d, depth %d, %zu bytes\n", sketch.width, sketch.depth, cmsketch_bytes(&sketch));
+
+    /* A few keys by hand */
+    cmsketch_add(&sketch, 42, 5);
+    cmsketch_add(&sketch, 42, 1);
+    cmsketch_add(&sketch, 7, 100);
+    printf("Key 42 estimated at 6? : %s\n", cmsketch_estimate(&sketch, 42) == 6 ? "yes" : "no");
+    printf("Key 7 estimated at 100? : %s\n", cmsketch_estimate(&sketch, 7) == 100 ? "yes" : "no");
+    printf("Unseen key estimated at 0? : %s\n", cmsketch_estimate(&sketch, 12345) == 0 ? "yes" : "no");
+    printf("Total: %llu\n", (unsigned long long)cmsketch_total(&sketch));
+    cmsketch_destroy(&sketch);
+
+    /* A skewed stream over many keys, against exact counts */
+    printf("\n--- Skewed stream ---\n");
+    uint64_t *keys = malloc(STREAM * sizeof(uint64_t));
+    uint64_t *exact = calloc(KEYS, sizeof(uint64_t));
+    uint64_t state = 5;
+    for(int i = 0; i < STREAM; i++)
+    {
+        keys[i] = skewed_key(&state);
+        exact[keys[i]]++;
+    }
+
+    cmsketch_init(&sketch, EPSILON, DELTA);
+    cmsketch_add_n(&sketch, keys, NULL, STREAM);
+
+    int never_under = 1, over = 0;
+    for(int key = 0; key < KEYS; key++)
+    {
+        uint64_t estimate = cmsketch_estimate(&sketch, key);
+        never_under = never_under && (estimate >= exact[key]);
+        over += (estimate - exact[key] > EPSILON * STREAM);
+    }
+    printf("No key underestimated? : %s\n", never_under ? "yes" : "no");
+    printf("Keys over by more than epsilon * n under delta? : %s\n", over <= DELTA * KEYS ? "yes" : "no");
+
+    /* Batch and one-at-a-time agree */
+    CMSketch single;
+    cmsketch_init(&single, EPSILON, DELTA);
+    for(int i = 0; i < STREAM; i++)
+        cmsketch_add(&single, keys[i], 1);
+    int agree = 1;
+    for(int key = 0; key < KEYS; key++)
+        agree = agree && (cmsketch_estimate(&single, key) == cmsketch_estimate(&sketch, key));
+    printf("Batch update matches one at a time? : %s\n", agree ? "yes" : "no");
+    cmsketch_destroy(&single);
+
+    /* One sketch per thread, merged */
+    printf("\n--- Merge across threads ---\n");
+    Part parts[THREADS];
+    pthread_t threads[THREADS];
+    for(int t = 0; t < THREADS; t++)
+    {
+        parts[t].keys = keys + (long)t * (STREAM / THREADS);
+        parts[t].n = STREAM / THREADS;
+        cmsketch_init(&parts[t].sketch, EPSILON, DELTA);
+        pthread_create(&threads[t], NULL, count_part, &parts[t]);
+    }
+    for(int t = 0; t < THREADS; t++)
+        pthread_join(threads[t], NULL);
+
+    CMSketch merged;
+    cmsketch_init(&merged, EPSILON, DELTA);
+    for(int t = 0; t < THREADS; t++)
+    {
+        cmsketch_merge(&merged, &parts[t].sketch);
+        cmsketch_destroy(&parts[t].sketch);
+    }
+    printf("Merged total matches the stream? : %s\n", cmsketch_total(&merged) == STREAM ? "yes" : "no");
+
+    never_under = 1;
+    over = 0;
+    for(int key = 0; key < KEYS; key++)
+    {
+        uint64_t estimate = cmsketch_estimate(&merged, key);
+        never_under = never_under && (estimate >= exact[key]);
+        over += (estimate - exact[key] > EPSILON * STREAM);
+    }
+    printf("Merged sketch never underestimates? : %s\n", never_under ? "yes" : "no");
+    printf("Merged keys over by more than epsilon * n under delta? : %s\n", over <= DELTA * KEYS ? "yes" : "no");
+
+    CMSketch other;
+    cmsketch_init(&other, 0.01, DELTA);
+    printf("Merge of different dimensions fails? : %s\n", cmsketch_merge(&merged, &other) == -1 ? "yes" : "no");
+    cmsketch_destroy(&other);
+
+    cmsketch_destroy(&merged);
+    cmsketch_destroy(&sketch);
+    free(keys);
+    free(exact);
+
+    return 0;
+}
+
+
+void *count_part(void *arg)
+{
+    Part *part = arg;
+    cmsketch_add_n(&part->sketch, part->keys, NULL, part->n);
+    return NULL;
+}
+
+
+/* Roughly Zipfian keys: the index of the lowest set bit of a random word picks a band, low keys far likelier */
+uint64_t skewed_key(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t r = *state >> 11;
+    int band = __builtin_ctzll(r | (1ULL << 52));
+
+    /* Band b covers keys [2^b - 1, 2^(b+1) - 1) */
+    uint64_t low = (1ULL << band) - 1, width = 1ULL << band;
+    uint64_t key = low + ((r >> 20) % width);
+
+    return (key < KEYS) ? key : (r % KEYS);
+}
@@ -0,0 +1,164 @@
+/* Testing Deque Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "deque.h"
+
+#define ELEMENTS 10000
+
+void print_deque(const Deque *deque);
+int matches_model(const Deque *deque, const int *model, int front, int back);
+
+/* Test the methods and macros of a deque
+    Methods:
+      - deque_init()
+      - deque_destroy()
+      - deque_push_front()
+      - deque_push_back()
+      - deque_pop_front()
+      - deque_pop_back()
+      - deque_block()
+    Macros:
+      - deque_size()
+      - deque_item()
+      - deque_front()
+      - deque_back()
+      - deque_blocks()
+*/
+int main()
+{
+    Deque deque;
+    deque_init(&deque, free);
+
+    /* Small deque built from both ends */
+    printf("--- Push at both ends ---\n");
+    int *data;
+    for(int i = 0; i < 5; i++)
+    {
+        data = malloc(sizeof(int));
+        *data = i;
+        deque_push_back(&deque, data);
+
+        data = malloc(sizeof(int));
+        *data = -i - 1;
+        deque_push_front(&deque, data);
+    }
+    print_deque(&deque);
+    printf("Front: %d, back: %d, item 3: %d\n", *(int *)deque_front(&deque), *(int *)deque_back(&deque), *(int *)deque_item(&deque, 3));
+    printf("Blocks: %d (the front pushes opened a block before the first one)\n", deque_blocks(&deque));
+
+    deque_pop_front(&deque, (void **)&data);
+    printf("Popped front %d, ", *data);
+    free(data);
+    deque_pop_back(&deque, (void **)&data);
+    printf("popped back %d\n", *data);
+    free(data);
+    print_deque(&deque);
+
+    /* Destroy frees what is left */
+    deque_destroy(&deque);
+
+    /* Check against an array model over many block boundaries */
+    printf("\n--- Random pushes and pops against a model ---\n");
+    int *model = malloc(4 * ELEMENTS * sizeof(int));
+    int *values = malloc(ELEMENTS * sizeof(int));
+    int front = 2 * ELEMENTS, back = 2 * ELEMENTS, ok = 1;
+    deque_init(&deque, NULL);
+    srand(7);
+
+    for(int i = 0; i < ELEMENTS; i++)
+    {
+        values[i] = i;
+        void *popped;
+
+        switch(rand() % 6)
+        {
+        case 0: case 1:
+            deque_push_back(&deque, &values[i]);
+            model[back++] = i;
+            break;
+        case 2: case 3:
+            deque_push_front(&deque, &values[i]);
+            model[--front] = i;
+            break;
+        case 4:
+            if(deque_pop_front(&deque, &popped) == 0)
+                ok = ok && (front < back) && (*(int *)popped == model[front++]);
+            else
+                ok = ok && (front == back);
+            break;
+        default:
+            if(deque_pop_back(&deque, &popped) == 0)
+                ok = ok && (front < back) && (*(int *)popped == model[--back]);
+            else
+                ok = ok && (front == back);
+            break;
+        }
+    }
+    printf("Every pop matched the model? : %s\n", ok ? "yes" : "no");
+    printf("Random access matches the model? : %s\n", matches_model(&deque, model, front, back) ? "yes" : "no");
+
+    /* Blocks cover the elements in order */
+    int covered = 0, in_order = 1;
+    for(int b = 0; b < deque_blocks(&deque); b++)
+    {
+        void **block;
+        int count = deque_block(&deque, b, &block);
+        for(int j = 0; j < count; j++)
+            in_order = in_order && (*(int *)block[j] == model[front + covered + j]);
+        covered += count;
+    }
+    printf("Blocks cover %d of %d elements in order? : %s\n", covered, deque_size(&deque), (in_order && covered == deque_size(&deque)) ? "yes" : "no");
+
+    /* Drain from the back, then reuse the empty deque from the front */
+    void *popped;
+    while(deque_pop_back(&deque, &popped) == 0)
+        ;
+    printf("Empty: size %d, blocks %d, front %s\n", deque_size(&deque), deque_blocks(&deque), deque_front(&deque) == NULL ? "NULL" : "not NULL");
+    printf("Pop from empty deque fails? : %s\n", deque_pop_front(&deque, &popped) == -1 ? "yes" : "no");
+
+    /* Use it as a FIFO long enough to slide across the map several times */
+    ok = 1;
+    for(int i = 0; i < 100 * DEQUE_BLOCK; i++)
+    {
+        deque_push_back(&deque, &values[i % ELEMENTS]);
+        if(i >= DEQUE_BLOCK)
+        {
+            deque_pop_front(&deque, &popped);
+            ok = ok && (*(int *)popped == (i - DEQUE_BLOCK) % ELEMENTS);
+        }
+    }
+    printf("Sliding FIFO kept order? : %s\n", ok ? "yes" : "no");
+
+    deque_destroy(&deque);
+    free(model);
+    free(values);
+
+    return 0;
+}
+
+
+/* Print every element, front first */
+void print_deque(const Deque *deque)
+{
+    printf("Deque (size %d): ", deque_size(deque));
+    for(int i = 0; i < deque_size(deque); i++)
+        printf("%d ", *(int *)deque_item(deque, i));
+    printf("\n");
+}
+
+
+/* Compare every element with model[front .. back - 1] */
+int matches_model(const Deque *deque, const int *model, int front, int back)
+{
+    if(deque_size(deque) != back - front)
+        return 0;
+
+    for(int i = 0; i < deque_size(deque); i++)
+    {
+        if(*(int *)deque_item(deque, i) != model[front + i])
+            return 0;
+    }
+
+    return 1;
+}
@@ -1,10 +1,12 @@
 /* Testing Doubly Linked List Implementation */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "dlist.h"
 
 void print_list(DList *list);
+int compare_name(const void *key1, const void *key2);
 
 typedef struct Component_ {
     char *ip_addr;
@@ -18,6 +20,8 @@ typedef struct Component_ {
       - dlist_insert_next()
       - dlist_insert_prev()
       - dlist_remove()
+      - dlist_splice()
+      - dlist_sort()
     Macros:
       - dlist_size()
       - dlist_head()
@@ -77,6 +81,38 @@ int main()
     printf("dlist_next: %s\n", (dlist_is_tail(dlist_next(dlist_prev(dlist_tail(list)))) ? "pass" : "fail" ) );
     printf("dlist_prev: %s\n", (dlist_is_head(dlist_prev(dlist_next(dlist_head(list)))) ? "pass" : "fail" ) );
     
+    /* Splice another dlist after the head -- Its elements are relinked, not copied */
+    DList other;
+    dlist_init(&other, free);
+    Component *c4 = malloc(sizeof(*c4)), *c5 = malloc(sizeof(*c5));
+    c4->ip_addr = "192.168.1.9";
+    c4->name = "phone";
+    c5->ip_addr = "192.168.1.12";
+    c5->name = "tv";
+    dlist_insert_next(&other, NULL, c4);
+    dlist_insert_next(&other, dlist_tail(&other), c5);
+    dlist_splice(list, dlist_head(list), &other);
+    printf("--- Splice 2 elements after the head ---\n");
+    print_list(list);
+    printf("Other list is empty: %s\n", (dlist_size(&other) == 0 && dlist_head(&other) == NULL) ? "pass" : "fail");
+
+    /* Walk backwards to check the prev links */
+    int count = 0;
+    for(DListElement *e = dlist_tail(list); e != NULL; e = dlist_prev(e))
+        count += 1;
+    printf("Backwards walk sees every element: %s\n", (count == dlist_size(list)) ? "pass" : "fail");
+    printf("\n");
+
+    /* Sort by name */
+    dlist_sort(list, compare_name);
+    printf("--- Sorted by name ---\n");
+    print_list(list);
+    count = 0;
+    for(DListElement *e = dlist_tail(list); e != NULL; e = dlist_prev(e))
+        count += 1;
+    printf("Backwards walk after sort sees every element: %s\n", (count == dlist_size(list)) ? "pass" : "fail");
+    printf("\n");
+
     /* Destroy the dlist */
     dlist_destroy(list);
 
@@ -94,3 +130,10 @@ void print_list(DList *list)
     }
     printf("\n");
 }
+
+/* Compare function for dlist_sort() -- Component names in ascending order */
+int compare_name(const void *key1, const void *key2)
+{
+    int cmp = strcmp(((const Component *)key1)->name, ((const Component *)key2)->name);
+    return (cmp > 0) ? 1 : (cmp < 0) ? -1 : 0;
+}
@@ -0,0 +1,112 @@
+/* Testing Intrusive Doubly Linked List Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "idlist.h"
+
+/* A vertex whose adjacency list links edges embedded in an edge pool */
+typedef struct Edge_ {
+    int to;
+    IDListLink link;
+} Edge;
+
+typedef struct Vertex_ {
+    int id;
+    IDList adjacent;
+} Vertex;
+
+void print_list(IDList *list);
+
+/* Test the methods and macros of an intrusive doubly linked list
+    Methods:
+      - idlist_init()
+      - idlist_insert_next()
+      - idlist_insert_prev()
+      - idlist_remove()
+    Macros:
+      - idlist_entry()
+      - idlist_size()
+      - idlist_head()
+      - idlist_is_head()
+      - idlist_tail()
+      - idlist_is_tail()
+      - idlist_next()
+      - idlist_prev()
+*/
+int main()
+{
+    Edge edges[10];
+    IDList list;
+    idlist_init(&list);
+
+    for(int i = 0; i < 5; i++)
+    {
+        edges[i].to = i;
+        idlist_insert_next(&list, idlist_tail(&list), &edges[i].link);
+    }
+    printf("--- Insert 0..4 at tail ---\n");
+    print_list(&list);
+
+    edges[5].to = 99;
+    idlist_insert_prev(&list, idlist_head(&list), &edges[5].link);
+    printf("--- Insert 99 before head ---\n");
+    print_list(&list);
+
+    edges[6].to = 42;
+    idlist_insert_prev(&list, &edges[3].link, &edges[6].link);
+    printf("--- Insert 42 before 3 ---\n");
+    print_list(&list);
+
+    /* Removal only needs the element itself */
+    idlist_remove(&list, &edges[2].link);
+    idlist_remove(&list, &edges[5].link);
+    idlist_remove(&list, &edges[4].link);
+    printf("--- Remove 2, 99 (head) and 4 (tail) ---\n");
+    print_list(&list);
+    printf("Is %d the head? : %s\n", idlist_entry(idlist_head(&list), Edge, link)->to, idlist_is_head(idlist_head(&list)) ? "yes" : "no");
+    printf("Is %d the tail? : %s\n", idlist_entry(idlist_tail(&list), Edge, link)->to, idlist_is_tail(idlist_tail(&list)) ? "yes" : "no");
+    printf("Inserting at NULL in a nonempty list fails? : %s\n", idlist_insert_next(&list, NULL, &edges[7].link) == -1 ? "yes" : "no");
+
+    printf("--- Backwards ---\n");
+    for(IDListLink *link = idlist_tail(&list); link != NULL; link = idlist_prev(link))
+        printf("%d ", idlist_entry(link, Edge, link)->to);
+    printf("\n\n");
+
+    /* Graph adjacency: edges come from one pool, each vertex links the ones leaving it */
+    int pairs[8][2] = { {0, 1}, {0, 2}, {1, 2}, {2, 0}, {2, 3}, {3, 3}, {0, 3}, {1, 3} };
+    Vertex vertices[4];
+    Edge *pool = malloc(8 * sizeof(*pool));
+    for(int i = 0; i < 4; i++)
+    {
+        vertices[i].id = i;
+        idlist_init(&vertices[i].adjacent);
+    }
+    for(int i = 0; i < 8; i++)
+    {
+        pool[i].to = pairs[i][1];
+        idlist_insert_next(&vertices[pairs[i][0]].adjacent, idlist_tail(&vertices[pairs[i][0]].adjacent), &pool[i].link);
+    }
+
+    /* Drop edge 0 -> 2 given only the edge */
+    idlist_remove(&vertices[0].adjacent, &pool[1].link);
+
+    printf("--- Adjacency lists (after removing 0 -> 2) ---\n");
+    for(int i = 0; i < 4; i++)
+    {
+        printf("Vertex %d: ", vertices[i].id);
+        print_list(&vertices[i].adjacent);
+    }
+
+    free(pool);
+
+    return 0;
+}
+
+/* Print the edge targets of a list */
+void print_list(IDList *list)
+{
+    printf("size = %d: ", idlist_size(list));
+    for(IDListLink *link = idlist_head(list); link != NULL; link = idlist_next(link))
+        printf("%d ", idlist_entry(link, Edge, link)->to);
+    printf("\n");
+}
@@ -0,0 +1,117 @@
+/* Testing Intrusive Linked List Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ilist.h"
+
+#define BUCKETS 7
+
+/* An element that can live in a hash bucket -- The link is embedded, so inserting never allocates */
+typedef struct Entry_ {
+    int key;
+    IListLink link;
+} Entry;
+
+void print_list(IList *list);
+Entry *bucket_lookup(IList *bucket, int key);
+
+/* Test the methods and macros of an intrusive list
+    Methods:
+      - ilist_init()
+      - ilist_insert_next()
+      - ilist_remove_next()
+    Macros:
+      - ilist_entry()
+      - ilist_size()
+      - ilist_head()
+      - ilist_is_head()
+      - ilist_tail()
+      - ilist_is_tail()
+      - ilist_next()
+*/
+int main()
+{
+    /* Entries are allocated in one block -- The list itself never calls malloc */
+    Entry entries[10];
+    IList list;
+    ilist_init(&list);
+
+    for(int i = 0; i < 5; i++)
+    {
+        entries[i].key = i;
+        ilist_insert_next(&list, ilist_tail(&list), &entries[i].link);
+    }
+    printf("--- Insert 0..4 at tail ---\n");
+    print_list(&list);
+
+    entries[5].key = 99;
+    ilist_insert_next(&list, NULL, &entries[5].link);
+    printf("--- Insert 99 at head ---\n");
+    print_list(&list);
+
+    entries[6].key = 42;
+    ilist_insert_next(&list, ilist_next(ilist_head(&list)), &entries[6].link);
+    printf("--- Insert 42 after second element ---\n");
+    print_list(&list);
+
+    IListLink *link;
+    ilist_remove_next(&list, NULL, &link);
+    printf("--- Remove head (removed %d) ---\n", ilist_entry(link, Entry, link)->key);
+    print_list(&list);
+
+    /* Remove the tail by finding its predecessor */
+    IListLink *prev = ilist_head(&list);
+    while(!ilist_is_tail(ilist_next(prev)))
+        prev = ilist_next(prev);
+    ilist_remove_next(&list, prev, &link);
+    printf("--- Remove tail (removed %d) ---\n", ilist_entry(link, Entry, link)->key);
+    print_list(&list);
+    printf("Is %d the head? : %s\n", ilist_entry(ilist_head(&list), Entry, link)->key, ilist_is_head(&list, ilist_head(&list)) ? "yes" : "no");
+    printf("Is %d the tail? : %s\n", ilist_entry(ilist_tail(&list), Entry, link)->key, ilist_is_tail(ilist_tail(&list)) ? "yes" : "no");
+    printf("Removing after the tail fails? : %s\n", ilist_remove_next(&list, ilist_tail(&list), &link) == -1 ? "yes" : "no");
+    printf("\n");
+
+    /* Use intrusive lists as hash buckets (as CHTbl would) */
+    IList buckets[BUCKETS];
+    for(int i = 0; i < BUCKETS; i++)
+        ilist_init(&buckets[i]);
+
+    Entry *pool = malloc(50 * sizeof(*pool));
+    for(int i = 0; i < 50; i++)
+    {
+        pool[i].key = i * 3;
+        ilist_insert_next(&buckets[pool[i].key % BUCKETS], NULL, &pool[i].link);
+    }
+
+    printf("--- Hash buckets (key %% %d) ---\n", BUCKETS);
+    for(int i = 0; i < BUCKETS; i++)
+        printf("Bucket %d: size = %d\n", i, ilist_size(&buckets[i]));
+    printf("Found 27? : %s\n", bucket_lookup(&buckets[27 % BUCKETS], 27) != NULL ? "yes" : "no");
+    printf("Found 28? : %s\n", bucket_lookup(&buckets[28 % BUCKETS], 28) != NULL ? "yes" : "no");
+
+    /* The caller owns all storage -- One free releases every element of every bucket */
+    free(pool);
+
+    return 0;
+}
+
+/* Print the keys of a list */
+void print_list(IList *list)
+{
+    printf("List size: %d\n", ilist_size(list));
+    for(IListLink *link = ilist_head(list); link != NULL; link = ilist_next(link))
+        printf("%d ", ilist_entry(link, Entry, link)->key);
+    printf("\n");
+}
+
+/* Walk a bucket -- One load per element, since the key lives beside the link */
+Entry *bucket_lookup(IList *bucket, int key)
+{
+    for(IListLink *link = ilist_head(bucket); link != NULL; link = ilist_next(link))
+    {
+        Entry *entry = ilist_entry(link, Entry, link);
+        if(entry->key == key)
+            return entry;
+    }
+    return NULL;
+}
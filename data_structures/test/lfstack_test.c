@@ -0,0 +1,147 @@
+/* Testing Lock-Free Stack and Hazard Pointer Implementations */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "hazard.h"
+#include "lfstack.h"
+
+#define THREADS 4
+#define PER_THREAD 100000
+
+void *worker(void *arg);
+void count_reclaim(void *ptr);
+
+/* Per-thread state for the concurrent test */
+typedef struct Worker_ {
+    LFStack *stack;
+    int id;
+    uintptr_t popped_sum;
+} Worker;
+
+static int reclaimed = 0;
+
+/* Test the methods and macros of the lock-free stack and hazard pointers
+    Methods:
+      - lfstack_init()
+      - lfstack_destroy()
+      - lfstack_push()
+      - lfstack_pop()
+      - hazard_init()
+      - hazard_destroy()
+      - hazard_acquire()
+      - hazard_release()
+      - hazard_protect()
+      - hazard_retire()
+      - hazard_scan()
+    Macros:
+      - lfstack_domain()
+      - lfstack_is_empty()
+      - hazard_clear()
+      - hazard_retired()
+*/
+int main()
+{
+    /* Hazard pointers on their own -- A protected pointer survives a scan, an unprotected one is reclaimed */
+    HazardDomain domain;
+    hazard_init(&domain, count_reclaim);
+    HazardRecord *reader = hazard_acquire(&domain), *writer = hazard_acquire(&domain);
+    int a = 1, b = 2;
+    _Atomic(void *) shared = &a;
+
+    printf("--- Hazard pointers ---\n");
+    printf("Protected pointer is the shared one? : %s\n", hazard_protect(reader, 0, &shared) == &a ? "yes" : "no");
+    atomic_store(&shared, &b);
+    hazard_retire(writer, &a);
+    hazard_scan(writer);
+    printf("Protected pointer kept after scan? : %s (retired = %d)\n", reclaimed == 0 ? "yes" : "no", hazard_retired(writer));
+    hazard_clear(reader, 0);
+    hazard_scan(writer);
+    printf("Reclaimed once cleared? : %s (retired = %d)\n", reclaimed == 1 ? "yes" : "no", hazard_retired(writer));
+    hazard_release(reader);
+    printf("Released record is reused? : %s\n", hazard_acquire(&domain) == reader ? "yes" : "no");
+    hazard_destroy(&domain);
+    printf("\n");
+
+    /* Single-threaded stack semantics */
+    LFStack *stack = aligned_alloc(LFSTACK_CACHE_LINE, sizeof(*stack));
+    lfstack_init(stack, NULL);
+    HazardRecord *record = hazard_acquire(lfstack_domain(stack));
+    int values[5], *data, order = 1;
+    for(int i = 0; i < 5; i++)
+    {
+        values[i] = i;
+        lfstack_push(stack, &values[i]);
+    }
+    for(int i = 4; i >= 0; i--)
+    {
+        lfstack_pop(stack, record, (void **)&data);
+        order = order && (*data == i);
+    }
+    printf("--- Single thread ---\n");
+    printf("Popped in LIFO order? : %s\n", order ? "yes" : "no");
+    printf("Stack is empty? : %s\n", lfstack_is_empty(stack) ? "yes" : "no");
+    printf("Pop from empty stack fails? : %s\n", lfstack_pop(stack, record, (void **)&data) == -1 ? "yes" : "no");
+    hazard_release(record);
+    lfstack_destroy(stack);
+    printf("\n");
+
+    /* Threads pushing and popping concurrently -- Every value pushed must be popped exactly once */
+    lfstack_init(stack, NULL);
+    pthread_t threads[THREADS];
+    Worker workers[THREADS];
+    for(int i = 0; i < THREADS; i++)
+    {
+        workers[i] = (Worker){stack, i, 0};
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+
+    uintptr_t sum = 0;
+    for(int i = 0; i < THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        sum += workers[i].popped_sum;
+    }
+
+    /* Drain what is left */
+    record = hazard_acquire(lfstack_domain(stack));
+    void *left;
+    while(lfstack_pop(stack, record, &left) == 0)
+        sum += (uintptr_t)left;
+    hazard_release(record);
+
+    uintptr_t n = (uintptr_t)THREADS * PER_THREAD;
+    printf("--- %d threads pushing and popping ---\n", THREADS);
+    printf("Every value popped exactly once? : %s\n", sum == n * (n + 1) / 2 ? "yes" : "no");
+
+    lfstack_destroy(stack);
+    free(stack);
+
+    return 0;
+}
+
+/* Push this thread's values (id + 1, id + 1 + THREADS, ...) and pop after every other push */
+void *worker(void *arg)
+{
+    Worker *worker = arg;
+    HazardRecord *record = hazard_acquire(lfstack_domain(worker->stack));
+    void *data;
+
+    for(uintptr_t i = 0; i < PER_THREAD; i++)
+    {
+        lfstack_push(worker->stack, (void *)(i * THREADS + worker->id + 1));
+        if( (i % 2 == 1) && (lfstack_pop(worker->stack, record, &data) == 0) )
+            worker->popped_sum += (uintptr_t)data;
+    }
+
+    hazard_release(record);
+    return NULL;
+}
+
+/* Reclaim function that only counts */
+void count_reclaim(void *ptr)
+{
+    (void)ptr;
+    reclaimed += 1;
+}
@@ -5,6 +5,8 @@
 #include "list.h"
 
 void print_list(List *list);
+int is_small_id(const void *data, void *arg);
+int compare_id(const void *key1, const void *key2);
 
 typedef struct Node_ {
     char *name;
@@ -17,6 +19,10 @@ typedef struct Node_ {
       - list_destroy()
       - list_insert_next()
       - list_remove_next()
+      - list_splice()
+      - list_append_array()
+      - list_remove_if()
+      - list_sort()
     macros:
       - list_size()
       - list_head()
@@ -64,6 +70,80 @@ int main()
     printf("list_is_tail: %s\n", (list_is_tail(list_tail(list)) ? "pass" : "fail"));
     printf("\n");
     
+    /* Append an array of nodes in one call */
+    Node n5 = {"alpha", 7}, n6 = {"beta", 3}, n7 = {"gamma", 21};
+    void *batch[] = {&n5, &n6, &n7};
+    list_append_array(list, batch, 3);
+    printf("--- Appended array of 3 nodes ---\n");
+    print_list(list);
+    printf("\n");
+
+    /* Splice another list after the head -- Its elements are relinked, not copied */
+    List other;
+    list_init(&other, NULL);
+    Node n8 = {"spliced", 100}, n9 = {"also spliced", 101};
+    list_insert_next(&other, NULL, &n8);
+    list_insert_next(&other, list_tail(&other), &n9);
+    list_splice(list, list_head(list), &other);
+    printf("--- Spliced 2 nodes after the head ---\n");
+    print_list(list);
+    printf("Other list is empty: %s\n", (list_size(&other) == 0 && list_head(&other) == NULL) ? "pass" : "fail");
+
+    /* Splice back at the head, then onto the tail */
+    list_insert_next(&other, NULL, &n9);
+    list_splice(list, NULL, &other);
+    list_insert_next(&other, NULL, &n8);
+    list_splice(list, list_tail(list), &other);
+    printf("--- Spliced a node at the head and one at the tail ---\n");
+    print_list(list);
+    printf("Tail updated: %s\n", (list_data(list_tail(list)) == &n8) ? "pass" : "fail");
+    printf("\n");
+
+    /* Remove every node with an id below 10 in one pass */
+    int limit = 10;
+    printf("--- Removed %d nodes with id < %d ---\n", list_remove_if(list, is_small_id, &limit), limit);
+    print_list(list);
+    printf("Tail updated: %s\n", (list_data(list_tail(list)) == &n8) ? "pass" : "fail");
+    printf("\n");
+
+    /* Sort by id -- Equal ids keep their order */
+    list_sort(list, compare_id);
+    printf("--- Sorted by id ---\n");
+    print_list(list);
+    printf("Tail updated: %s\n", (list_data(list_tail(list)) == &n9) ? "pass" : "fail");
+    printf("\n");
+
+    /* Sort a large random list and check order, stability and size */
+    List big;
+    list_init(&big, NULL);
+    int num = 100000;
+    Node *nodes = malloc(num * sizeof(*nodes));
+    srand(11);
+    for(int i = 0; i < num; i++)
+    {
+        nodes[i].name = NULL;
+        nodes[i].id = rand() % 1000;
+        list_insert_next(&big, list_tail(&big), &nodes[i]);
+    }
+    list_sort(&big, compare_id);
+    int sorted = 1, count = 0;
+    for(ListElement *e = list_head(&big); e != NULL; e = list_next(e), count++)
+    {
+        Node *cur = list_data(e);
+        if(list_next(e) != NULL)
+        {
+            Node *next = list_data(list_next(e));
+            /* Nodes live in one array, so a lower address means the node was inserted earlier */
+            if( (cur->id > next->id) || ((cur->id == next->id) && (cur > next)) )
+                sorted = 0;
+        }
+    }
+    printf("--- Sorted %d random ids ---\n", num);
+    printf("Sorted and stable: %s\n", (sorted && count == list_size(&big) && list_is_tail(list_tail(&big))) ? "pass" : "fail");
+    list_destroy(&big);
+    free(nodes);
+    printf("\n");
+
     /* Destroy the list */
     list_destroy(list);
 
@@ -82,3 +162,16 @@ void print_list(List *list)
     printf("\n");
 }
 
+
+/* Predicate for list_remove_if() -- Node ids below *arg */
+int is_small_id(const void *data, void *arg)
+{
+    return ((const Node *)data)->id < *(int *)arg;
+}
+
+/* Compare function for list_sort() -- Node ids in ascending order */
+int compare_id(const void *key1, const void *key2)
+{
+    int id1 = ((const Node *)key1)->id, id2 = ((const Node *)key2)->id;
+    return (id1 > id2) ? 1 : (id1 < id2) ? -1 : 0;
+}
@@ -0,0 +1,141 @@
+/* Testing Running Median Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "median.h"
+
+#define SAMPLES 200000
+
+int compare(const void *key1, const void *key2);
+double rank_error(const double *sorted, int count, double estimate, double q);
+
+/* Test the methods and macros of a running median and quantile sketch
+    Methods:
+      - qsketch_init()
+      - qsketch_destroy()
+      - qsketch_add()
+      - qsketch_add_n()
+      - qsketch_quantile()
+      - median_init()
+      - median_destroy()
+      - median_add()
+      - median_get()
+      - median_quantile()
+    Macros:
+      - qsketch_count()
+      - median_count()
+*/
+int main()
+{
+    Median median;
+    double value;
+
+    /* Exact mode on a few samples */
+    printf("--- Exact mode ---\n");
+    median_init(&median, MEDIAN_EXACT);
+    printf("Median of nothing fails? : %s\n", median_get(&median, &value) == -1 ? "yes" : "no");
+    double small[] = {5, 1, 9, 3, 7, 2, 8};
+    for(int i = 0; i < 7; i++)
+    {
+        median_add(&median, small[i]);
+        median_get(&median, &value);
+        printf("Add %.0f -> count %llu, median %.1f\n", small[i], (unsigned long long)median_count(&median), value);
+    }
+    printf("Quantile in exact mode fails? : %s\n", median_quantile(&median, 0.9, &value) == -1 ? "yes" : "no");
+    median_destroy(&median);
+
+    /* Exact mode against sorting, checked along the way */
+    double *values = malloc(SAMPLES * sizeof(double));
+    double *sorted = malloc(SAMPLES * sizeof(double));
+    srand(21);
+    for(int i = 0; i < SAMPLES; i++)
+        values[i] = (rand() % 1000000) / 100.0;
+
+    median_init(&median, MEDIAN_EXACT);
+    int ok = 1;
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        median_add(&median, values[i]);
+        if(i % 9973 == 0 || i == SAMPLES - 1)
+        {
+            memcpy(sorted, values, (i + 1) * sizeof(double));
+            qsort(sorted, i + 1, sizeof(double), compare);
+            double expected = (i % 2 == 0) ? sorted[i / 2] : (sorted[i / 2] + sorted[i / 2 + 1]) / 2.0;
+            median_get(&median, &value);
+            ok = ok && (value == expected);
+        }
+    }
+    printf("Exact median matches sorting over %d samples? : %s\n", SAMPLES, ok ? "yes" : "no");
+    median_destroy(&median);
+
+    /* Approximate mode: error measured in rank, which is what the sketch bounds */
+    printf("\n--- Approximate mode ---\n");
+    median_init(&median, MEDIAN_APPROX);
+    for(int i = 0; i < SAMPLES; i++)
+        median_add(&median, values[i]);
+    median_get(&median, &value);
+    printf("Median rank error under 0.5%%? : %s\n", rank_error(sorted, SAMPLES, value, 0.5) < 0.005 ? "yes" : "no");
+
+    double qs[] = {0.0, 0.01, 0.1, 0.25, 0.75, 0.9, 0.99, 0.999, 1.0};
+    ok = 1;
+    for(int i = 0; i < 9; i++)
+    {
+        median_quantile(&median, qs[i], &value);
+        double error = rank_error(sorted, SAMPLES, value, qs[i]);
+
+        /* Tighter in the tails, where centroids are small */
+        double allowed = (qs[i] < 0.05 || qs[i] > 0.95) ? 0.001 : 0.005;
+        ok = ok && (error <= allowed);
+    }
+    printf("Quantiles from 0 to 1 within rank error bounds? : %s\n", ok ? "yes" : "no");
+    median_quantile(&median, 0.0, &value);
+    printf("Quantile 0 is the exact minimum? : %s\n", value == sorted[0] ? "yes" : "no");
+    median_quantile(&median, 1.0, &value);
+    printf("Quantile 1 is the exact maximum? : %s\n", value == sorted[SAMPLES - 1] ? "yes" : "no");
+    median_destroy(&median);
+
+    /* Memory stays fixed however long the stream */
+    printf("\n--- Long stream through a sketch ---\n");
+    QSketch sketch;
+    printf("Init with compression 0 fails? : %s\n", qsketch_init(&sketch, 0) == -1 ? "yes" : "no");
+    qsketch_init(&sketch, 100);
+    for(int round = 0; round < 50; round++)
+        qsketch_add_n(&sketch, values, SAMPLES);
+    qsketch_quantile(&sketch, 0.99, &value);
+    printf("Samples: %llu, centroids: %d of at most %d\n", (unsigned long long)qsketch_count(&sketch), sketch.centroids, sketch.capacity);
+    printf("p99 rank error under 0.1%%? : %s\n", rank_error(sorted, SAMPLES, value, 0.99) < 0.001 ? "yes" : "no");
+    qsketch_destroy(&sketch);
+
+    free(values);
+    free(sorted);
+
+    return 0;
+}
+
+
+int compare(const void *key1, const void *key2)
+{
+    double a = *(const double *)key1, b = *(const double *)key2;
+    return (a > b) ? 1 : (a < b) ? -1 : 0;
+}
+
+
+/* Distance, as a fraction of the samples, between q and the range of ranks the estimate falls in */
+double rank_error(const double *sorted, int count, double estimate, double q)
+{
+    int below = 0, upto = 0;
+    while(below < count && sorted[below] < estimate)
+        below++;
+    upto = below;
+    while(upto < count && sorted[upto] <= estimate)
+        upto++;
+
+    double low = (double)below / count, high = (double)upto / count;
+    if(q < low)
+        return low - q;
+    if(q > high)
+        return q - high;
+    return 0.0;
+}
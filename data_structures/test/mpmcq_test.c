@@ -0,0 +1,121 @@
+/* Testing Multi-Producer/Multi-Consumer Queue Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "mpmcq.h"
+
+#define THREADS 4
+#define PER_THREAD 200000
+
+void *producer(void *arg);
+void *consumer(void *arg);
+
+/* Each producer pushes ids tagged with its own number so consumers can check per-producer order */
+typedef struct Worker_ {
+    MPMCQueue *queue;
+    int id;
+    uintptr_t sum;
+    int out_of_order;
+} Worker;
+
+/* Test the methods and macros of an MPMC queue
+    Methods:
+      - mpmcq_init()
+      - mpmcq_destroy()
+      - mpmcq_try_push()
+      - mpmcq_try_pop()
+      - mpmcq_push()
+      - mpmcq_pop()
+    Macros:
+      - mpmcq_capacity()
+*/
+int main()
+{
+    MPMCQueue *queue = aligned_alloc(MPMCQ_CACHE_LINE, sizeof(*queue));
+    if( (queue == NULL) || (mpmcq_init(queue, 5) != 0) )
+        return -1;
+
+    /* Single-threaded semantics */
+    int values[10], *data, order = 1;
+    for(int i = 0; i < 10; i++)
+        values[i] = i;
+
+    printf("--- Single thread ---\n");
+    printf("Capacity rounded up to %zu\n", mpmcq_capacity(queue));
+    for(int i = 0; i < 8; i++)
+        mpmcq_try_push(queue, &values[i]);
+    printf("Push onto full queue fails? : %s\n", mpmcq_try_push(queue, &values[8]) == -1 ? "yes" : "no");
+    for(int i = 0; i < 8; i++)
+    {
+        mpmcq_try_pop(queue, (void **)&data);
+        order = order && (*data == i);
+    }
+    printf("Popped 8 in FIFO order? : %s\n", order ? "yes" : "no");
+    printf("Pop from empty queue fails? : %s\n", mpmcq_try_pop(queue, (void **)&data) == -1 ? "yes" : "no");
+    mpmcq_destroy(queue);
+    printf("\n");
+
+    /* Several blocking producers and consumers through a small queue, so both sides sleep */
+    mpmcq_init(queue, 64);
+    pthread_t producers[THREADS], consumers[THREADS];
+    Worker prod[THREADS], cons[THREADS];
+    for(int i = 0; i < THREADS; i++)
+    {
+        prod[i] = (Worker){queue, i, 0, 0};
+        cons[i] = (Worker){queue, i, 0, 0};
+        pthread_create(&consumers[i], NULL, consumer, &cons[i]);
+        pthread_create(&producers[i], NULL, producer, &prod[i]);
+    }
+
+    uintptr_t sum = 0;
+    int out_of_order = 0;
+    for(int i = 0; i < THREADS; i++)
+    {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        sum += cons[i].sum;
+        out_of_order += cons[i].out_of_order;
+    }
+
+    uintptr_t n = (uintptr_t)THREADS * PER_THREAD;
+    printf("--- %d producers and %d consumers ---\n", THREADS, THREADS);
+    printf("Every value arrived exactly once? : %s\n", sum == n * (n - 1) / 2 ? "yes" : "no");
+    printf("Each producer's values arrived in order at each consumer? : %s\n", out_of_order == 0 ? "yes" : "no");
+
+    mpmcq_destroy(queue);
+    free(queue);
+
+    return 0;
+}
+
+/* Push this producer's share of 0..THREADS*PER_THREAD-1 (value = i * THREADS + id) */
+void *producer(void *arg)
+{
+    Worker *worker = arg;
+    for(uintptr_t i = 0; i < PER_THREAD; i++)
+        mpmcq_push(worker->queue, (void *)(i * THREADS + worker->id));
+    return NULL;
+}
+
+/* Pop PER_THREAD values, summing them and checking that values from one producer keep increasing */
+void *consumer(void *arg)
+{
+    Worker *worker = arg;
+    intptr_t last[THREADS];
+    void *data;
+    for(int i = 0; i < THREADS; i++)
+        last[i] = -1;
+
+    for(int i = 0; i < PER_THREAD; i++)
+    {
+        mpmcq_pop(worker->queue, &data);
+        uintptr_t value = (uintptr_t)data;
+        worker->sum += value;
+        if((intptr_t)value <= last[value % THREADS])
+            worker->out_of_order += 1;
+        last[value % THREADS] = value;
+    }
+    return NULL;
+}
@@ -17,13 +17,16 @@ typedef struct Function_ {
       - queue_destroy()
       - queue_push()
       - queue_pop()
+      - queue_reserve()
+      - queue_push_n()
+      - queue_pop_n()
     Macros:
       - queue_peek()
+      - queue_item()
       - queue_size()
 
     Notes:
-      - Queues are implemented as linked lists
-      - All linked list operations are also available for queues
+      - Queues are implemented as power-of-two ring buffers
 */
 int main()
 {
@@ -66,15 +69,55 @@ int main()
     /* Destroy the queue */
     queue_destroy(q);
 
+    /* Bulk operations on a queue of ints */
+    Queue ints;
+    queue_init(&ints, NULL);
+    int values[1000];
+    void *batch[1000];
+    for(int i = 0; i < 1000; i++)
+    {
+        values[i] = i;
+        batch[i] = &values[i];
+    }
+
+    printf("--- Bulk push and pop ---\n");
+    queue_reserve(&ints, 100);
+    printf("Reserved capacity is 128: %s\n", (ints.capacity == 128) ? "pass" : "fail");
+
+    /* Advance the head so later pushes wrap around the end of the buffer */
+    queue_push_n(&ints, batch, 100);
+    int popped = queue_pop_n(&ints, batch, 90), order = 1;
+    for(int i = 0; i < popped; i++)
+        order = order && (*(int *)batch[i] == i);
+    printf("Popped %d, in FIFO order: %s\n", popped, order ? "pass" : "fail");
+
+    /* Push enough to wrap and then grow -- Order must survive both */
+    for(int i = 100; i < 1000; i++)
+        queue_push(&ints, &values[i]);
+    printf("Size after wrapping and growing: %d (capacity %d)\n", queue_size(&ints), ints.capacity);
+    printf("Front is 90: %s\n", (*(int *)queue_peek(&ints) == 90) ? "pass" : "fail");
+    order = 1;
+    for(int i = 0; i < queue_size(&ints); i++)
+        order = order && (*(int *)queue_item(&ints, i) == 90 + i);
+    printf("Items in order after growth: %s\n", order ? "pass" : "fail");
+
+    popped = queue_pop_n(&ints, batch, 2000);
+    order = 1;
+    for(int i = 0; i < popped; i++)
+        order = order && (*(int *)batch[i] == 90 + i);
+    printf("Popped remaining %d in order: %s\n", popped, order ? "pass" : "fail");
+    printf("Pop from empty queue fails: %s\n", (queue_pop(&ints, batch) == -1 && queue_peek(&ints) == NULL) ? "pass" : "fail");
+    queue_destroy(&ints);
+
     return 0;
 }
 
 void print_queue(Queue *q)
 {
     printf("Size: %d, Contents: ", queue_size(q));
-    for(ListElement *e = list_head(q); e != NULL; e = list_next(e))
+    for(int i = 0; i < queue_size(q); i++)
     {
-        Function *data = (Function *)list_data(e);
+        Function *data = (Function *)queue_item(q, i);
         printf("(name = '%s', addr = 0x%x)  ", data->name, data->addr);
     }
     printf("\n");
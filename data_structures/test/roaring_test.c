@@ -0,0 +1,198 @@
+/* Test of Roaring Bitmap Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "roaring.h"
+
+/* Values used by the larger tests lie in [0, LIMIT) so a plain byte array can check the results */
+#define LIMIT (1 << 20)
+
+void print_roaring(Roaring *bitmap, char *name);
+void print_containers(Roaring *bitmap, char *name);
+int check_roaring(Roaring *bitmap, const unsigned char *expected);
+
+/* Testing methods and macros
+    Methods:
+      - roaring_init()
+      - roaring_destroy()
+      - roaring_insert()
+      - roaring_remove()
+      - roaring_is_element()
+      - roaring_union()
+      - roaring_intersection()
+      - roaring_difference()
+      - roaring_cardinality()
+      - roaring_optimize()
+      - roaring_iter_init()
+      - roaring_iter_next()
+      - roaring_serialized_size()
+      - roaring_serialize()
+      - roaring_deserialize()
+    Macros:
+      - roaring_containers()
+      - roaring_is_empty()
+*/
+int main()
+{
+    /* Small bitmaps spanning a few chunks */
+    Roaring A, B;
+    roaring_init(&A);
+    roaring_init(&B);
+
+    uint32_t a_vals[] = {1, 5, 70000, 70001, 4000000000u, 3, 5};
+    uint32_t b_vals[] = {5, 6, 70001, 200000, 4000000000u};
+    printf("--- Inserting Values ---\n");
+    for(int i = 0; i < 7; i++)
+        printf("Insert %u into A: %d\n", a_vals[i], roaring_insert(&A, a_vals[i]));
+    for(int i = 0; i < 5; i++)
+        roaring_insert(&B, b_vals[i]);
+    print_roaring(&A, "A");
+    print_roaring(&B, "B");
+    printf("\n");
+
+    /* Set algebra */
+    Roaring AuB, AB, A_B;
+    roaring_union(&AuB, &A, &B);
+    roaring_intersection(&AB, &A, &B);
+    roaring_difference(&A_B, &A, &B);
+    printf("--- Performed Set Algebra ---\n");
+    print_roaring(&AuB, "A+B");
+    print_roaring(&AB, "AB");
+    print_roaring(&A_B, "A-B");
+    printf("\n");
+
+    /* Membership and removal */
+    printf("--- Membership and Removal ---\n");
+    printf("70000 in A? : %s\n", roaring_is_element(&A, 70000) ? "yes" : "no");
+    printf("70002 in A? : %s\n", roaring_is_element(&A, 70002) ? "yes" : "no");
+    printf("Remove 70000 from A: %d\n", roaring_remove(&A, 70000));
+    printf("Remove 70000 from A: %d\n", roaring_remove(&A, 70000));
+    print_roaring(&A, "A");
+    printf("\n");
+
+    /* Larger bitmaps -- Sparse values, a dense block, and long runs */
+    unsigned char *in_c = calloc(LIMIT, 1), *in_d = calloc(LIMIT, 1), *expected = calloc(LIMIT, 1);
+    Roaring C, D;
+    roaring_init(&C);
+    roaring_init(&D);
+    for(uint32_t v = 0; v < LIMIT; v += 97)
+        in_c[v] = 1;
+    for(uint32_t v = 131072; v < 196608; v += 2)
+        in_c[v] = 1;
+    for(uint32_t v = 300000; v < 700000; v++)
+        in_d[v] = 1;
+    for(uint32_t v = 0; v < LIMIT; v += 13)
+        in_d[v] = 1;
+    for(uint32_t v = 0; v < LIMIT; v++)
+    {
+        if(in_c[v])
+            roaring_insert(&C, v);
+        if(in_d[v])
+            roaring_insert(&D, v);
+    }
+    printf("--- Larger Bitmaps ---\n");
+    print_containers(&C, "C");
+    print_containers(&D, "D");
+    roaring_optimize(&D);
+    printf("After roaring_optimize():\n");
+    print_containers(&D, "D");
+
+    Roaring CuD, CD, C_D;
+    roaring_union(&CuD, &C, &D);
+    roaring_intersection(&CD, &C, &D);
+    roaring_difference(&C_D, &C, &D);
+    for(uint32_t v = 0; v < LIMIT; v++)
+        expected[v] = in_c[v] | in_d[v];
+    printf("C+D correct? : %s\n", check_roaring(&CuD, expected) ? "yes" : "no");
+    for(uint32_t v = 0; v < LIMIT; v++)
+        expected[v] = in_c[v] & in_d[v];
+    printf("CD correct?  : %s\n", check_roaring(&CD, expected) ? "yes" : "no");
+    for(uint32_t v = 0; v < LIMIT; v++)
+        expected[v] = in_c[v] & !in_d[v];
+    printf("C-D correct? : %s\n", check_roaring(&C_D, expected) ? "yes" : "no");
+    printf("\n");
+
+    /* Serialization round trip */
+    printf("--- Serialization ---\n");
+    size_t bytes = roaring_serialized_size(&D);
+    unsigned char *buf = malloc(bytes);
+    printf("Serialized D: %zu bytes (written %zu)\n", bytes, roaring_serialize(&D, buf));
+    Roaring E;
+    printf("Deserialize D: %d\n", roaring_deserialize(&E, buf, bytes));
+    printf("Round trip correct? : %s\n", check_roaring(&E, in_d) ? "yes" : "no");
+    roaring_destroy(&E);
+    printf("Deserialize truncated buffer: %d\n", roaring_deserialize(&E, buf, bytes - 1));
+    printf("Deserialize empty buffer: %d\n", roaring_deserialize(&E, buf, 0));
+    printf("\n");
+
+    /* Destroy the bitmaps */
+    roaring_destroy(&A);
+    roaring_destroy(&B);
+    roaring_destroy(&AuB);
+    roaring_destroy(&AB);
+    roaring_destroy(&A_B);
+    roaring_destroy(&C);
+    roaring_destroy(&D);
+    roaring_destroy(&CuD);
+    roaring_destroy(&CD);
+    roaring_destroy(&C_D);
+    free(in_c);
+    free(in_d);
+    free(expected);
+    free(buf);
+
+    return 0;
+}
+
+/* Check a bitmap against a byte per possible value, using both membership tests and iteration */
+int check_roaring(Roaring *bitmap, const unsigned char *expected)
+{
+    uint64_t count = 0;
+    for(uint32_t v = 0; v < LIMIT; v++)
+    {
+        if(roaring_is_element(bitmap, v) != expected[v])
+            return 0;
+        count += expected[v];
+    }
+    if(roaring_cardinality(bitmap) != count)
+        return 0;
+
+    RoaringIter iter;
+    uint32_t value, prev = 0, seen = 0;
+    roaring_iter_init(&iter, bitmap);
+    while(roaring_iter_next(&iter, &value))
+    {
+        if(value >= LIMIT || !expected[value] || (seen > 0 && value <= prev))
+            return 0;
+        prev = value;
+        seen++;
+    }
+
+    return seen == count;
+}
+
+void print_roaring(Roaring *bitmap, char *name)
+{
+    RoaringIter iter;
+    uint32_t value;
+
+    printf("Bitmap %s:  Size = %llu,  Contents = ", name, (unsigned long long)roaring_cardinality(bitmap));
+    roaring_iter_init(&iter, bitmap);
+    while(roaring_iter_next(&iter, &value))
+        printf("%u  ", value);
+    printf("\n");
+}
+
+void print_containers(Roaring *bitmap, char *name)
+{
+    static const char *types[] = {"array", "bitmap", "run"};
+
+    printf("Bitmap %s:  Size = %llu,  Containers = %d%s\n", name, (unsigned long long)roaring_cardinality(bitmap),
+           roaring_containers(bitmap), roaring_is_empty(bitmap) ? " (empty)" : "");
+    for(int i = 0; i < roaring_containers(bitmap); i++)
+    {
+        RoaringContainer *c = &bitmap->containers[i];
+        printf("  key %2u: %-6s (%d values)\n", c->key, types[c->type], c->cardinality);
+    }
+}
@@ -0,0 +1,151 @@
+/* Testing Skip List Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "skiplist.h"
+
+int compare_int(const void *key1, const void *key2);
+int print_int(const void *data, void *arg);
+void print_list(SkipList *list);
+
+/* Test the methods and macros of a skip list
+    Methods:
+      - skiplist_init()
+      - skiplist_destroy()
+      - skiplist_insert()
+      - skiplist_remove()
+      - skiplist_lookup()
+      - skiplist_lower_bound()
+      - skiplist_range()
+    Macros:
+      - skiplist_size()
+      - skiplist_first()
+      - skiplist_next()
+      - skiplist_data()
+*/
+int main()
+{
+    SkipList list;
+    if(skiplist_init(&list, compare_int, NULL) != 0)
+        return -1;
+
+    /* Insert multiples of 5 in scrambled order */
+    int values[20];
+    for(int i = 0; i < 20; i++)
+        values[i] = ((i * 7) % 20) * 5;
+    for(int i = 0; i < 20; i++)
+        skiplist_insert(&list, &values[i]);
+    printf("--- Inserted 20 multiples of 5 ---\n");
+    print_list(&list);
+
+    int dup = 35;
+    printf("Inserting 35 again returns 1? : %s\n", skiplist_insert(&list, &dup) == 1 ? "yes" : "no");
+
+    /* Lookup */
+    int key = 40, *data = &key;
+    printf("Found 40? : %s\n", skiplist_lookup(&list, (void **)&data) == 0 ? "yes" : "no");
+    key = 41;
+    data = &key;
+    printf("Found 41? : %s\n", skiplist_lookup(&list, (void **)&data) == 0 ? "yes" : "no");
+
+    /* Lower bound */
+    key = 41;
+    SkipListNode *node = skiplist_lower_bound(&list, &key);
+    printf("Lower bound of 41: %d\n", *(int *)skiplist_data(node));
+    key = 96;
+    printf("Lower bound of 96 is NULL? : %s\n", skiplist_lower_bound(&list, &key) == NULL ? "yes" : "no");
+
+    /* Range scans */
+    int low = 22, high = 60;
+    printf("--- Range [22, 60) ---\n");
+    printf("\nVisited %d\n", skiplist_range(&list, &low, &high, print_int, NULL));
+    int limit = 3;
+    printf("--- Range [22, end) stopping after 3 ---\n");
+    printf("\nVisited %d\n", skiplist_range(&list, &low, NULL, print_int, &limit));
+
+    /* Remove some elements */
+    int keys[] = {0, 50, 95, 51};
+    for(int i = 0; i < 4; i++)
+    {
+        data = &keys[i];
+        int retval = skiplist_remove(&list, (void **)&data);
+        printf("Remove %d: %s\n", keys[i], retval == 0 ? "removed" : "not found");
+    }
+    print_list(&list);
+    skiplist_destroy(&list);
+
+    /* Random inserts and removes checked against a presence table */
+    int universe = 5000, *present = calloc(universe, sizeof(*present)), *pool = malloc(universe * sizeof(*pool));
+    skiplist_init(&list, compare_int, NULL);
+    for(int i = 0; i < universe; i++)
+        pool[i] = i;
+    srand(5);
+    int ok = 1, count = 0;
+    for(int round = 0; round < 50000 && ok; round++)
+    {
+        int k = rand() % universe;
+        data = &pool[k];
+        if(rand() % 3 != 0)
+        {
+            ok = (skiplist_insert(&list, &pool[k]) == (present[k] ? 1 : 0));
+            count += !present[k];
+            present[k] = 1;
+        }
+        else
+        {
+            ok = (skiplist_remove(&list, (void **)&data) == (present[k] ? 0 : -1));
+            count -= present[k];
+            present[k] = 0;
+        }
+    }
+    int prev = -1, seen = 0;
+    for(node = skiplist_first(&list); ok && node != NULL; node = skiplist_next(node))
+    {
+        int v = *(int *)skiplist_data(node);
+        ok = (v > prev) && present[v];
+        prev = v;
+        seen += 1;
+    }
+    printf("50000 random inserts/removes match a table? : %s\n", (ok && seen == count && skiplist_size(&list) == count) ? "yes" : "no");
+
+    skiplist_destroy(&list);
+    free(present);
+    free(pool);
+
+    /* Destroy with free */
+    skiplist_init(&list, compare_int, free);
+    for(int i = 0; i < 100; i++)
+    {
+        int *p = malloc(sizeof(*p));
+        *p = i;
+        skiplist_insert(&list, p);
+    }
+    skiplist_destroy(&list);
+
+    return 0;
+}
+
+/* Compare function for ints */
+int compare_int(const void *key1, const void *key2)
+{
+    int a = *(const int *)key1, b = *(const int *)key2;
+    return (a > b) ? 1 : (a < b) ? -1 : 0;
+}
+
+/* Range callback -- Print the element and stop once the optional limit hits zero */
+int print_int(const void *data, void *arg)
+{
+    printf("%d ", *(const int *)data);
+    if(arg == NULL)
+        return 0;
+    return --(*(int *)arg) == 0;
+}
+
+/* Print the skip list in order */
+void print_list(SkipList *list)
+{
+    printf("Size: %d, Contents: ", skiplist_size(list));
+    for(SkipListNode *node = skiplist_first(list); node != NULL; node = skiplist_next(node))
+        printf("%d ", *(int *)skiplist_data(node));
+    printf("\n");
+}
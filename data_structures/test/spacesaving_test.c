@@ -0,0 +1,178 @@
+/* Testing Space-Saving Heavy Hitters Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "spacesaving.h"
+
+#define KEYS 100000
+#define STREAM 1000000
+#define THREADS 4
+#define CAPACITY 200
+
+void *count_part(void *arg);
+uint64_t skewed_key(uint64_t *state);
+
+/* Each thread summarizes its own slice of the stream */
+typedef struct Part_ {
+    const uint64_t *keys;
+    int n;
+    SpaceSaving summary;
+} Part;
+
+/* Test the methods and macros of a space-saving summary
+    Methods:
+      - spacesaving_init()
+      - spacesaving_destroy()
+      - spacesaving_add()
+      - spacesaving_add_n()
+      - spacesaving_lookup()
+      - spacesaving_top()
+      - spacesaving_merge()
+    Macros:
+      - spacesaving_size()
+      - spacesaving_total()
+      - spacesaving_min()
+*/
+int main()
+{
+    SpaceSaving summary;
+    SSCounter counter, top[CAPACITY];
+
+    /* A few keys by hand */
+    printf("--- Small summary ---\n");
+    printf("Init with capacity 0 fails? : %s\n", spacesaving_init(&summary, 0) == -1 ? "yes" : "no");
+    spacesaving_init(&summary, 3);
+    uint64_t small[] = {7, 7, 7, 1, 2, 7, 3, 3, 7, 4};
+    for(int i = 0; i < 10; i++)
+        spacesaving_add(&summary, small[i], 1);
+    printf("Size: %d, total: %llu, min: %llu\n", spacesaving_size(&summary), (unsigned long long)spacesaving_total(&summary),
+           (unsigned long long)spacesaving_min(&summary));
+    int n = spacesaving_top(&summary, top, 3);
+    for(int i = 0; i < n; i++)
+        printf("Key %llu: count %llu, error %llu\n", (unsigned long long)top[i].key, (unsigned long long)top[i].count,
+               (unsigned long long)top[i].error);
+    printf("Key 7 tracked with count 5? : %s\n", spacesaving_lookup(&summary, 7, &counter) == 0 && counter.count == 5 ? "yes" : "no");
+    printf("Key 1 evicted? : %s\n", spacesaving_lookup(&summary, 1, &counter) == -1 ? "yes" : "no");
+    spacesaving_destroy(&summary);
+
+    /* A skewed stream over many keys, against exact counts */
+    printf("\n--- Skewed stream ---\n");
+    uint64_t *keys = malloc(STREAM * sizeof(uint64_t));
+    uint64_t *exact = calloc(KEYS, sizeof(uint64_t));
+    uint64_t state = 5;
+    for(int i = 0; i < STREAM; i++)
+    {
+        keys[i] = skewed_key(&state);
+        exact[keys[i]]++;
+    }
+
+    spacesaving_init(&summary, CAPACITY);
+    spacesaving_add_n(&summary, keys, NULL, STREAM);
+
+    /* Every key above n / k is kept, and every estimate brackets the truth */
+    int kept = 1, bracketed = 1;
+    for(int key = 0; key < KEYS; key++)
+    {
+        if(spacesaving_lookup(&summary, key, &counter) == 0)
+            bracketed = bracketed && (counter.count >= exact[key]) && (counter.count - counter.error <= exact[key]);
+        else
+            kept = kept && (exact[key] <= STREAM / CAPACITY) && (exact[key] <= spacesaving_min(&summary));
+    }
+    printf("Every key above n / k tracked, every untracked key under the min? : %s\n", kept ? "yes" : "no");
+    printf("Every tracked key's true count within [count - error, count]? : %s\n", bracketed ? "yes" : "no");
+
+    n = spacesaving_top(&summary, top, 10);
+    int sorted = 1;
+    for(int i = 1; i < n; i++)
+        sorted = sorted && (top[i - 1].count >= top[i].count);
+    printf("Top 10 in decreasing order? : %s\n", sorted ? "yes" : "no");
+    printf("Most frequent key is 0? : %s\n", top[0].key == 0 ? "yes" : "no");
+
+    /* Weighted counts */
+    SpaceSaving weighted;
+    spacesaving_init(&weighted, CAPACITY);
+    uint64_t *ones = malloc(STREAM * sizeof(uint64_t));
+    for(int i = 0; i < STREAM; i++)
+        ones[i] = 1;
+    spacesaving_add_n(&weighted, keys, ones, STREAM);
+    spacesaving_lookup(&weighted, 0, &counter);
+    SSCounter unweighted;
+    spacesaving_lookup(&summary, 0, &unweighted);
+    printf("Counts of 1 give the same summary? : %s\n", counter.count == unweighted.count ? "yes" : "no");
+    spacesaving_destroy(&weighted);
+    free(ones);
+
+    /* One summary per thread, merged */
+    printf("\n--- Merge across threads ---\n");
+    Part parts[THREADS];
+    pthread_t threads[THREADS];
+    for(int t = 0; t < THREADS; t++)
+    {
+        parts[t].keys = keys + (long)t * (STREAM / THREADS);
+        parts[t].n = STREAM / THREADS;
+        spacesaving_init(&parts[t].summary, CAPACITY);
+        pthread_create(&threads[t], NULL, count_part, &parts[t]);
+    }
+    for(int t = 0; t < THREADS; t++)
+        pthread_join(threads[t], NULL);
+
+    SpaceSaving merged;
+    spacesaving_init(&merged, CAPACITY);
+    for(int t = 0; t < THREADS; t++)
+    {
+        spacesaving_merge(&merged, &parts[t].summary);
+        spacesaving_destroy(&parts[t].summary);
+    }
+    printf("Merged total matches the stream? : %s\n", spacesaving_total(&merged) == STREAM ? "yes" : "no");
+
+    kept = 1;
+    bracketed = 1;
+    for(int key = 0; key < KEYS; key++)
+    {
+        if(spacesaving_lookup(&merged, key, &counter) == 0)
+            bracketed = bracketed && (counter.count >= exact[key]) && (counter.count - counter.error <= exact[key]);
+        else
+            kept = kept && (exact[key] <= STREAM / CAPACITY);
+    }
+    printf("Merged summary keeps every key above n / k? : %s\n", kept ? "yes" : "no");
+    printf("Merged estimates bracket the truth? : %s\n", bracketed ? "yes" : "no");
+
+    SSCounter merged_top[10];
+    spacesaving_top(&merged, merged_top, 10);
+    int same = 1;
+    for(int i = 0; i < 5; i++)
+        same = same && (merged_top[i].key == top[i].key);
+    printf("Merged top 5 matches the single summary's? : %s\n", same ? "yes" : "no");
+
+    spacesaving_destroy(&merged);
+    spacesaving_destroy(&summary);
+    free(keys);
+    free(exact);
+
+    return 0;
+}
+
+
+void *count_part(void *arg)
+{
+    Part *part = arg;
+    spacesaving_add_n(&part->summary, part->keys, NULL, part->n);
+    return NULL;
+}
+
+
+/* Roughly Zipfian keys: the index of the lowest set bit of a random word picks a band, low keys far likelier */
+uint64_t skewed_key(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t r = *state >> 11;
+    int band = __builtin_ctzll(r | (1ULL << 52));
+
+    /* Band b covers keys [2^b - 1, 2^(b+1) - 1) */
+    uint64_t low = (1ULL << band) - 1, width = 1ULL << band;
+    uint64_t key = low + ((r >> 20) % width);
+
+    return (key < KEYS) ? key : (r % KEYS);
+}
@@ -0,0 +1,137 @@
+/* Testing Single-Producer/Single-Consumer Queue Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "spscq.h"
+
+#define TRANSFER 1000000
+
+void *producer(void *arg);
+void *consumer(void *arg);
+
+/* Test the methods and macros of an SPSC queue
+    Methods:
+      - spscq_init()
+      - spscq_destroy()
+      - spscq_push()
+      - spscq_pop()
+      - spscq_push_n()
+      - spscq_pop_n()
+      - spscq_size()
+    Macros:
+      - spscq_capacity()
+*/
+int main()
+{
+    SPSCQueue *queue = aligned_alloc(SPSCQ_CACHE_LINE, sizeof(*queue));
+    if( (queue == NULL) || (spscq_init(queue, 6) != 0) )
+        return -1;
+
+    /* Single-threaded semantics */
+    int values[16];
+    void *batch[16];
+    for(int i = 0; i < 16; i++)
+    {
+        values[i] = i;
+        batch[i] = &values[i];
+    }
+
+    printf("--- Single thread ---\n");
+    printf("Capacity rounded up to %zu\n", spscq_capacity(queue));
+    for(int i = 0; i < 8; i++)
+        spscq_push(queue, &values[i]);
+    printf("Push onto full queue fails? : %s\n", spscq_push(queue, &values[8]) == -1 ? "yes" : "no");
+    printf("Size: %zu\n", spscq_size(queue));
+
+    int *data, order = 1;
+    for(int i = 0; i < 5; i++)
+    {
+        spscq_pop(queue, (void **)&data);
+        order = order && (*data == i);
+    }
+    printf("Popped 5 in order? : %s\n", order ? "yes" : "no");
+
+    /* Batch push wraps around the end of the ring and stops when full */
+    printf("Batch push of 10 into 5 free slots pushed %zu\n", spscq_push_n(queue, &batch[8], 8) + spscq_push_n(queue, batch, 2));
+    size_t popped = spscq_pop_n(queue, batch, 16);
+    printf("Batch pop returned %zu: ", popped);
+    for(size_t i = 0; i < popped; i++)
+        printf("%d ", *(int *)batch[i]);
+    printf("\n");
+    printf("Pop from empty queue fails? : %s\n", spscq_pop(queue, (void **)&data) == -1 ? "yes" : "no");
+    spscq_destroy(queue);
+    printf("\n");
+
+    /* Two threads -- Every value must arrive exactly once and in order */
+    spscq_init(queue, 1024);
+    pthread_t prod, cons;
+    uintptr_t mismatches = 0;
+    pthread_create(&prod, NULL, producer, queue);
+    pthread_create(&cons, NULL, consumer, queue);
+    pthread_join(prod, NULL);
+    pthread_join(cons, (void **)&mismatches);
+
+    printf("--- Producer and consumer threads ---\n");
+    printf("Transferred %d values in order? : %s\n", TRANSFER, mismatches == 0 ? "yes" : "no");
+
+    spscq_destroy(queue);
+    free(queue);
+
+    return 0;
+}
+
+/* Push 1..TRANSFER, alternating single and batch pushes */
+void *producer(void *arg)
+{
+    SPSCQueue *queue = arg;
+    void *batch[32];
+    uintptr_t next = 1;
+
+    while(next <= TRANSFER)
+    {
+        if(next % 2 == 0)
+        {
+            if(spscq_push(queue, (void *)next) == 0)
+                next += 1;
+            else
+                sched_yield();
+        }
+        else
+        {
+            size_t n = 0;
+            while(n < 32 && next + n <= TRANSFER)
+            {
+                batch[n] = (void *)(next + n);
+                n += 1;
+            }
+            size_t pushed = spscq_push_n(queue, batch, n);
+            next += pushed;
+            if(pushed == 0)
+                sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Pop until TRANSFER values arrive, counting any out of order */
+void *consumer(void *arg)
+{
+    SPSCQueue *queue = arg;
+    void *batch[64];
+    uintptr_t expected = 1, mismatches = 0;
+
+    while(expected <= TRANSFER)
+    {
+        size_t popped = spscq_pop_n(queue, batch, 64);
+        if(popped == 0)
+            sched_yield();
+        for(size_t i = 0; i < popped; i++)
+            mismatches += ((uintptr_t)batch[i] != expected++);
+    }
+
+    return (void *)mismatches;
+}
@@ -0,0 +1,217 @@
+/* Test of Sorted-Array Set Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sset.h"
+
+void print_sset(SSet *s, char *name);
+
+/* Function used to help with insert of members */
+int sset_insert_helper(SSet *set, int start, int end, int step);
+
+/* Function used to check the SIMD/galloping intersection against a plain membership test */
+int check_intersection(const SSet *set1, const SSet *set2);
+
+/* Callback used to print the members of a streamed intersection */
+int print_member(unsigned int member, void *arg);
+
+/* Testing methods and macros
+    Methods:
+      - sset_init()
+      - sset_destroy()
+      - sset_insert()
+      - sset_remove()
+      - sset_union()
+      - sset_intersection()
+      - sset_intersection_multi()
+      - sset_intersection_stream()
+      - sset_difference()
+      - sset_is_element()
+      - sset_is_subset()
+      - sset_is_equal()
+    Macros:
+      - sset_size()
+      - sset_member()
+*/
+int main()
+{
+    /* Allocate memory for some sets */
+    SSet *A = malloc(sizeof(*A));  if(!A) return -1;
+    SSet *B = malloc(sizeof(*B));  if(!B) return -1;
+    SSet *C = malloc(sizeof(*C));  if(!C) return -1;
+    SSet *D = malloc(sizeof(*D));  if(!D) return -1;
+
+    /* Initialize the sets */
+    sset_init(A);
+    sset_init(B);
+    sset_init(C);
+    sset_init(D);
+
+    /* Populate the sets -- D is inserted out of order */
+    sset_insert_helper(A, 0, 4, 1);
+    sset_insert_helper(B, 3, 6, 1);
+    sset_insert_helper(C, 0, 10, 1);
+    sset_insert(D, 9);
+    sset_insert(D, 8);
+    printf("--- Inserted Members into Set ---\n");
+    print_sset(A, "A");
+    print_sset(B, "B");
+    print_sset(C, "C");
+    print_sset(D, "D");
+    printf("Inserting 3 into A again : %s\n", sset_insert(A, 3) == 0 ? "inserted" : "rejected");
+    printf("\n");
+
+    /* Set union */
+    SSet *AuB = malloc(sizeof(*AuB));
+    sset_union(AuB, A, B);
+    printf("--- Performed Set Union ---\n");
+    print_sset(AuB, "A+B");
+    printf("\n");
+
+    /* Set intersection */
+    SSet *AB = malloc(sizeof(*AB));
+    sset_intersection(AB, A, B);
+    printf("--- Performed Set Intersection ---\n");
+    print_sset(AB, "AB");
+    printf("\n");
+
+    /* Set difference */
+    SSet *DC = malloc(sizeof(*DC));
+    SSet *CA = malloc(sizeof(*CA));
+    sset_difference(DC, D, C);
+    sset_difference(CA, C, A);
+    printf("--- Performed Set Difference --\n");
+    print_sset(DC, "D-C");
+    print_sset(CA, "C-A");
+    printf("\n");
+
+    /* Set is element */
+    printf("--- Checking if Member is in Set ---\n");
+    printf("0 in A? : %s\n", sset_is_element(A, 0) ? "yes" : "no");
+    printf("8 in B? : %s\n", sset_is_element(B, 8) ? "yes" : "no");
+    printf("2 in C? : %s\n", sset_is_element(C, 2) ? "yes" : "no");
+    printf("4 in D? : %s\n", sset_is_element(D, 4) ? "yes" : "no");
+    printf("\n");
+
+    /* Set is subset */
+    printf("--- Checking subsets ---\n");
+    printf("A is subset of A? : %s\n", sset_is_subset(A, A) ? "yes" : "no");
+    printf("A is subset of B? : %s\n", sset_is_subset(A, B) ? "yes" : "no");
+    printf("A is subset of C? : %s\n", sset_is_subset(A, C) ? "yes" : "no");
+    printf("C is subset of D? : %s\n", sset_is_subset(C, D) ? "yes" : "no");
+    printf("\n");
+
+    /* Remove some members */
+    printf("-- Removing members ---\n");
+    for(int i = 4; i < 10; i++)
+        sset_remove(C, i);
+    print_sset(C, "C");
+    printf("Removing 42 from C : %s\n", sset_remove(C, 42) == 0 ? "removed" : "not found");
+    printf("\n");
+
+    /* Set is equal */
+    printf("--- Checking set equality ---\n");
+    printf("A is equal to A? : %s\n", sset_is_equal(A, A) ? "yes" : "no");
+    printf("A is equal to C? : %s\n", sset_is_equal(A, C) ? "yes" : "no");
+    printf("B is equal to D? : %s\n", sset_is_equal(B, D) ? "yes" : "no");
+    printf("C is equal to B? : %s\n", sset_is_equal(C, B) ? "yes" : "no");
+    printf("\n");
+
+    /* Larger intersections -- Similar sizes take the merge path, skewed sizes take the galloping path */
+    SSet *E = malloc(sizeof(*E));  sset_init(E);
+    SSet *F = malloc(sizeof(*F));  sset_init(F);
+    SSet *G = malloc(sizeof(*G));  sset_init(G);
+    sset_insert_helper(E, 0, 100000, 3);
+    sset_insert_helper(F, 0, 100000, 5);
+    sset_insert_helper(G, 0, 100000, 997);
+    printf("--- Checking larger intersections ---\n");
+    printf("E = multiples of 3, F = multiples of 5, G = multiples of 997 (below 100000)\n");
+    printf("E intersect F correct? : %s\n", check_intersection(E, F) ? "yes" : "no");
+    printf("E intersect G correct? : %s\n", check_intersection(E, G) ? "yes" : "no");
+    printf("G intersect F correct? : %s\n", check_intersection(G, F) ? "yes" : "no");
+    printf("\n");
+
+    /* Multi-way intersection -- Multiples of 3, 5, and 997 are the multiples of 14955 */
+    const SSet *sets[3] = {E, F, G};
+    SSet *EFG = malloc(sizeof(*EFG));
+    sset_intersection_multi(EFG, sets, 3);
+    printf("--- Checking multi-way intersection ---\n");
+    print_sset(EFG, "EFG");
+    printf("Streamed EFG: ");
+    sset_intersection_stream(sets, 3, print_member, NULL);
+    printf("\n");
+    const SSet *disjoint[3] = {G, B, D};
+    SSet *GBD = malloc(sizeof(*GBD));
+    sset_intersection_multi(GBD, disjoint, 3);
+    print_sset(GBD, "GBD");
+    printf("\n");
+
+    /* Destroy the sets */
+    sset_destroy(EFG);
+    sset_destroy(GBD);
+    sset_destroy(A);
+    sset_destroy(B);
+    sset_destroy(C);
+    sset_destroy(D);
+    sset_destroy(AuB);
+    sset_destroy(AB);
+    sset_destroy(DC);
+    sset_destroy(CA);
+    sset_destroy(E);
+    sset_destroy(F);
+    sset_destroy(G);
+
+    return 0;
+}
+
+/* Helper insertion function */
+int sset_insert_helper(SSet *set, int start, int end, int step)
+{
+    int res = 0;
+    for(int i = start; i < end; i += step)
+    {
+        res = sset_insert(set, i);
+        if(res == -1)
+            return res;
+    }
+    return res;
+}
+
+/* Compare the intersection against testing every member of set1 with sset_is_element() */
+int check_intersection(const SSet *set1, const SSet *set2)
+{
+    SSet seti;
+    if(sset_intersection(&seti, set1, set2) != 0)
+        return 0;
+
+    int k = 0, ok = 1;
+    for(int i = 0; i < sset_size(set1) && ok; i++)
+    {
+        if(sset_is_element(set2, sset_member(set1, i)))
+        {
+            if(k >= sset_size(&seti) || sset_member(&seti, k) != sset_member(set1, i))
+                ok = 0;
+            k++;
+        }
+    }
+    if(k != sset_size(&seti))
+        ok = 0;
+
+    printf("Size of intersection = %d  ", sset_size(&seti));
+    sset_destroy(&seti);
+    return ok;
+}
+
+int print_member(unsigned int member, void *arg)
+{
+    printf("%u  ", member);
+    return 0;
+}
+
+void print_sset(SSet *set, char *name)
+{
+    printf("Set %s:  Size = %d,  Contents = ", name, sset_size(set));
+    for(int i = 0; i < sset_size(set); i++)
+        printf("%u  ", sset_member(set, i));
+    printf("\n");
+}
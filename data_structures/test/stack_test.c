@@ -17,13 +17,16 @@ typedef struct Function_ {
       - stack_destroy()
       - stack_push()
       - stack_pop()
+      - stack_reserve()
+      - stack_push_n()
+      - stack_pop_n()
     Macros:
       - stack_peek()
+      - stack_item()
       - stack_size()
 
     Notes:
-      - Stacks are implemented as linked lists
-      - All linked list operations are also available for stacks
+      - Stacks are implemented as growable arrays
 */
 int main()
 {
@@ -66,15 +69,45 @@ int main()
     /* Destroy the stack */
     stack_destroy(s);
 
+    /* Bulk operations on a stack of ints */
+    Stack ints;
+    stack_init(&ints, NULL);
+    int values[1000];
+    void *batch[1000];
+    for(int i = 0; i < 1000; i++)
+    {
+        values[i] = i;
+        batch[i] = &values[i];
+    }
+
+    printf("--- Bulk push and pop ---\n");
+    stack_reserve(&ints, 100);
+    printf("Reserved capacity >= 100: %s\n", (ints.capacity >= 100) ? "pass" : "fail");
+    stack_push_n(&ints, batch, 10);
+    for(int i = 10; i < 1000; i++)
+        stack_push(&ints, &values[i]);
+    printf("Size after pushing 1000 (grows past the reserve): %d\n", stack_size(&ints));
+    printf("Top is 999: %s\n", (*(int *)stack_peek(&ints) == 999) ? "pass" : "fail");
+    printf("Item at depth 999 is 0: %s\n", (*(int *)stack_item(&ints, 999) == 0) ? "pass" : "fail");
+
+    int popped = stack_pop_n(&ints, batch, 5), order = 1;
+    for(int i = 0; i < popped; i++)
+        order = order && (*(int *)batch[i] == 999 - i);
+    printf("Popped %d, in LIFO order: %s\n", popped, order ? "pass" : "fail");
+    printf("Popping 2000 from %d ", stack_size(&ints));
+    printf("returns %d\n", stack_pop_n(&ints, batch, 2000));
+    printf("Pop from empty stack fails: %s\n", (stack_pop(&ints, batch) == -1 && stack_peek(&ints) == NULL) ? "pass" : "fail");
+    stack_destroy(&ints);
+
     return 0;
 }
 
 void print_stack(Stack *s)
 {
     printf("Size: %d, Contents: ", stack_size(s));
-    for(ListElement *e = list_head(s); e != NULL; e = list_next(e))
+    for(int i = 0; i < stack_size(s); i++)
     {
-        Function *data = (Function *)list_data(e);
+        Function *data = (Function *)stack_item(s, i);
         printf("(name = '%s', addr = 0x%x)  ", data->name, data->addr);
     }
     printf("\n");
@@ -0,0 +1,160 @@
+/* Testing Sliding Window Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "swindow.h"
+
+#define SAMPLES 20000
+#define TOLERANCE 1e-6
+
+int check_window(const SWindow *window, const double *values, const uint64_t *stamps, int newest, int kind, uint64_t span);
+int close_enough(double a, double b);
+
+/* Test the methods and macros of a sliding window
+    Methods:
+      - swindow_init()
+      - swindow_destroy()
+      - swindow_add()
+      - swindow_add_n()
+      - swindow_expire()
+      - swindow_min()
+      - swindow_max()
+      - swindow_mean()
+    Macros:
+      - swindow_count()
+      - swindow_sum()
+*/
+int main()
+{
+    SWindow window;
+    double min, max, mean;
+
+    printf("--- Count window of 4 ---\n");
+    printf("Init with span 0 fails? : %s\n", swindow_init(&window, SWINDOW_COUNT, 0) == -1 ? "yes" : "no");
+    swindow_init(&window, SWINDOW_COUNT, 4);
+    printf("Min of empty window fails? : %s\n", swindow_min(&window, &min) == -1 ? "yes" : "no");
+
+    double small[] = {5, 3, 8, 1, 9, 2, 7};
+    for(int i = 0; i < 7; i++)
+    {
+        swindow_add(&window, 0, small[i]);
+        swindow_min(&window, &min);
+        swindow_max(&window, &max);
+        swindow_mean(&window, &mean);
+        printf("Add %.0f -> count %d, min %.0f, max %.0f, sum %.0f, mean %.2f\n", small[i], swindow_count(&window), min, max, swindow_sum(&window), mean);
+    }
+    swindow_destroy(&window);
+
+    /* Random stream against a brute-force rescan */
+    double *values = malloc(SAMPLES * sizeof(double));
+    uint64_t *stamps = malloc(SAMPLES * sizeof(uint64_t));
+    uint64_t now = 0;
+    srand(5);
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        values[i] = (rand() % 2000000) / 1000.0 - 1000.0;
+        now += rand() % 4;
+        stamps[i] = now;
+    }
+
+    printf("\n--- Random stream against a rescan ---\n");
+    int ok = 1;
+    swindow_init(&window, SWINDOW_COUNT, 100);
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        swindow_add(&window, 0, values[i]);
+        ok = ok && check_window(&window, values, stamps, i, SWINDOW_COUNT, 100);
+    }
+    printf("Count window of 100 matches? : %s\n", ok ? "yes" : "no");
+    swindow_destroy(&window);
+
+    ok = 1;
+    swindow_init(&window, SWINDOW_TIME, 150);
+    for(int i = 0; i < SAMPLES; i++)
+    {
+        swindow_add(&window, stamps[i], values[i]);
+        ok = ok && check_window(&window, values, stamps, i, SWINDOW_TIME, 150);
+    }
+    printf("Time window of 150 matches? : %s\n", ok ? "yes" : "no");
+
+    /* Expiring with no new samples empties the window */
+    swindow_expire(&window, now + 149);
+    printf("Samples left 149 after the newest: %d\n", swindow_count(&window));
+    swindow_expire(&window, now + 150);
+    printf("Samples left 150 after the newest: %d, sum %.1f\n", swindow_count(&window), swindow_sum(&window));
+    swindow_destroy(&window);
+
+    /* Batches give the same window as single adds */
+    printf("\n--- Batch adds ---\n");
+    ok = 1;
+    swindow_init(&window, SWINDOW_COUNT, 100);
+    for(int i = 0; i < SAMPLES; )
+    {
+        int count = 1 + rand() % 300;
+        if(i + count > SAMPLES)
+            count = SAMPLES - i;
+        swindow_add_n(&window, NULL, &values[i], count);
+        i += count;
+        ok = ok && check_window(&window, values, stamps, i - 1, SWINDOW_COUNT, 100);
+    }
+    printf("Count window batches match? : %s\n", ok ? "yes" : "no");
+    swindow_destroy(&window);
+
+    ok = 1;
+    swindow_init(&window, SWINDOW_TIME, 150);
+    printf("Time window batch without stamps fails? : %s\n", swindow_add_n(&window, NULL, values, 4) == -1 ? "yes" : "no");
+    for(int i = 0; i < SAMPLES; )
+    {
+        int count = 1 + rand() % 300;
+        if(i + count > SAMPLES)
+            count = SAMPLES - i;
+        swindow_add_n(&window, &stamps[i], &values[i], count);
+        i += count;
+        ok = ok && check_window(&window, values, stamps, i - 1, SWINDOW_TIME, 150);
+    }
+    printf("Time window batches match? : %s\n", ok ? "yes" : "no");
+    swindow_destroy(&window);
+
+    free(values);
+    free(stamps);
+
+    return 0;
+}
+
+
+/* Rescan the samples that should be in the window after sample newest was added, and compare */
+int check_window(const SWindow *window, const double *values, const uint64_t *stamps, int newest, int kind, uint64_t span)
+{
+    int oldest = newest;
+    while(oldest > 0 && ((kind == SWINDOW_COUNT) ? (uint64_t)(newest - oldest + 1) < span : stamps[newest] - stamps[oldest - 1] < span))
+        oldest--;
+
+    double min = values[oldest], max = values[oldest], sum = 0, got;
+    for(int i = oldest; i <= newest; i++)
+    {
+        min = (values[i] < min) ? values[i] : min;
+        max = (values[i] > max) ? values[i] : max;
+        sum += values[i];
+    }
+
+    if(swindow_count(window) != newest - oldest + 1)
+        return 0;
+    if(swindow_min(window, &got) != 0 || got != min)
+        return 0;
+    if(swindow_max(window, &got) != 0 || got != max)
+        return 0;
+    if(!close_enough(swindow_sum(window), sum))
+        return 0;
+    if(swindow_mean(window, &got) != 0 || !close_enough(got, sum / (newest - oldest + 1)))
+        return 0;
+
+    return 1;
+}
+
+
+int close_enough(double a, double b)
+{
+    double difference = a - b;
+    return difference < TOLERANCE && difference > -TOLERANCE;
+}
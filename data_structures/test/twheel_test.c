@@ -0,0 +1,129 @@
+/* Testing Timer Wheel Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "twheel.h"
+
+#define TIMERS 20000
+
+/* Record of one test timer */
+typedef struct Expected_ {
+    uint64_t due;           /* Tick the timer should fire at */
+    uint64_t fired_at;      /* Tick it actually fired at (0 if not fired) */
+    int fired;              /* Number of times it fired */
+} Expected;
+
+TWheel wheel;
+
+void record(void *arg);
+void reschedule(void *arg);
+
+/* Test the methods and macros of a timer wheel
+    Methods:
+      - twheel_init()
+      - twheel_destroy()
+      - twheel_schedule()
+      - twheel_cancel()
+      - twheel_advance()
+    Macros:
+      - twheel_now()
+      - twheel_pending()
+      - twheel_expires()
+*/
+int main()
+{
+    twheel_init(&wheel, 1000);
+
+    /* A few timers around the level boundaries */
+    printf("--- Level boundaries ---\n");
+    uint64_t delays[] = {1, 255, 256, 257, 65535, 65536, 70000, 16777216, 0};
+    int count = sizeof(delays) / sizeof(delays[0]);
+    Expected small[9] = {{0}};
+    for(int i = 0; i < count; i++)
+    {
+        TWheelTimer *timer = twheel_schedule(&wheel, delays[i], record, &small[i]);
+        small[i].due = twheel_expires(timer);
+    }
+    printf("Pending: %d\n", twheel_pending(&wheel));
+
+    int fired = twheel_advance(&wheel, 16777216 + 1);
+    int exact = 1;
+    for(int i = 0; i < count; i++)
+        exact = exact && (small[i].fired == 1) && (small[i].fired_at == small[i].due);
+    printf("Fired %d, each exactly once on its tick? : %s\n", fired, exact ? "yes" : "no");
+    printf("Delay 0 fires on the next tick? : %s\n", small[count - 1].due == 1001 ? "yes" : "no");
+    printf("Now: %llu, pending: %d\n", (unsigned long long)twheel_now(&wheel), twheel_pending(&wheel));
+
+    /* Many random timers, half of them cancelled */
+    printf("\n--- Random delays with cancellation ---\n");
+    Expected *expected = calloc(TIMERS, sizeof(Expected));
+    TWheelTimer **timers = malloc(TIMERS * sizeof(TWheelTimer *));
+    srand(11);
+    for(int i = 0; i < TIMERS; i++)
+    {
+        uint64_t delay = (uint64_t)rand() % 200000;
+        timers[i] = twheel_schedule(&wheel, delay, record, &expected[i]);
+        expected[i].due = twheel_expires(timers[i]);
+    }
+    for(int i = 0; i < TIMERS; i += 2)
+        twheel_cancel(&wheel, timers[i]);
+    printf("Pending after cancelling half: %d\n", twheel_pending(&wheel));
+
+    /* Advance in uneven steps */
+    fired = 0;
+    while(twheel_pending(&wheel) > 0)
+        fired += twheel_advance(&wheel, 1 + rand() % 5000);
+
+    int cancelled_silent = 1, on_time = 1;
+    for(int i = 0; i < TIMERS; i++)
+    {
+        if(i % 2 == 0)
+            cancelled_silent = cancelled_silent && (expected[i].fired == 0);
+        else
+            on_time = on_time && (expected[i].fired == 1) && (expected[i].fired_at == expected[i].due);
+    }
+    printf("Fired %d, all on their tick? : %s\n", fired, on_time ? "yes" : "no");
+    printf("Cancelled timers never fired? : %s\n", cancelled_silent ? "yes" : "no");
+
+    /* Delays beyond the top level wait parked and still fire on time */
+    printf("\n--- Beyond the wheel's range ---\n");
+    Expected far = {0};
+    uint64_t delay = ((uint64_t)1 << 32) + 12345;
+    far.due = twheel_expires(twheel_schedule(&wheel, delay, record, &far));
+    twheel_advance(&wheel, delay);
+    printf("Fired on its tick after 2^32 + 12345 ticks? : %s\n", (far.fired == 1 && far.fired_at == far.due) ? "yes" : "no");
+
+    /* A timer rescheduling itself from its callback */
+    printf("\n--- Rescheduling from expire ---\n");
+    int remaining = 5;
+    twheel_schedule(&wheel, 10, reschedule, &remaining);
+    fired = twheel_advance(&wheel, 100);
+    printf("Fired %d times, remaining %d, pending %d\n", fired, remaining, twheel_pending(&wheel));
+
+    free(expected);
+    free(timers);
+    twheel_destroy(&wheel);
+
+    return 0;
+}
+
+
+/* Note when a timer fires */
+void record(void *arg)
+{
+    Expected *expected = arg;
+
+    expected->fired++;
+    expected->fired_at = twheel_now(&wheel);
+}
+
+
+/* Fire again 10 ticks later until the count runs out */
+void reschedule(void *arg)
+{
+    int *remaining = arg;
+
+    if(--(*remaining) > 0)
+        twheel_schedule(&wheel, 10, reschedule, remaining);
+}
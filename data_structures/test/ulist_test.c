@@ -0,0 +1,157 @@
+/* Testing Unrolled Linked List Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ulist.h"
+
+void print_list(UList *list);
+int check_list(UList *list, int *expected, int size);
+
+/* Test the methods and macros of an unrolled list
+    Methods:
+      - ulist_init()
+      - ulist_destroy()
+      - ulist_append()
+      - ulist_prepend()
+      - ulist_insert()
+      - ulist_remove()
+      - ulist_get()
+    Macros:
+      - ulist_size()
+      - ulist_head()
+      - ulist_tail()
+      - ulist_next()
+      - ulist_count()
+      - ulist_data()
+*/
+int main()
+{
+    int values[100], expected[200], size = 0;
+    for(int i = 0; i < 100; i++)
+        values[i] = i;
+
+    UList list;
+    ulist_init(&list, NULL);
+
+    /* Appending fills each node before starting the next */
+    for(int i = 0; i < 30; i++)
+    {
+        ulist_append(&list, &values[i]);
+        expected[size++] = i;
+    }
+    printf("--- Append 0..29 ---\n");
+    print_list(&list);
+
+    /* Prepend a few */
+    for(int i = 30; i < 33; i++)
+    {
+        ulist_prepend(&list, &values[i]);
+        for(int j = size; j > 0; j--)
+            expected[j] = expected[j - 1];
+        expected[0] = i;
+        size += 1;
+    }
+    printf("--- Prepend 30..32 ---\n");
+    print_list(&list);
+
+    /* Insert into the middle of a full node -- Forces a split */
+    ulist_insert(&list, 10, &values[99]);
+    for(int j = size; j > 10; j--)
+        expected[j] = expected[j - 1];
+    expected[10] = 99;
+    size += 1;
+    printf("--- Insert 99 at position 10 ---\n");
+    print_list(&list);
+    printf("Element at 10 is 99? : %s\n", *(int *)ulist_get(&list, 10) == 99 ? "yes" : "no");
+    printf("Out of range get returns NULL? : %s\n", ulist_get(&list, size) == NULL ? "yes" : "no");
+    printf("Out of range insert fails? : %s\n", ulist_insert(&list, size + 1, &values[0]) == -1 ? "yes" : "no");
+
+    /* Remove enough from the front to trigger merging */
+    int *data;
+    for(int i = 0; i < 12; i++)
+    {
+        ulist_remove(&list, 2, (void **)&data);
+        for(int j = 2; j < size - 1; j++)
+            expected[j] = expected[j + 1];
+        size -= 1;
+    }
+    printf("--- Remove 12 elements at position 2 ---\n");
+    print_list(&list);
+
+    /* Randomized inserts and removes checked against a plain array */
+    srand(7);
+    int ok = check_list(&list, expected, size);
+    for(int round = 0; round < 2000 && ok; round++)
+    {
+        if( (rand() % 2 == 0 && size < 200) || size == 0 )
+        {
+            int pos = rand() % (size + 1), v = rand() % 100;
+            ulist_insert(&list, pos, &values[v]);
+            for(int j = size; j > pos; j--)
+                expected[j] = expected[j - 1];
+            expected[pos] = v;
+            size += 1;
+        }
+        else
+        {
+            int pos = rand() % size;
+            ulist_remove(&list, pos, (void **)&data);
+            ok = (*data == expected[pos]);
+            for(int j = pos; j < size - 1; j++)
+                expected[j] = expected[j + 1];
+            size -= 1;
+        }
+        ok = ok && check_list(&list, expected, size);
+    }
+    printf("2000 random inserts/removes match an array? : %s\n", ok ? "yes" : "no");
+
+    /* Remove everything */
+    while(ulist_size(&list) > 0)
+        ulist_remove(&list, 0, (void **)&data);
+    printf("Empty list has no nodes? : %s\n", (ulist_head(&list) == NULL && ulist_tail(&list) == NULL) ? "yes" : "no");
+
+    /* Destroy with free */
+    ulist_destroy(&list);
+    ulist_init(&list, free);
+    for(int i = 0; i < 50; i++)
+    {
+        int *p = malloc(sizeof(*p));
+        *p = i;
+        ulist_append(&list, p);
+    }
+    ulist_destroy(&list);
+
+    return 0;
+}
+
+/* Print the elements of the list, one line per node */
+void print_list(UList *list)
+{
+    printf("List size: %d\n", ulist_size(list));
+    for(UListNode *node = ulist_head(list); node != NULL; node = ulist_next(node))
+    {
+        printf("[%2d] ", ulist_count(node));
+        for(int i = 0; i < ulist_count(node); i++)
+            printf("%d ", *(int *)ulist_data(node, i));
+        printf("\n");
+    }
+}
+
+/* Check list contents, node occupancy and the tail pointer */
+int check_list(UList *list, int *expected, int size)
+{
+    int pos = 0;
+    UListNode *last = NULL;
+    for(UListNode *node = ulist_head(list); node != NULL; node = ulist_next(node))
+    {
+        if(ulist_count(node) <= 0 || ulist_count(node) > ULIST_SLOTS)
+            return 0;
+        for(int i = 0; i < ulist_count(node); i++)
+        {
+            if(pos >= size || *(int *)ulist_data(node, i) != expected[pos++])
+                return 0;
+        }
+        last = node;
+    }
+    return (pos == size) && (ulist_size(list) == size) && (ulist_tail(list) == last);
+}
@@ -0,0 +1,125 @@
+/* Testing Work-Stealing Deque Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "wsdeque.h"
+
+#define THIEVES 3
+#define TASKS 200000
+
+void *thief(void *arg);
+
+/* State shared by the owner and the thieves */
+typedef struct Shared_ {
+    WSDeque deque;
+    atomic_int done;            /* Set once the owner has finished */
+    atomic_uchar *taken;        /* How many times each task was obtained */
+    atomic_long stolen;         /* Tasks obtained by thieves */
+} Shared;
+
+/* Test the methods and macros of a work-stealing deque
+    Methods:
+      - wsdeque_init()
+      - wsdeque_destroy()
+      - wsdeque_push()
+      - wsdeque_pop()
+      - wsdeque_steal()
+      - wsdeque_size()
+    Macros:
+      - wsdeque_capacity()
+*/
+int main()
+{
+    Shared *shared = aligned_alloc(WSDEQUE_CACHE_LINE, sizeof(*shared));
+    if( (shared == NULL) || (wsdeque_init(&shared->deque, 4) != 0) )
+        return -1;
+    WSDeque *deque = &shared->deque;
+
+    /* Single-threaded semantics: the owner end is LIFO, the thief end FIFO */
+    int values[10], *data;
+    for(int i = 0; i < 10; i++)
+    {
+        values[i] = i;
+        wsdeque_push(deque, &values[i]);
+    }
+    printf("--- Single thread ---\n");
+    printf("Size after 10 pushes: %ld (capacity grew from 4 to %ld)\n", wsdeque_size(deque), wsdeque_capacity(deque));
+    wsdeque_pop(deque, (void **)&data);
+    printf("Owner pops the newest (9)? : %s\n", *data == 9 ? "yes" : "no");
+    wsdeque_steal(deque, (void **)&data);
+    printf("Thief steals the oldest (0)? : %s\n", *data == 0 ? "yes" : "no");
+    while(wsdeque_pop(deque, (void **)&data) == 0)
+        ;
+    printf("Pop from empty deque fails? : %s\n", wsdeque_pop(deque, (void **)&data) == -1 ? "yes" : "no");
+    printf("Steal from empty deque fails? : %s\n", wsdeque_steal(deque, (void **)&data) == -1 ? "yes" : "no");
+    wsdeque_destroy(deque);
+    printf("\n");
+
+    /* Owner pushes and pops tasks (growing the ring as it goes) while thieves steal */
+    wsdeque_init(deque, 16);
+    shared->taken = calloc(TASKS, sizeof(*shared->taken));
+    atomic_init(&shared->done, 0);
+    atomic_init(&shared->stolen, 0);
+
+    pthread_t thieves[THIEVES];
+    for(int i = 0; i < THIEVES; i++)
+        pthread_create(&thieves[i], NULL, thief, shared);
+
+    void *task;
+    for(uintptr_t i = 0; i < TASKS; i++)
+    {
+        wsdeque_push(deque, (void *)i);
+
+        /* Keep some work around for the thieves, pop the rest */
+        if( (i % 3 == 0) && (wsdeque_pop(deque, &task) == 0) )
+            atomic_fetch_add(&shared->taken[(uintptr_t)task], 1);
+    }
+    while(wsdeque_pop(deque, &task) == 0)
+        atomic_fetch_add(&shared->taken[(uintptr_t)task], 1);
+    atomic_store(&shared->done, 1);
+
+    for(int i = 0; i < THIEVES; i++)
+        pthread_join(thieves[i], NULL);
+
+    int once = 1;
+    for(int i = 0; i < TASKS; i++)
+        once = once && (atomic_load(&shared->taken[i]) == 1);
+    printf("--- Owner and %d thieves ---\n", THIEVES);
+    printf("Every task taken exactly once? : %s\n", once ? "yes" : "no");
+    printf("Some tasks were stolen? : %s\n", atomic_load(&shared->stolen) > 0 ? "yes" : "no");
+
+    free(shared->taken);
+    wsdeque_destroy(deque);
+    free(shared);
+
+    return 0;
+}
+
+/* Steal until the owner is done and the deque is empty */
+void *thief(void *arg)
+{
+    Shared *shared = arg;
+    void *task;
+
+    for(;;)
+    {
+        int result = wsdeque_steal(&shared->deque, &task);
+        if(result == 0)
+        {
+            atomic_fetch_add(&shared->taken[(uintptr_t)task], 1);
+            atomic_fetch_add(&shared->stolen, 1);
+        }
+        else if(result == -1)
+        {
+            if(atomic_load(&shared->done))
+                break;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}